@@ -114,14 +114,15 @@ int main()
   auto * surfaceAttachment =
     ctx->CreateSurfacedAttachment(window.GetDrawSurface(), RHI::RenderBuffering::Triple);
   framebuffer->AddAttachment(2, surfaceAttachment);
+  // multisampled images are resolved into surface, so their content isn't needed after frame
   framebuffer->AddAttachment(1, ctx->CreateAttachment(RHI::ImageFormat::DEPTH_STENCIL,
                                                      surfaceAttachment->GetDescription().extent,
                                                      RHI::RenderBuffering::Triple,
-                                                     RHI::SamplesCount::Eight));
+                                                     RHI::SamplesCount::Eight, true));
   framebuffer->AddAttachment(0, ctx->CreateAttachment(RHI::ImageFormat::RGBA8,
                                                      surfaceAttachment->GetDescription().extent,
                                                      RHI::RenderBuffering::Triple,
-                                                     RHI::SamplesCount::Eight));
+                                                     RHI::SamplesCount::Eight, true));
 
   CubesRenderer renderer(*ctx);
   renderer.BindDrawSurface(framebuffer);
@@ -15,15 +15,19 @@ int main()
 
   RHI::GpuTraits gpuTraits{};
   gpuTraits.require_presentation = true;
+  // each window is rendered on its own queue if GPU has enough of them
+  gpuTraits.graphics_queues_count = 2;
   std::unique_ptr<RHI::IContext> ctx = RHI::CreateContext(gpuTraits, ConsoleLog);
 
-  RHI::IFramebuffer * framebuffer = ctx->CreateFramebuffer();
-  framebuffer->AddAttachment(0, ctx->CreateSurfacedAttachment(window1.GetDrawSurface(),
-                                                              RHI::RenderBuffering::Triple));
-  framebuffer->AddAttachment(1, ctx->CreateSurfacedAttachment(window2.GetDrawSurface(),
-                                                              RHI::RenderBuffering::Triple));
+  // windows don't share images, so their framebuffers are independent
+  RHI::IFramebuffer * framebuffer1 = ctx->CreateFramebuffer();
+  framebuffer1->AddAttachment(0, ctx->CreateSurfacedAttachment(window1.GetDrawSurface(),
+                                                               RHI::RenderBuffering::Triple));
+  RHI::IFramebuffer * framebuffer2 = ctx->CreateFramebuffer();
+  framebuffer2->AddAttachment(0, ctx->CreateSurfacedAttachment(window2.GetDrawSurface(),
+                                                               RHI::RenderBuffering::Triple));
 
-  auto subpass1 = framebuffer->CreateSubpass();
+  auto subpass1 = framebuffer1->CreateSubpass();
   {
     auto && pipeline = subpass1->GetConfiguration();
     pipeline.BindAttachment(0, RHI::ShaderAttachmentSlot::Color);
@@ -33,10 +37,10 @@ int main()
     pipeline.SetMeshTopology(RHI::MeshTopology::Triangle);
   }
 
-  auto subpass2 = framebuffer->CreateSubpass();
+  auto subpass2 = framebuffer2->CreateSubpass();
   {
     auto && pipeline = subpass2->GetConfiguration();
-    pipeline.BindAttachment(1, RHI::ShaderAttachmentSlot::Color);
+    pipeline.BindAttachment(0, RHI::ShaderAttachmentSlot::Color);
     // set shaders
     pipeline.AttachShader(RHI::ShaderType::Vertex, ReadSpirV(FromGLSL("quad.vert")));
     pipeline.AttachShader(RHI::ShaderType::Fragment, ReadSpirV(FromGLSL("triangle_quad.frag")));
@@ -47,11 +51,9 @@ int main()
   window1.MainLoop(
     [&](float delta)
     {
-      if (auto * renderTarget = framebuffer->BeginFrame())
+      if (auto * renderTarget = framebuffer1->BeginFrame())
       {
         renderTarget->SetClearValue(0, 0.1f, std::abs(std::sin(t)), 0.4f, 1.0f);
-        renderTarget->SetClearValue(1, 0.1f, std::abs(std::sin(t)), 0.4f, 1.0f);
-
         if (subpass1->ShouldBeInvalidated())
         {
           auto [width, height, _] = renderTarget->GetExtent();
@@ -63,7 +65,11 @@ int main()
             subpass1->EndPass(); // finish drawing pass
           }
         }
+      }
 
+      if (auto * renderTarget = framebuffer2->BeginFrame())
+      {
+        renderTarget->SetClearValue(0, 0.1f, std::abs(std::sin(t)), 0.4f, 1.0f);
         if (subpass2->ShouldBeInvalidated())
         {
           auto [width, height, _] = renderTarget->GetExtent();
@@ -75,9 +81,12 @@ int main()
             subpass2->EndPass(); // finish drawing pass
           }
         }
-        framebuffer->EndFrame();
-        t += 0.0001;
       }
+
+      // both frames are submitted with one call
+      RHI::IFramebuffer * framebuffers[] = {framebuffer1, framebuffer2};
+      ctx->EndFrames(framebuffers);
+      t += 0.0001;
     });
 
   return 0;
@@ -69,6 +69,14 @@ struct IBufferUniformDescriptor : public IUniformDescriptor
   virtual bool IsBufferAssigned() const noexcept = 0;
 };
 
+/// @brief image2D/image3D uniform (read-write image without sampler). Uses GENERAL layout
+struct IStorageImageDescriptor : public IUniformDescriptor
+{
+  /// @brief assign texture. It throws if texture is null or doesn't support storage usage
+  virtual void AssignImage(ITexture * texture) = 0;
+  virtual bool IsImageAssigned() const noexcept = 0;
+};
+
 
 } // namespace RHI
 
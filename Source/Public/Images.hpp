@@ -68,6 +68,13 @@ enum class ImageFormat : uint8_t
   //BC7
 };
 
+/// @brief Defines how texture is used. Any texture can be sampled, copied and blitted
+enum class TextureUsage : uint8_t
+{
+  Sampled, ///< texture is only read in shaders, so driver may keep it compressed
+  Storage, ///< texture can also be assigned to storage image descriptors and used by compute
+};
+
 /// @brief
 enum ShaderAttachmentSlot
 {
@@ -103,6 +110,7 @@ struct TextureDescription final
   ImageType type;
   ImageFormat format;
   uint32_t mipLevels = 1;
+  TextureUsage usage = TextureUsage::Sampled;
 };
 
 RHI_API uint32_t CalcMaxMipLevels(TextureExtent extent, uint32_t minLength = 1);
@@ -9,7 +9,9 @@
 #include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <Descriptors.hpp>
@@ -60,6 +62,10 @@ struct GpuTraits
   bool require_presentation = false;
   /// GPU must support geometry shaders
   bool require_geometry_shaders = false;
+  /// desired count of graphics queues. Framebuffers ended with IContext::EndFrames are spread
+  /// across them, so they must not share images written by shaders of one of them (layouts of
+  /// shared textures are handled by RHI). It's clamped by count of queues in GPU's graphics family
+  uint32_t graphics_queues_count = 1;
 
   // add new flags or requirenets if you need it
 };
@@ -155,6 +161,42 @@ enum class CompareOperation
   Always = 7
 };
 
+/// @brief action performed on stencil buffer value after stencil/depth test
+enum class StencilOperation : uint8_t
+{
+  Keep,              ///< keep current value
+  Zero,              ///< set value to 0
+  Replace,           ///< set value to reference value
+  IncrementAndClamp, ///< increment value and clamp it to maximum
+  DecrementAndClamp, ///< decrement value and clamp it to 0
+  Invert,            ///< invert bits of value
+  IncrementAndWrap,  ///< increment value and wrap it to 0 on overflow
+  DecrementAndWrap   ///< decrement value and wrap it to maximum on underflow
+};
+
+/// @brief faces of polygon which stencil state is applied to
+enum class StencilFace : uint8_t
+{
+  Front,       ///< state is applied only to front faces
+  Back,        ///< state is applied only to back faces
+  FrontAndBack ///< state is applied to both faces
+};
+
+/// @brief what happens with attachment content at the beginning of rendering
+enum class AttachmentLoadOp : uint8_t
+{
+  Clear,   ///< content is cleared with clear value of RenderTarget
+  Load,    ///< content of previous rendering is kept
+  DontCare ///< content is undefined, use it if rendering overwrites all pixels
+};
+
+/// @brief what happens with attachment content at the end of rendering
+enum class AttachmentStoreOp : uint8_t
+{
+  Store,   ///< content is written to memory
+  DontCare ///< content is discarded, use it if nobody reads it after rendering
+};
+
 /// @brief types of command buffers
 enum class CommandBufferType : uint8_t
 {
@@ -236,7 +278,9 @@ struct ISubpassConfiguration : public IInvalidable
   virtual void AddInputBinding(uint32_t slot, uint32_t stride, InputBindingType type) = 0;
   virtual void AddInputAttribute(uint32_t binding, uint32_t location, uint32_t offset,
                                  uint32_t elemsCount, InputAttributeElementType elemsType) = 0;
-  virtual void DefinePushConstant(uint32_t size, ShaderType shaderStage) = 0;
+  /// @brief declares push constant range for the stages. Each stage can be used in one range only,
+  /// so range of the same stages is replaced. offset + size must fit into maxPushConstantsSize
+  virtual void DefinePushConstant(uint32_t size, ShaderType shaderStage, uint32_t offset = 0) = 0;
 
   virtual IBufferUniformDescriptor * DeclareUniform(LayoutIndex index, ShaderType shaderStage) = 0;
 
@@ -248,6 +292,29 @@ struct ISubpassConfiguration : public IInvalidable
   /// Sampler2D / Sampler2DArray uniform
   virtual void DeclareSamplersArray(LayoutIndex index, ShaderType shaderStage, uint32_t size,
                                     ISamplerUniformDescriptor * outArray[]) = 0;
+  /// Storage buffer (SSBO, readonly or read-write buffer block)
+  virtual IBufferUniformDescriptor * DeclareStorageBuffer(LayoutIndex index,
+                                                          ShaderType shaderStage) = 0;
+  /// Storage image (image2D, read-write image without sampler)
+  virtual IStorageImageDescriptor * DeclareStorageImage(LayoutIndex index,
+                                                        ShaderType shaderStage) = 0;
+  /// Uniform buffer with dynamic offset. Offset is set with ISubpass::BindUniformOffsets.
+  /// blockSize is size of uniform block visible to shader
+  virtual IBufferUniformDescriptor * DeclareDynamicUniform(LayoutIndex index,
+                                                           ShaderType shaderStage,
+                                                           uint32_t blockSize) = 0;
+  /// Storage buffer with dynamic offset. Offset is set with ISubpass::BindUniformOffsets.
+  virtual IBufferUniformDescriptor * DeclareDynamicStorageBuffer(LayoutIndex index,
+                                                                 ShaderType shaderStage,
+                                                                 uint32_t blockSize) = 0;
+  /// Sampler2D uniform whose sampler is baked into descriptor set layout (immutable sampler).
+  /// Wrapping and filter must be set before Invalidate(), their changes rebuild the layout
+  virtual ISamplerUniformDescriptor * DeclareImmutableSampler(LayoutIndex index,
+                                                              ShaderType shaderStage) = 0;
+  /// @brief binds context's bindless table of textures to the set (sampler2D array at binding 0).
+  /// Shaders access texture by ITexture::GetBindlessIndex() passed in push constant or uniform.
+  /// The set must not contain other descriptors. Throws if bindless textures aren't supported
+  virtual void UseBindlessTextures(uint32_t set) = 0;
   ///// Texture2DArray + sampler uniform
   //virtual ISamplerArrayUniformDescriptor * DeclareSamplersArray(LayoutIndex index,
   //                                                              ShaderType shaderStage,
@@ -271,17 +338,36 @@ struct IRenderTarget
   virtual void SetClearValue(uint32_t attachmentIndex, float depth, uint32_t stencil) noexcept = 0;
 };
 
-struct ISubpass
+/// @brief arguments of one indirect draw. Layout matches VkDrawIndirectCommand
+struct DrawIndirectArgs final
 {
-  virtual ~ISubpass() = default;
-  /// @brief begins subpass (writing a commands for subpass)
-  /// @return true if can render this subpass
-  virtual bool BeginPass() = 0;
-  virtual void EndPass() = 0;
-  virtual ISubpassConfiguration & GetConfiguration() & noexcept = 0;
-  virtual void SetEnabled(bool enabled) noexcept = 0;
-  virtual bool IsEnabled() const noexcept = 0;
-  virtual bool ShouldBeInvalidated() const noexcept = 0;
+  uint32_t vertexCount;
+  uint32_t instanceCount;
+  uint32_t firstVertex;
+  uint32_t firstInstance;
+};
+
+/// @brief arguments of one indexed indirect draw. Layout matches VkDrawIndexedIndirectCommand
+struct DrawIndexedIndirectArgs final
+{
+  uint32_t indexCount;
+  uint32_t instanceCount;
+  uint32_t firstIndex;
+  int32_t vertexOffset;
+  uint32_t firstInstance;
+};
+
+/// @brief vertex buffer and offset in it for BindVertexBuffers
+struct VertexBufferBinding final
+{
+  const IBufferGPU * buffer = nullptr;
+  uint32_t offset = 0;
+};
+
+/// @brief commands which can be recorded in subpass
+struct ISubpassCommands
+{
+  virtual ~ISubpassCommands() = default;
 
   /// @brief draw vertices command (analog glDrawArrays)
   virtual void DrawVertices(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex = 0,
@@ -290,16 +376,107 @@ struct ISubpass
   virtual void DrawIndexedVertices(uint32_t indexCount, uint32_t instanceCount,
                                    uint32_t firstIndex = 0, int32_t vertexOffset = 0,
                                    uint32_t firstInstance = 0) = 0;
-  /// @brief Set viewport command
+  /// @brief draws with arguments (DrawIndirectArgs) read from buffer with IndirectBuffer usage
+  virtual void DrawIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                            uint32_t stride = sizeof(DrawIndirectArgs)) = 0;
+  /// @brief draws with arguments (DrawIndexedIndirectArgs) read from buffer
+  virtual void DrawIndexedIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                                   uint32_t stride = sizeof(DrawIndexedIndirectArgs)) = 0;
+  /// @brief like DrawIndirect, but count of draws (uint32_t) is read from countBuffer too.
+  /// Requires Vulkan 1.2, otherwise it's ignored with error message
+  virtual void DrawIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                 const IBufferGPU & countBuffer, uint32_t countOffset,
+                                 uint32_t maxDrawCount,
+                                 uint32_t stride = sizeof(DrawIndirectArgs)) = 0;
+  /// @brief like DrawIndexedIndirect, but count of draws (uint32_t) is read from countBuffer too
+  virtual void DrawIndexedIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                        const IBufferGPU & countBuffer, uint32_t countOffset,
+                                        uint32_t maxDrawCount,
+                                        uint32_t stride = sizeof(DrawIndexedIndirectArgs)) = 0;
+  /// @brief Set viewport command. If GPU supports inherited viewport, the viewport covers whole
+  /// render target and this command is ignored, so subpass isn't recorded again after resize
   virtual void SetViewport(float width, float height) = 0;
-  /// @brief Set scissor command
+  /// @brief Set scissor command. Ignored like SetViewport if scissor is inherited
   virtual void SetScissor(int32_t x, int32_t y, uint32_t width, uint32_t height) = 0;
   /// @brief binds buffer as input attribute data
   virtual void BindVertexBuffer(uint32_t binding, const IBufferGPU & buffer,
                                 uint32_t offset = 0) = 0;
+  /// @brief binds several buffers to consecutive bindings starting from firstBinding in one command
+  virtual void BindVertexBuffers(uint32_t firstBinding,
+                                 std::span<const VertexBufferBinding> buffers) = 0;
   /// @brief binds buffer as index buffer
   virtual void BindIndexBuffer(const IBufferGPU & buffer, IndexType type, uint32_t offset = 0) = 0;
+  /// @brief pushes bytes from offset 0 to all stages whose ranges contain them
   virtual void PushConstant(const void * data, size_t size) = 0;
+  /// @brief pushes bytes to the stages. Stages must match all ranges which contain the bytes,
+  /// otherwise push constant is ignored with error message
+  virtual void PushConstant(ShaderType shaderStage, uint32_t offset, const void * data,
+                            size_t size) = 0;
+  template<typename T>
+  void PushConstant(ShaderType shaderStage, uint32_t offset, const T & value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "push constant must be trivially copyable");
+    PushConstant(shaderStage, offset, &value, sizeof(T));
+  }
+  /// @brief set offsets for dynamic uniforms/storage buffers of the set.
+  /// Offsets are ordered by binding and must be aligned to IContext::GetDynamicOffsetAlignment().
+  /// Offsets which are misaligned or move descriptor out of buffer are ignored with error message
+  virtual void BindUniformOffsets(uint32_t set, const uint32_t * offsets, uint32_t count) = 0;
+
+  // Dynamic states. They don't rebuild pipeline and can be changed between draw calls.
+  // They require Vulkan 1.3 (extended dynamic state), otherwise they are ignored with error message
+  /// @brief enables or disables depth test
+  virtual void SetDepthTestEnabled(bool enabled) = 0;
+  /// @brief enables or disables writing to depth buffer
+  virtual void SetDepthWriteEnabled(bool enabled) = 0;
+  /// @brief set compare operation for depth test
+  virtual void SetDepthCompareOp(CompareOperation op) = 0;
+  /// @brief set which polygons will be culled
+  virtual void SetCullingMode(CullingMode mode) = 0;
+  /// @brief set which polygons are front
+  virtual void SetFrontFace(FrontFace face) = 0;
+  /// @brief set mesh topology. New topology must be of the same class (point, line or triangle) as in configuration
+  virtual void SetMeshTopology(MeshTopology topology) = 0;
+  /// @brief enables or disables stencil test
+  virtual void SetStencilTestEnabled(bool enabled) = 0;
+  /// @brief set stencil operations for faces
+  virtual void SetStencilOp(StencilFace face, StencilOperation failOp, StencilOperation passOp,
+                            StencilOperation depthFailOp, CompareOperation compareOp) = 0;
+};
+
+struct ISubpass : public ISubpassCommands
+{
+  virtual ~ISubpass() = default;
+  /// @brief begins subpass (writing a commands for subpass)
+  /// @return true if can render this subpass
+  virtual bool BeginPass() = 0;
+  /// @brief begins subpass with several recorders which can be filled from different threads.
+  /// Commands of recorders are executed in order of their indices
+  /// @return true if can render this subpass
+  virtual bool BeginParallelPass(uint32_t recordersCount) = 0;
+  /// @brief returns recorder of pass begun by BeginParallelPass.
+  /// Commands called on subpass itself are recorded to recorder 0, they are ignored outside
+  /// of pass. Throws if pass isn't begun
+  virtual ISubpassCommands & GetRecorder(uint32_t index) & = 0;
+  /// @brief finishes recording of all recorders. All threads must finish their recording before
+  virtual void EndPass() = 0;
+  virtual ISubpassConfiguration & GetConfiguration() & noexcept = 0;
+  virtual void SetEnabled(bool enabled) noexcept = 0;
+  virtual bool IsEnabled() const noexcept = 0;
+  virtual bool ShouldBeInvalidated() const noexcept = 0;
+  /// @brief count of redundant commands (same state set again) dropped in last recorded pass
+  virtual size_t GetElidedCommandsCount() const noexcept = 0;
+};
+
+/// @brief load/store policy of attachment in framebuffer.
+/// Transient attachments and stencil of formats without stencil are never stored,
+/// so transient attachments can't be loaded
+struct AttachmentOps
+{
+  AttachmentLoadOp loadOp = AttachmentLoadOp::Clear;
+  AttachmentStoreOp storeOp = AttachmentStoreOp::Store;
+  AttachmentLoadOp stencilLoadOp = AttachmentLoadOp::Clear;
+  AttachmentStoreOp stencilStoreOp = AttachmentStoreOp::Store;
 };
 
 /// @brief RenderPass is object that can render frames.
@@ -308,12 +485,105 @@ struct IFramebuffer
   virtual ~IFramebuffer() = default;
   virtual IRenderTarget * BeginFrame() = 0;
   virtual IAwaitable * EndFrame() = 0;
-  virtual void AddAttachment(uint32_t binding, IAttachment * attachment) = 0;
+  virtual void AddAttachment(uint32_t binding, IAttachment * attachment,
+                             const AttachmentOps & ops = {}) = 0;
   virtual void Resize(uint32_t width, uint32_t height) = 0;
   virtual RHI::TexelIndex GetExtent() const = 0;
 
   virtual void ClearAttachments() noexcept = 0;
   virtual ISubpass * CreateSubpass() = 0;
+  /// @brief statistics: how many framebuffer objects were created during last second.
+  /// Nonzero value in steady state means that attachments are changed too often
+  virtual uint32_t GetFramebufferRebuildsPerSecond() const noexcept = 0;
+};
+
+/// @brief ComputeConfiguration is container for compute pipeline settings (shader, push constants, uniforms).
+/// Changes are applied in next BeginPass of owning ComputePass
+struct IComputeConfiguration : public IInvalidable
+{
+  virtual ~IComputeConfiguration() = default;
+  /// @brief attach compute shader to pipeline
+  virtual void AttachShader(const SpirV & spirv) = 0;
+  virtual void DefinePushConstant(uint32_t size, uint32_t offset = 0) = 0;
+
+  virtual IBufferUniformDescriptor * DeclareUniform(LayoutIndex index) = 0;
+  /// Sampler2D / Sampler2DArray uniform
+  virtual ISamplerUniformDescriptor * DeclareSampler(LayoutIndex index) = 0;
+
+  virtual void DeclareUniformsArray(LayoutIndex index, uint32_t size,
+                                    IBufferUniformDescriptor * outArray[]) = 0;
+  /// Sampler2D / Sampler2DArray uniform
+  virtual void DeclareSamplersArray(LayoutIndex index, uint32_t size,
+                                    ISamplerUniformDescriptor * outArray[]) = 0;
+  /// Storage buffer (SSBO, readonly or read-write buffer block)
+  virtual IBufferUniformDescriptor * DeclareStorageBuffer(LayoutIndex index) = 0;
+  /// Storage image (image2D, read-write image without sampler)
+  virtual IStorageImageDescriptor * DeclareStorageImage(LayoutIndex index) = 0;
+  /// Sampler2D uniform with immutable sampler (see ISubpassConfiguration)
+  virtual ISamplerUniformDescriptor * DeclareImmutableSampler(LayoutIndex index) = 0;
+  /// @brief binds context's bindless table of textures to the set (see ISubpassConfiguration)
+  virtual void UseBindlessTextures(uint32_t set) = 0;
+};
+
+/// @brief ComputePass records compute commands and submits them into compute queue.
+/// If GPU has separate compute queue, it's executed asynchronously with rendering.
+/// Only storage textures and storage or indirect buffers are shared with such queue
+struct IComputePass
+{
+  virtual ~IComputePass() = default;
+  /// @brief begins writing of commands. Waits for previous submit is completed
+  /// @return true if pass can be recorded
+  virtual bool BeginPass() = 0;
+  virtual void EndPass() = 0;
+  /// @brief submits recorded commands into compute queue
+  virtual IAwaitable * Submit() = 0;
+  virtual IComputeConfiguration & GetConfiguration() & noexcept = 0;
+
+  /// @brief dispatch compute work groups
+  virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1,
+                        uint32_t groupCountZ = 1) = 0;
+  /// @brief dispatch compute work groups, count of groups is read from buffer
+  virtual void DispatchIndirect(const IBufferGPU & buffer, uint32_t offset = 0) = 0;
+  virtual void PushConstant(const void * data, size_t size) = 0;
+  virtual void PushConstant(uint32_t offset, const void * data, size_t size) = 0;
+  template<typename T>
+  void PushConstant(uint32_t offset, const T & value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "push constant must be trivially copyable");
+    PushConstant(offset, &value, sizeof(T));
+  }
+};
+
+/// @brief RenderGraph executes compute passes in order of adding. Passes declare textures and
+/// buffers they read or write, so graph records merged barriers between passes
+/// and skips passes which don't contribute to outputs. Graph transits layouts only of declared
+/// textures, so every image used by pass must be declared.
+/// Only compute passes are scheduled: framebuffers and transfers are executed outside of graph,
+/// so their usage of graph resources is synchronized by IAwaitable returned from Execute.
+/// Graph doesn't own resources, so it doesn't alias memory of transient resources
+struct IRenderGraph
+{
+  /// @brief records commands of pass. It's called between BeginPass and EndPass
+  using RecordFunc = std::function<void(IComputePass & pass)>;
+
+  virtual ~IRenderGraph() = default;
+  /// @return index of pass in graph
+  virtual uint32_t AddComputePass(IComputePass & pass, RecordFunc && recordFunc) = 0;
+  /// @brief texture is sampled by pass
+  virtual void ReadTexture(uint32_t passIndex, ITexture & texture) = 0;
+  /// @brief texture is used as storage image by pass
+  virtual void WriteTexture(uint32_t passIndex, ITexture & texture) = 0;
+  virtual void ReadBuffer(uint32_t passIndex, const IBufferGPU & buffer) = 0;
+  virtual void WriteBuffer(uint32_t passIndex, const IBufferGPU & buffer) = 0;
+  /// @brief marks resource as result of graph. If there are outputs, passes which don't
+  /// contribute to them aren't executed
+  virtual void MarkOutput(ITexture & texture) = 0;
+  virtual void MarkOutput(const IBufferGPU & buffer) = 0;
+  /// @brief records and submits passes into compute queue
+  /// @return task of execution. It's valid until two next calls of Execute
+  virtual IAwaitable * Execute() = 0;
+  /// @brief removes all passes and outputs
+  virtual void Reset() = 0;
 };
 
 // ------------------- Data ------------------
@@ -344,6 +614,15 @@ struct IBufferGPU
   virtual size_t Size() const noexcept = 0;
 };
 
+/// @brief memory which is valid until GPU completes the frame (see IContext::AllocateTransient)
+struct TransientAllocation final
+{
+  void * data = nullptr;               ///< CPU pointer to write data
+  const IBufferGPU * buffer = nullptr; ///< the same buffer for all frames
+  size_t offset = 0;                   ///< offset in buffer (use it as dynamic offset)
+  size_t size = 0;
+};
+
 struct UploadImageArgs final
 {
   HostTextureView srcTexture;
@@ -361,6 +640,9 @@ struct DownloadImageArgs final
   uint32_t layersCount = std::numeric_limits<uint32_t>::max();
 };
 
+/// @brief index of texture which isn't registered in bindless table
+constexpr uint32_t InvalidBindlessIndex = std::numeric_limits<uint32_t>::max();
+
 /// Image with mipmaps, compression
 struct ITexture
 {
@@ -374,6 +656,9 @@ struct ITexture
   virtual size_t Size() const = 0;
   //virtual void SetSwizzle() = 0;
   virtual void BlitTo(ITexture * texture) = 0;
+  /// @brief stable index of texture in bindless table while texture is alive.
+  /// InvalidBindlessIndex if bindless textures aren't supported or table is full
+  virtual uint32_t GetBindlessIndex() const noexcept = 0;
 };
 
 /// swapchained image sequence to attach it to framebuffer
@@ -398,6 +683,13 @@ struct IContext
 
   virtual IFramebuffer * CreateFramebuffer() = 0;
   virtual void DeleteFramebuffer(IFramebuffer * fbo) = 0;
+  /// @brief ends frames of independent framebuffers (instead of IFramebuffer::EndFrame) with one
+  /// submit per graphics queue. Framebuffers whose BeginFrame failed are skipped
+  virtual IAwaitable * EndFrames(std::span<IFramebuffer * const> framebuffers) = 0;
+  virtual IComputePass * CreateComputePass() = 0;
+  virtual void DeleteComputePass(IComputePass * pass) = 0;
+  virtual IRenderGraph * CreateRenderGraph() = 0;
+  virtual void DeleteRenderGraph(IRenderGraph * graph) = 0;
   virtual IBufferGPU * CreateBuffer(size_t size, BufferGPUUsage usage, bool allowHostAccess) = 0;
   virtual void DeleteBuffer(IBufferGPU * buffer) = 0;
   virtual ITexture * CreateTexture(const TextureDescription & args) = 0;
@@ -405,10 +697,23 @@ struct IContext
 
   virtual IAttachment * CreateSurfacedAttachment(const SurfaceConfig & surfaceTraits,
                                                  RenderBuffering buffering) = 0;
+  /// @param transient - content isn't kept after rendering (depth or MSAA images which are
+  /// resolved). Such attachment may use lazily allocated memory, but can't be downloaded
   virtual IAttachment * CreateAttachment(RHI::ImageFormat format, const RHI::TextureExtent & extent,
                                          RenderBuffering buffering,
-                                         RHI::SamplesCount samplesCount) = 0;
+                                         RHI::SamplesCount samplesCount,
+                                         bool transient = false) = 0;
   virtual void DeleteAttachment(IAttachment * attachment) = 0;
+
+  /// @brief alignment of offsets for dynamic uniforms and storage buffers
+  virtual size_t GetDynamicOffsetAlignment() const noexcept = 0;
+  /// @brief allocates per-frame memory for uniforms or storage buffers.
+  /// Memory is reused after GPU completes work submitted before the end of frame. Frame ends when
+  /// all begun framebuffers are ended (by IFramebuffer::EndFrame or EndFrames)
+  /// @param alignment - 0 means GetDynamicOffsetAlignment()
+  virtual TransientAllocation AllocateTransient(size_t size, size_t alignment = 0) = 0;
+  /// @brief true if GPU supports descriptor indexing, so textures have bindless indices
+  virtual bool IsBindlessTexturesSupported() const noexcept = 0;
 };
 
 /// @brief Factory-function to create context
@@ -0,0 +1,96 @@
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+#include <CommandsExecution/BarrierBatch.hpp>
+
+using RHI::vulkan::details::BarrierBatch;
+
+namespace
+{
+VkImageMemoryBarrier2 MakeImageBarrier(uintptr_t imageId, VkPipelineStageFlags2 srcStages,
+                                       VkPipelineStageFlags2 dstStages, VkImageLayout newLayout)
+{
+  VkImageMemoryBarrier2 barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+  barrier.srcStageMask = srcStages;
+  barrier.dstStageMask = dstStages;
+  barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+  barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  // images aren't accessed by batch, so any unique handles fit
+  barrier.image = reinterpret_cast<VkImage>(imageId);
+  barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+  return barrier;
+}
+} // namespace
+
+TEST_CASE("Batch collects barriers of all kinds until it's cleared", "[barriers]")
+{
+  BarrierBatch batch;
+  REQUIRE(batch.Empty());
+
+  VkMemoryBarrier2 memoryBarrier{};
+  memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+  VkBufferMemoryBarrier2 bufferBarrier{};
+  bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+  batch.AddMemoryBarrier(memoryBarrier);
+  batch.AddBufferBarrier(bufferBarrier);
+  batch.AddImageBarrier(MakeImageBarrier(1, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+  batch.AddImageBarrier(MakeImageBarrier(2, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+
+  REQUIRE_FALSE(batch.Empty());
+  REQUIRE(batch.GetMemoryBarriers().size() == 1);
+  REQUIRE(batch.GetBufferBarriers().size() == 1);
+  REQUIRE(batch.GetImageBarriers().size() == 2);
+
+  batch.Clear();
+  REQUIRE(batch.Empty());
+}
+
+TEST_CASE("Legacy barriers merge stages of all barriers", "[barriers]")
+{
+  BarrierBatch batch;
+  batch.AddImageBarrier(MakeImageBarrier(1, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+  batch.AddImageBarrier(MakeImageBarrier(2, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                         VK_IMAGE_LAYOUT_GENERAL));
+
+  const auto legacy = batch.MakeLegacyBarriers();
+  REQUIRE(legacy.srcStages ==
+          (VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT));
+  REQUIRE(legacy.dstStages ==
+          (VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT));
+  REQUIRE(legacy.memoryBarriers.empty());
+  REQUIRE(legacy.bufferBarriers.empty());
+  REQUIRE(legacy.imageBarriers.size() == 2);
+
+  auto && barrier = legacy.imageBarriers.back();
+  REQUIRE(barrier.sType == VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER);
+  REQUIRE(barrier.image == reinterpret_cast<VkImage>(uintptr_t{2}));
+  REQUIRE(barrier.oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+  REQUIRE(barrier.newLayout == VK_IMAGE_LAYOUT_GENERAL);
+  REQUIRE(barrier.dstAccessMask == VK_ACCESS_SHADER_READ_BIT);
+  REQUIRE(barrier.subresourceRange.layerCount == 1);
+}
+
+TEST_CASE("Legacy barriers replace empty stages", "[barriers]")
+{
+  // empty stage masks are valid only with synchronization2
+  BarrierBatch batch;
+  VkMemoryBarrier2 barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+  batch.AddMemoryBarrier(barrier);
+
+  const auto legacy = batch.MakeLegacyBarriers();
+  REQUIRE(legacy.srcStages == VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+  REQUIRE(legacy.dstStages == VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+  REQUIRE(legacy.memoryBarriers.size() == 1);
+}
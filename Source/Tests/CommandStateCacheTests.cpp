@@ -0,0 +1,109 @@
+#include <array>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+#include <CommandsExecution/CommandStateCache.hpp>
+
+using RHI::vulkan::details::CommandStateCache;
+
+namespace
+{
+VkBuffer MakeFakeBuffer(uintptr_t id)
+{
+  // buffers are only compared by cache, so any unique handles fit
+  return reinterpret_cast<VkBuffer>(id);
+}
+} // namespace
+
+TEST_CASE("Repeated viewport and scissor are elided", "[state_cache]")
+{
+  CommandStateCache cache;
+  const VkViewport viewport{0.0f, 0.0f, 800.0f, 600.0f, 0.0f, 1.0f};
+  const VkRect2D scissor{{0, 0}, {800, 600}};
+
+  REQUIRE(cache.UpdateViewport(viewport));
+  REQUIRE_FALSE(cache.UpdateViewport(viewport));
+  REQUIRE(cache.UpdateScissor(scissor));
+  REQUIRE_FALSE(cache.UpdateScissor(scissor));
+  REQUIRE(cache.GetElidedCommandsCount() == 2);
+
+  VkViewport otherViewport = viewport;
+  otherViewport.maxDepth = 0.5f;
+  REQUIRE(cache.UpdateViewport(otherViewport));
+  REQUIRE(cache.GetElidedCommandsCount() == 2);
+}
+
+TEST_CASE("Reset forgets tracked state", "[state_cache]")
+{
+  CommandStateCache cache;
+  const VkRect2D scissor{{0, 0}, {800, 600}};
+  REQUIRE(cache.UpdateScissor(scissor));
+  REQUIRE_FALSE(cache.UpdateScissor(scissor));
+
+  cache.Reset();
+  REQUIRE(cache.GetElidedCommandsCount() == 0);
+  REQUIRE(cache.UpdateScissor(scissor));
+}
+
+TEST_CASE("Vertex buffers are elided only if all bindings are unchanged", "[state_cache]")
+{
+  CommandStateCache cache;
+  const std::array<VkBuffer, 2> buffers{MakeFakeBuffer(1), MakeFakeBuffer(2)};
+  const std::array<VkDeviceSize, 2> offsets{0, 64};
+
+  REQUIRE(cache.UpdateVertexBuffers(0, buffers, offsets));
+  REQUIRE_FALSE(cache.UpdateVertexBuffers(0, buffers, offsets));
+  // subset of bound buffers is unchanged too
+  REQUIRE_FALSE(cache.UpdateVertexBuffers(1, std::span(buffers).subspan(1),
+                                          std::span(offsets).subspan(1)));
+
+  const std::array<VkDeviceSize, 2> newOffsets{0, 128};
+  REQUIRE(cache.UpdateVertexBuffers(0, buffers, newOffsets));
+  // binding which was never set isn't elided
+  REQUIRE(cache.UpdateVertexBuffers(2, std::span(buffers).first(1), std::span(offsets).first(1)));
+  REQUIRE(cache.GetElidedCommandsCount() == 2);
+}
+
+TEST_CASE("Index buffer is compared with offset and type", "[state_cache]")
+{
+  CommandStateCache cache;
+  const VkBuffer buffer = MakeFakeBuffer(1);
+
+  REQUIRE(cache.UpdateIndexBuffer(buffer, 0, VK_INDEX_TYPE_UINT16));
+  REQUIRE_FALSE(cache.UpdateIndexBuffer(buffer, 0, VK_INDEX_TYPE_UINT16));
+  REQUIRE(cache.UpdateIndexBuffer(buffer, 0, VK_INDEX_TYPE_UINT32));
+  REQUIRE(cache.UpdateIndexBuffer(buffer, 32, VK_INDEX_TYPE_UINT32));
+  REQUIRE(cache.GetElidedCommandsCount() == 1);
+}
+
+TEST_CASE("Push constants are elided per stage and byte", "[state_cache]")
+{
+  CommandStateCache cache;
+  const std::array<uint32_t, 4> data{1, 2, 3, 4};
+  const VkShaderStageFlags bothStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+  REQUIRE(cache.UpdatePushConstants(bothStages, 0, sizeof(data), data.data()));
+  REQUIRE_FALSE(cache.UpdatePushConstants(bothStages, 0, sizeof(data), data.data()));
+  // every stage keeps its own copy of bytes
+  REQUIRE_FALSE(cache.UpdatePushConstants(VK_SHADER_STAGE_FRAGMENT_BIT, 4, sizeof(uint32_t),
+                                          &data[1]));
+
+  const uint32_t newValue = 5;
+  REQUIRE(cache.UpdatePushConstants(VK_SHADER_STAGE_VERTEX_BIT, 4, sizeof(uint32_t), &newValue));
+  // fragment stage still has old bytes
+  REQUIRE(
+    cache.UpdatePushConstants(VK_SHADER_STAGE_FRAGMENT_BIT, 4, sizeof(uint32_t), &newValue));
+  // bytes which were never pushed are unknown
+  REQUIRE(cache.UpdatePushConstants(VK_SHADER_STAGE_VERTEX_BIT, 16, sizeof(uint32_t), &newValue));
+  REQUIRE(cache.GetElidedCommandsCount() == 2);
+}
+
+TEST_CASE("Dynamic states are tracked independently", "[state_cache]")
+{
+  CommandStateCache cache;
+  REQUIRE(cache.UpdateDynamicState(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, VK_TRUE));
+  REQUIRE(cache.UpdateDynamicState(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE, VK_TRUE));
+  REQUIRE_FALSE(cache.UpdateDynamicState(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, VK_TRUE));
+  REQUIRE(cache.UpdateDynamicState(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, VK_FALSE));
+  REQUIRE(cache.GetElidedCommandsCount() == 1);
+}
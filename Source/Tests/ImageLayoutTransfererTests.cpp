@@ -0,0 +1,114 @@
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+#include <CommandsExecution/BarrierBatch.hpp>
+#include <ImageUtils/ImageLayoutTransferer.hpp>
+
+using RHI::vulkan::ImageLayoutTransferer;
+using RHI::vulkan::details::BarrierBatch;
+
+namespace
+{
+// image isn't accessed by transferer, so any unique handle fits
+const VkImage g_image = reinterpret_cast<VkImage>(uintptr_t{1});
+
+constexpr VkImageSubresourceRange MakeRange(uint32_t baseMip, uint32_t mipsCount,
+                                            uint32_t baseLayer, uint32_t layersCount)
+{
+  return VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, baseMip, mipsCount, baseLayer,
+                                 layersCount};
+}
+} // namespace
+
+TEST_CASE("Transition of one layer splits range of layers", "[layouts]")
+{
+  ImageLayoutTransferer transferer(g_image, VK_IMAGE_ASPECT_COLOR_BIT, 1, 4);
+  transferer.TransferLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+  BarrierBatch batch;
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_NONE,
+                            MakeRange(0, 1, 1, 1));
+
+  REQUIRE(batch.GetImageBarriers().size() == 1);
+  auto && barrier = batch.GetImageBarriers().front();
+  REQUIRE(barrier.oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  REQUIRE(barrier.newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  REQUIRE(barrier.subresourceRange.baseArrayLayer == 1);
+  REQUIRE(barrier.subresourceRange.layerCount == 1);
+
+  REQUIRE(transferer.GetLayout(MakeRange(0, 1, 1, 1)) == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  REQUIRE(transferer.GetLayout(MakeRange(0, 1, 0, 1)) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  REQUIRE(transferer.GetLayout(MakeRange(0, 1, 2, 2)) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  // layers are in different layouts
+  REQUIRE(transferer.GetLayout() == VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
+TEST_CASE("Neighbour layers in the same state are merged", "[layouts]")
+{
+  ImageLayoutTransferer transferer(g_image, VK_IMAGE_ASPECT_COLOR_BIT, 1, 4);
+  BarrierBatch batch;
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_NONE,
+                            MakeRange(0, 1, 1, 2));
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, MakeRange(0, 1, 1, 2));
+  REQUIRE(transferer.GetLayout() == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+  // all layers are transfered with one barrier after they are merged
+  batch.Clear();
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_GENERAL);
+  REQUIRE(batch.GetImageBarriers().size() == 1);
+  auto && barrier = batch.GetImageBarriers().front();
+  REQUIRE(barrier.subresourceRange.baseArrayLayer == 0);
+  REQUIRE(barrier.subresourceRange.layerCount == 4);
+  REQUIRE(barrier.srcStageMask == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+}
+
+TEST_CASE("Neighbour mip levels are transfered with one barrier", "[layouts]")
+{
+  ImageLayoutTransferer transferer(g_image, VK_IMAGE_ASPECT_COLOR_BIT, 3, 1);
+  BarrierBatch batch;
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+  REQUIRE(batch.GetImageBarriers().size() == 1);
+  auto && barrier = batch.GetImageBarriers().front();
+  REQUIRE(barrier.oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+  REQUIRE(barrier.subresourceRange.baseMipLevel == 0);
+  REQUIRE(barrier.subresourceRange.levelCount == 3);
+}
+
+TEST_CASE("Mip levels in different layouts get separate barriers", "[layouts]")
+{
+  ImageLayoutTransferer transferer(g_image, VK_IMAGE_ASPECT_COLOR_BIT, 3, 1);
+  transferer.TransferLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  BarrierBatch batch;
+  // the first mip level is read to generate the next ones
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_NONE,
+                            MakeRange(0, 1, 0, 1));
+  batch.Clear();
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+  auto && barriers = batch.GetImageBarriers();
+  REQUIRE(barriers.size() == 2);
+  REQUIRE(barriers[0].oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  REQUIRE(barriers[0].subresourceRange.baseMipLevel == 0);
+  REQUIRE(barriers[0].subresourceRange.levelCount == 1);
+  REQUIRE(barriers[1].oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  REQUIRE(barriers[1].subresourceRange.baseMipLevel == 1);
+  REQUIRE(barriers[1].subresourceRange.levelCount == 2);
+}
+
+TEST_CASE("Subresources already in layout are skipped", "[layouts]")
+{
+  ImageLayoutTransferer transferer(g_image, VK_IMAGE_ASPECT_COLOR_BIT, 2, 2);
+  BarrierBatch batch;
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  REQUIRE_FALSE(batch.Empty());
+
+  batch.Clear();
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  transferer.TransferLayout(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                            VK_PIPELINE_STAGE_2_NONE, MakeRange(1, 1, 1, 1));
+  REQUIRE(batch.Empty());
+}
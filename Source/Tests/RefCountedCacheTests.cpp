@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+#include <Utils/RefCountedCache.hpp>
+
+namespace
+{
+using Cache = RHI::vulkan::utils::RefCountedCache<int, uint64_t>;
+
+/// @brief makes unique handles and counts created and destroyed objects
+struct ObjectsCounter
+{
+  uint64_t lastHandle = 0;
+  size_t created = 0;
+  size_t destroyed = 0;
+
+  auto MakeFunc()
+  {
+    return [this](int)
+    {
+      ++created;
+      return ++lastHandle;
+    };
+  }
+
+  auto DestroyFunc()
+  {
+    return [this](uint64_t, int) { ++destroyed; };
+  }
+};
+} // namespace
+
+TEST_CASE("Objects with identical descriptions are shared", "[caches]")
+{
+  Cache cache;
+  ObjectsCounter counter;
+  const auto first = cache.Acquire(1, counter.MakeFunc());
+  const auto second = cache.Acquire(1, counter.MakeFunc());
+  const auto other = cache.Acquire(2, counter.MakeFunc());
+
+  REQUIRE(first == second);
+  REQUIRE(first != other);
+  REQUIRE(counter.created == 2);
+  REQUIRE(cache.Size() == 2);
+  REQUIRE(cache.GetRefsCount(first) == 2);
+  REQUIRE(cache.GetRefsCount(other) == 1);
+}
+
+TEST_CASE("Object is destroyed when the last reference is released", "[caches]")
+{
+  Cache cache;
+  ObjectsCounter counter;
+  const auto handle = cache.Acquire(1, counter.MakeFunc());
+  cache.Acquire(1, counter.MakeFunc());
+
+  cache.Release(handle, counter.DestroyFunc());
+  REQUIRE(counter.destroyed == 0);
+  REQUIRE(cache.GetRefsCount(handle) == 1);
+
+  cache.Release(handle, counter.DestroyFunc());
+  REQUIRE(counter.destroyed == 1);
+  REQUIRE(cache.Size() == 0);
+
+  // released description is created again
+  const auto newHandle = cache.Acquire(1, counter.MakeFunc());
+  REQUIRE(newHandle != handle);
+  REQUIRE(counter.created == 2);
+}
+
+TEST_CASE("Handles which aren't owned by cache are skipped", "[caches]")
+{
+  Cache cache;
+  ObjectsCounter counter;
+  const auto handle = cache.Acquire(1, counter.MakeFunc());
+
+  cache.Release(0, counter.DestroyFunc());
+  cache.Release(handle + 100, counter.DestroyFunc());
+  cache.AddRef(handle + 100);
+  REQUIRE(counter.destroyed == 0);
+  REQUIRE(cache.GetRefsCount(handle) == 1);
+  REQUIRE(cache.GetRefsCount(handle + 100) == 0);
+}
+
+TEST_CASE("Added reference keeps object alive", "[caches]")
+{
+  // pipeline layouts keep references to their set layouts this way
+  Cache cache;
+  ObjectsCounter counter;
+  const auto handle = cache.Acquire(1, counter.MakeFunc());
+  cache.AddRef(handle);
+
+  cache.Release(handle, counter.DestroyFunc());
+  REQUIRE(counter.destroyed == 0);
+  cache.Release(handle, counter.DestroyFunc());
+  REQUIRE(counter.destroyed == 1);
+}
+
+TEST_CASE("Failed creation doesn't leave object in cache", "[caches]")
+{
+  Cache cache;
+  ObjectsCounter counter;
+  auto failingMake = [](int) -> uint64_t { throw std::runtime_error("Failed to create object"); };
+  REQUIRE_THROWS_AS(cache.Acquire(1, failingMake), std::runtime_error);
+  REQUIRE(cache.Size() == 0);
+
+  const auto handle = cache.Acquire(1, counter.MakeFunc());
+  REQUIRE(counter.created == 1);
+  REQUIRE(cache.GetRefsCount(handle) == 1);
+}
@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+#include <RenderGraph/ResourceAccessTracker.hpp>
+
+using RHI::vulkan::details::ResourceAccessTracker;
+
+namespace
+{
+/// resources are identified by addresses only
+const int g_firstResource = 1;
+const int g_secondResource = 2;
+} // namespace
+
+TEST_CASE("First access is synchronized with any previous work", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  const auto dependency = tracker.Access(&g_firstResource, true, false);
+  REQUIRE(dependency.has_value());
+  REQUIRE(dependency->srcStages == VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+  REQUIRE(dependency->srcAccess == VK_ACCESS_2_MEMORY_WRITE_BIT);
+  REQUIRE(dependency->dstStages == VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  REQUIRE(dependency->dstAccess == VK_ACCESS_2_SHADER_READ_BIT);
+}
+
+TEST_CASE("Read after read doesn't need barrier", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  tracker.Access(&g_firstResource, true, false);
+  REQUIRE_FALSE(tracker.Access(&g_firstResource, true, false).has_value());
+  REQUIRE_FALSE(tracker.Access(&g_firstResource, true, false).has_value());
+}
+
+TEST_CASE("Read after write waits for write", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  tracker.Access(&g_firstResource, false, true);
+  const auto dependency = tracker.Access(&g_firstResource, true, false);
+  REQUIRE(dependency.has_value());
+  REQUIRE(dependency->srcStages == VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  REQUIRE(dependency->srcAccess == VK_ACCESS_2_SHADER_WRITE_BIT);
+  REQUIRE(dependency->dstAccess == VK_ACCESS_2_SHADER_READ_BIT);
+}
+
+TEST_CASE("Write after read needs only execution dependency", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  tracker.Access(&g_firstResource, true, false);
+  tracker.Access(&g_firstResource, true, false);
+  const auto dependency = tracker.Access(&g_firstResource, true, true);
+  REQUIRE(dependency.has_value());
+  REQUIRE(dependency->srcStages == VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  REQUIRE(dependency->srcAccess == VK_ACCESS_2_NONE);
+  REQUIRE(dependency->dstAccess == (VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT));
+}
+
+TEST_CASE("Write after write waits for previous write", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  tracker.Access(&g_firstResource, false, true);
+  const auto dependency = tracker.Access(&g_firstResource, false, true);
+  REQUIRE(dependency.has_value());
+  REQUIRE(dependency->srcAccess == VK_ACCESS_2_SHADER_WRITE_BIT);
+  REQUIRE(dependency->dstAccess == VK_ACCESS_2_SHADER_WRITE_BIT);
+}
+
+TEST_CASE("Layout transition makes barrier even between reads", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  tracker.Access(&g_firstResource, true, false);
+  const auto dependency = tracker.Access(&g_firstResource, true, false, true);
+  REQUIRE(dependency.has_value());
+  REQUIRE(dependency->srcAccess == VK_ACCESS_2_NONE);
+}
+
+TEST_CASE("Resources are tracked independently", "[render_graph]")
+{
+  ResourceAccessTracker tracker;
+  tracker.Access(&g_firstResource, false, true);
+  tracker.Access(&g_secondResource, true, false);
+  // write to the first resource doesn't affect reads of the second one
+  REQUIRE_FALSE(tracker.Access(&g_secondResource, true, false).has_value());
+  REQUIRE(tracker.Access(&g_firstResource, true, false).has_value());
+}
@@ -18,7 +18,6 @@ struct IInternalAttachment : public IInternalTexture
   virtual RHI::SamplesCount GetSamplesCount() const noexcept = 0;
   // Rename to AddAttachmentDescriptionTo
   virtual VkAttachmentDescription BuildDescription() const noexcept = 0;
-  virtual void TransferLayout(VkImageLayout layout) noexcept = 0;
   virtual void Resize(const VkExtent2D & new_extent) noexcept = 0;
 };
 
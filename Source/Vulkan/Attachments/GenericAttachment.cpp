@@ -76,8 +76,13 @@ constexpr VkImageAspectFlags CalcImageAspectByFormat(RHI::ImageFormat format)
 }
 
 VkAttachmentDescription BuildAttachmentDescription(const RHI::TextureDescription & description,
-                                                   RHI::SamplesCount samplesCount) noexcept
+                                                   RHI::SamplesCount samplesCount,
+                                                   bool transient) noexcept
 {
+  const bool hasStencil = description.format == RHI::ImageFormat::DEPTH_STENCIL;
+  // transient content is never read after rendering, so tiled GPUs don't write it to memory
+  const VkAttachmentStoreOp storeOp =
+    transient ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
   VkAttachmentDescription attachmentDescription{};
   {
     attachmentDescription.format =
@@ -87,9 +92,10 @@ VkAttachmentDescription BuildAttachmentDescription(const RHI::TextureDescription
     attachmentDescription.initialLayout = MakeAttachmentInitialLayout(description.format);
     attachmentDescription.finalLayout = MakeAttachmentFinalLayout(description.format);
     attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attachmentDescription.storeOp = storeOp;
+    attachmentDescription.stencilLoadOp =
+      hasStencil ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachmentDescription.stencilStoreOp = hasStencil ? storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
   }
   return attachmentDescription;
 }
@@ -98,11 +104,13 @@ VkAttachmentDescription BuildAttachmentDescription(const RHI::TextureDescription
 namespace RHI::vulkan
 {
 GenericAttachment::GenericAttachment(Context & ctx, const TextureDescription & args,
-                                     RHI::RenderBuffering buffering, RHI::SamplesCount samplesCount)
+                                     RHI::RenderBuffering buffering, RHI::SamplesCount samplesCount,
+                                     bool transient /* = false*/)
   : OwnedBy<Context>(ctx)
   , m_description(args)
-  , m_samplesCount(samplesCount)
   , m_instancesCount(static_cast<uint32_t>(buffering))
+  , m_samplesCount(samplesCount)
+  , m_transient(transient)
 {
   m_images.reserve(m_instancesCount);
   m_views.reserve(m_instancesCount);
@@ -124,6 +132,8 @@ GenericAttachment::~GenericAttachment()
 std::future<DownloadResult> GenericAttachment::DownloadImage(HostImageFormat format,
                                                              const TextureRegion & region)
 {
+  if (m_transient)
+    throw std::runtime_error("Transient attachment has no content to download");
   DownloadImageArgs args{};
   args.format = format;
   args.copyRegion = region;
@@ -140,6 +150,11 @@ size_t GenericAttachment::Size() const
 
 void GenericAttachment::BlitTo(ITexture * texture)
 {
+  if (m_transient)
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_ERROR, "Transient attachment can't be blitted");
+    return;
+  }
   if (auto * ptr = dynamic_cast<IInternalTexture *>(texture))
     GetContext().GetTransferer().BlitImageToImage(*ptr, *this, RHI::TextureRegion{});
 }
@@ -161,16 +176,43 @@ void GenericAttachment::TransferLayout(details::CommandBuffer & commandBuffer, V
   m_layouts[m_activeImage].TransferLayout(commandBuffer, layout);
 }
 
+void GenericAttachment::TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout,
+                                       const VkImageSubresourceRange & range)
+{
+  m_layouts[m_activeImage].TransferLayout(commandBuffer, layout, range);
+}
+
+void GenericAttachment::TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                                       VkPipelineStageFlags2 stages)
+{
+  m_layouts[m_activeImage].TransferLayout(batch, layout, stages);
+}
+
 VkImageLayout GenericAttachment::GetLayout() const noexcept
 {
   return m_layouts[m_activeImage].GetLayout();
 }
 
+VkImageLayout GenericAttachment::GetLayout(const VkImageSubresourceRange & range) const noexcept
+{
+  return m_layouts[m_activeImage].GetLayout(range);
+}
+
 VkImage GenericAttachment::GetHandle() const noexcept
 {
   return m_images[m_activeImage].GetImage();
 }
 
+VkImageAspectFlags GenericAttachment::GetAspect() const noexcept
+{
+  return m_layouts[m_activeImage].GetAspect();
+}
+
+bool GenericAttachment::IsSharedWithCompute() const noexcept
+{
+  return false;
+}
+
 VkFormat GenericAttachment::GetInternalFormat() const noexcept
 {
   return utils::CastInterfaceEnum2Vulkan<VkFormat>(m_description.format);
@@ -219,13 +261,14 @@ void GenericAttachment::Invalidate()
     }
 
     auto desiredMSAA = utils::CastInterfaceEnum2Vulkan<VkSampleCountFlagBits>(m_samplesCount);
+    VkImageUsageFlags usage = CalcImageUsageByFormat(m_description.format);
+    if (m_transient)
+      usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
     while (m_images.size() < m_instancesCount)
     {
       auto memoryBlock =
-        GetContext().GetBuffersAllocator().AllocImage(m_description,
-                                                      CalcImageUsageByFormat(m_description.format),
-                                                      desiredMSAA);
-      m_layouts.emplace_back(memoryBlock.GetImage());
+        GetContext().GetBuffersAllocator().AllocImage(m_description, usage, desiredMSAA);
+      m_layouts.emplace_back(memoryBlock.GetImage(), CalcImageAspectByFormat(m_description.format));
       m_views.emplace_back(utils::CreateImageView(GetContext().GetGpuConnection().GetDevice(),
                                                   memoryBlock.GetImage(), GetInternalFormat(),
                                                   VK_IMAGE_VIEW_TYPE_2D,
@@ -265,7 +308,7 @@ RHI::SamplesCount GenericAttachment::GetSamplesCount() const noexcept
 VkAttachmentDescription GenericAttachment::BuildDescription() const noexcept
 {
   assert(!m_changedMSAA && !m_changedSize && !m_changedImagesCount);
-  return BuildAttachmentDescription(m_description, m_samplesCount);
+  return BuildAttachmentDescription(m_description, m_samplesCount, m_transient);
 }
 
 void GenericAttachment::TransferLayout(VkImageLayout layout) noexcept
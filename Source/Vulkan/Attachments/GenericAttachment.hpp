@@ -20,7 +20,8 @@ struct GenericAttachment : public IAttachment,
                            public OwnedBy<Context>
 {
   explicit GenericAttachment(Context & ctx, const TextureDescription & m_description,
-                             RHI::RenderBuffering buffering, RHI::SamplesCount samplesCount);
+                             RHI::RenderBuffering buffering, RHI::SamplesCount samplesCount,
+                             bool transient = false);
   virtual ~GenericAttachment() override;
   MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
 
@@ -36,8 +37,15 @@ public: //IInternalTexture interface
   virtual VkImageView GetImageView() const noexcept override;
   virtual void TransferLayout(details::CommandBuffer & commandBuffer,
                               VkImageLayout layout) override;
+  virtual void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout,
+                              const VkImageSubresourceRange & range) override;
+  virtual void TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                              VkPipelineStageFlags2 stages) override;
   virtual VkImageLayout GetLayout() const noexcept override;
+  virtual VkImageLayout GetLayout(const VkImageSubresourceRange & range) const noexcept override;
   virtual VkImage GetHandle() const noexcept override;
+  virtual VkImageAspectFlags GetAspect() const noexcept override;
+  virtual bool IsSharedWithCompute() const noexcept override;
   virtual VkFormat GetInternalFormat() const noexcept override;
   virtual VkExtent3D GetInternalExtent() const noexcept override;
   virtual uint32_t GetMipLevelsCount() const noexcept override;
@@ -64,6 +72,7 @@ protected:
 
   uint32_t m_instancesCount = 0;
   const RHI::SamplesCount m_samplesCount = RHI::SamplesCount::One;
+  const bool m_transient = false; ///< content isn't stored after rendering
   bool m_changedImagesCount = true;
   bool m_changedSize = false;
   bool m_changedMSAA = false;
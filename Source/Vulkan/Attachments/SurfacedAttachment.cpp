@@ -73,16 +73,43 @@ void SurfacedAttachment::TransferLayout(details::CommandBuffer & commandBuffer,
   m_layouts[m_activeImage].TransferLayout(commandBuffer, layout);
 }
 
+void SurfacedAttachment::TransferLayout(details::CommandBuffer & commandBuffer,
+                                        VkImageLayout layout, const VkImageSubresourceRange & range)
+{
+  m_layouts[m_activeImage].TransferLayout(commandBuffer, layout, range);
+}
+
+void SurfacedAttachment::TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                                        VkPipelineStageFlags2 stages)
+{
+  m_layouts[m_activeImage].TransferLayout(batch, layout, stages);
+}
+
 VkImageLayout SurfacedAttachment::GetLayout() const noexcept
 {
   return m_layouts[m_activeImage].GetLayout();
 }
 
+VkImageLayout SurfacedAttachment::GetLayout(const VkImageSubresourceRange & range) const noexcept
+{
+  return m_layouts[m_activeImage].GetLayout(range);
+}
+
 VkImage SurfacedAttachment::GetHandle() const noexcept
 {
   return m_images[m_activeImage];
 }
 
+VkImageAspectFlags SurfacedAttachment::GetAspect() const noexcept
+{
+  return m_layouts[m_activeImage].GetAspect();
+}
+
+bool SurfacedAttachment::IsSharedWithCompute() const noexcept
+{
+  return false;
+}
+
 VkFormat SurfacedAttachment::GetInternalFormat() const noexcept
 {
   return m_swapchain && m_swapchain->swapchain ? m_swapchain->image_format : g_vkFormat.format;
@@ -195,7 +222,11 @@ bool SurfacedAttachment::FinalRendering(VkSemaphore waitSemaphore)
   presentInfo.pSwapchains = swapchains;
   presentInfo.pImageIndices = &m_activeImage;
   presentInfo.pResults = nullptr; // Optional
-  auto res = vkQueuePresentKHR(presentQueue, &presentInfo);
+  VkResult res;
+  {
+    auto lk = GetContext().GetGpuConnection().LockQueues();
+    res = vkQueuePresentKHR(presentQueue, &presentInfo);
+  }
   m_activeSemaphore = (m_activeSemaphore + 1u) % m_imageAvailabilitySemaphores.size();
   if (res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR)
   {
@@ -233,8 +264,9 @@ VkAttachmentDescription SurfacedAttachment::BuildDescription() const noexcept
     description.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
     description.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     description.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+    // surface has no stencil
+    description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
   }
   return description;
 }
@@ -34,8 +34,15 @@ public: //IInternalTexture interface
   virtual VkImageView GetImageView() const noexcept override;
   virtual void TransferLayout(details::CommandBuffer & commandBuffer,
                               VkImageLayout layout) override;
+  virtual void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout,
+                              const VkImageSubresourceRange & range) override;
+  virtual void TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                              VkPipelineStageFlags2 stages) override;
   virtual VkImageLayout GetLayout() const noexcept override;
+  virtual VkImageLayout GetLayout(const VkImageSubresourceRange & range) const noexcept override;
   virtual VkImage GetHandle() const noexcept override;
+  virtual VkImageAspectFlags GetAspect() const noexcept override;
+  virtual bool IsSharedWithCompute() const noexcept override;
   virtual VkFormat GetInternalFormat() const noexcept override;
   virtual VkExtent3D GetInternalExtent() const noexcept override;
   virtual uint32_t GetMipLevelsCount() const noexcept override;
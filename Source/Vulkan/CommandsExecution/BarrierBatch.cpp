@@ -0,0 +1,126 @@
+#include "BarrierBatch.hpp"
+
+#include <CommandsExecution/CommandBuffer.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan::details
+{
+void BarrierBatch::AddMemoryBarrier(const VkMemoryBarrier2 & barrier)
+{
+  m_memoryBarriers.push_back(barrier);
+}
+
+void BarrierBatch::AddImageBarrier(const VkImageMemoryBarrier2 & barrier)
+{
+  m_imageBarriers.push_back(barrier);
+}
+
+void BarrierBatch::AddBufferBarrier(const VkBufferMemoryBarrier2 & barrier)
+{
+  m_bufferBarriers.push_back(barrier);
+}
+
+bool BarrierBatch::Empty() const noexcept
+{
+  return m_memoryBarriers.empty() && m_imageBarriers.empty() && m_bufferBarriers.empty();
+}
+
+void BarrierBatch::Clear() noexcept
+{
+  m_memoryBarriers.clear();
+  m_imageBarriers.clear();
+  m_bufferBarriers.clear();
+}
+
+void BarrierBatch::Flush(CommandBuffer & commandBuffer)
+{
+  if (Empty())
+    return;
+
+  if (commandBuffer.GetContext().GetGpuConnection().GetFeatures().synchronization2)
+  {
+    VkDependencyInfo dependency{};
+    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependency.memoryBarrierCount = static_cast<uint32_t>(m_memoryBarriers.size());
+    dependency.pMemoryBarriers = m_memoryBarriers.data();
+    dependency.imageMemoryBarrierCount = static_cast<uint32_t>(m_imageBarriers.size());
+    dependency.pImageMemoryBarriers = m_imageBarriers.data();
+    dependency.bufferMemoryBarrierCount = static_cast<uint32_t>(m_bufferBarriers.size());
+    dependency.pBufferMemoryBarriers = m_bufferBarriers.data();
+    commandBuffer.PushCommand(vkCmdPipelineBarrier2, &dependency);
+    Clear();
+    return;
+  }
+
+  auto && legacy = MakeLegacyBarriers();
+  commandBuffer.PushCommand(
+    vkCmdPipelineBarrier, legacy.srcStages, legacy.dstStages, 0,
+    static_cast<uint32_t>(legacy.memoryBarriers.size()), legacy.memoryBarriers.data(),
+    static_cast<uint32_t>(legacy.bufferBarriers.size()), legacy.bufferBarriers.data(),
+    static_cast<uint32_t>(legacy.imageBarriers.size()), legacy.imageBarriers.data());
+  Clear();
+}
+
+BarrierBatch::LegacyBarriers BarrierBatch::MakeLegacyBarriers() const
+{
+  // legacy barrier has one pair of stage masks for all barriers.
+  // Only flags which exist in Vulkan 1.0 are used by batches, so they can be truncated
+  LegacyBarriers result;
+  VkPipelineStageFlags & srcStages = result.srcStages;
+  VkPipelineStageFlags & dstStages = result.dstStages;
+  auto && memoryBarriers = result.memoryBarriers;
+  memoryBarriers.reserve(m_memoryBarriers.size());
+  for (auto && barrier2 : m_memoryBarriers)
+  {
+    srcStages |= static_cast<VkPipelineStageFlags>(barrier2.srcStageMask);
+    dstStages |= static_cast<VkPipelineStageFlags>(barrier2.dstStageMask);
+    VkMemoryBarrier & barrier = memoryBarriers.emplace_back();
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = static_cast<VkAccessFlags>(barrier2.srcAccessMask);
+    barrier.dstAccessMask = static_cast<VkAccessFlags>(barrier2.dstAccessMask);
+  }
+
+  auto && imageBarriers = result.imageBarriers;
+  imageBarriers.reserve(m_imageBarriers.size());
+  for (auto && barrier2 : m_imageBarriers)
+  {
+    srcStages |= static_cast<VkPipelineStageFlags>(barrier2.srcStageMask);
+    dstStages |= static_cast<VkPipelineStageFlags>(barrier2.dstStageMask);
+    VkImageMemoryBarrier & barrier = imageBarriers.emplace_back();
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = static_cast<VkAccessFlags>(barrier2.srcAccessMask);
+    barrier.dstAccessMask = static_cast<VkAccessFlags>(barrier2.dstAccessMask);
+    barrier.oldLayout = barrier2.oldLayout;
+    barrier.newLayout = barrier2.newLayout;
+    barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+    barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+    barrier.image = barrier2.image;
+    barrier.subresourceRange = barrier2.subresourceRange;
+  }
+
+  auto && bufferBarriers = result.bufferBarriers;
+  bufferBarriers.reserve(m_bufferBarriers.size());
+  for (auto && barrier2 : m_bufferBarriers)
+  {
+    srcStages |= static_cast<VkPipelineStageFlags>(barrier2.srcStageMask);
+    dstStages |= static_cast<VkPipelineStageFlags>(barrier2.dstStageMask);
+    VkBufferMemoryBarrier & barrier = bufferBarriers.emplace_back();
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = static_cast<VkAccessFlags>(barrier2.srcAccessMask);
+    barrier.dstAccessMask = static_cast<VkAccessFlags>(barrier2.dstAccessMask);
+    barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+    barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+    barrier.buffer = barrier2.buffer;
+    barrier.offset = barrier2.offset;
+    barrier.size = barrier2.size;
+  }
+
+  // empty stage masks are valid only with synchronization2
+  if (srcStages == 0)
+    srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+  if (dstStages == 0)
+    dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+  return result;
+}
+
+} // namespace RHI::vulkan::details
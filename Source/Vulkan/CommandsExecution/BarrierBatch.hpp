@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan::details
+{
+struct CommandBuffer;
+
+/// @brief collects memory barriers and records all of them with one command
+struct BarrierBatch final
+{
+  void AddMemoryBarrier(const VkMemoryBarrier2 & barrier);
+  void AddImageBarrier(const VkImageMemoryBarrier2 & barrier);
+  void AddBufferBarrier(const VkBufferMemoryBarrier2 & barrier);
+  bool Empty() const noexcept;
+  void Clear() noexcept;
+
+  /// @brief records collected barriers and clears the batch. vkCmdPipelineBarrier2 is used if
+  /// synchronization2 is enabled, otherwise stages of all barriers are merged
+  void Flush(CommandBuffer & commandBuffer);
+
+  /// @brief arguments of vkCmdPipelineBarrier which has one pair of stage masks for all barriers
+  struct LegacyBarriers
+  {
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags dstStages = 0;
+    std::vector<VkMemoryBarrier> memoryBarriers;
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+    std::vector<VkBufferMemoryBarrier> bufferBarriers;
+  };
+
+  /// @brief converts collected barriers for devices without synchronization2
+  LegacyBarriers MakeLegacyBarriers() const;
+
+  const std::vector<VkMemoryBarrier2> & GetMemoryBarriers() const & noexcept
+  {
+    return m_memoryBarriers;
+  }
+  const std::vector<VkImageMemoryBarrier2> & GetImageBarriers() const & noexcept
+  {
+    return m_imageBarriers;
+  }
+  const std::vector<VkBufferMemoryBarrier2> & GetBufferBarriers() const & noexcept
+  {
+    return m_bufferBarriers;
+  }
+
+private:
+  std::vector<VkMemoryBarrier2> m_memoryBarriers;
+  std::vector<VkImageMemoryBarrier2> m_imageBarriers;
+  std::vector<VkBufferMemoryBarrier2> m_bufferBarriers;
+};
+
+} // namespace RHI::vulkan::details
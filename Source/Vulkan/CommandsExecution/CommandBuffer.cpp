@@ -62,6 +62,8 @@ CommandBuffer::CommandBuffer(CommandBuffer && rhs) noexcept
   std::swap(rhs.m_buffer, m_buffer);
   std::swap(rhs.m_commandsCount, m_commandsCount);
   std::swap(rhs.m_level, m_level);
+  std::swap(rhs.m_stateCache, m_stateCache);
+  std::swap(rhs.m_barriers, m_barriers);
 }
 
 CommandBuffer & CommandBuffer::operator=(CommandBuffer && rhs) noexcept
@@ -73,6 +75,8 @@ CommandBuffer & CommandBuffer::operator=(CommandBuffer && rhs) noexcept
     std::swap(rhs.m_buffer, m_buffer);
     std::swap(rhs.m_commandsCount, m_commandsCount);
     std::swap(rhs.m_level, m_level);
+    std::swap(rhs.m_stateCache, m_stateCache);
+    std::swap(rhs.m_barriers, m_barriers);
   }
   return *this;
 }
@@ -90,18 +94,41 @@ void CommandBuffer::BeginWriting() const
 }
 
 void CommandBuffer::BeginWriting(VkRenderPass renderPass, uint32_t subpassIndex,
-                                 VkFramebuffer framebuffer /*= VK_NULL_HANDLE*/) const
+                                 VkFramebuffer framebuffer /*= VK_NULL_HANDLE*/,
+                                 bool inheritViewportScissor /*= false*/,
+                                 const VkCommandBufferInheritanceRenderingInfo *
+                                   renderingInfo /*= nullptr*/) const
 {
   if (m_level != VK_COMMAND_BUFFER_LEVEL_SECONDARY)
     throw std::invalid_argument("Called writing in primary CommandBuffer, but buffer is secondary");
 
-  assert(!!renderPass);
+  assert(!!renderPass || !!renderingInfo);
   VkCommandBufferInheritanceInfo inheritanceInfo{};
   inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
   inheritanceInfo.renderPass = renderPass;
   inheritanceInfo.framebuffer = framebuffer;
   inheritanceInfo.subpass = subpassIndex;
 
+  // only depth range is taken from here, viewport itself is set in primary buffer
+  const VkViewport viewportDepth{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  VkCommandBufferInheritanceViewportScissorInfoNV viewportInheritance{};
+  viewportInheritance.sType =
+    VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_VIEWPORT_SCISSOR_INFO_NV;
+  viewportInheritance.viewportScissor2D = VK_TRUE;
+  viewportInheritance.viewportDepthCount = 1;
+  viewportInheritance.pViewportDepths = &viewportDepth;
+  if (inheritViewportScissor)
+    inheritanceInfo.pNext = &viewportInheritance;
+
+  // without VkRenderPass secondary buffer must know formats of attachments
+  VkCommandBufferInheritanceRenderingInfo renderingInheritance{};
+  if (renderingInfo)
+  {
+    renderingInheritance = *renderingInfo;
+    renderingInheritance.pNext = inheritanceInfo.pNext;
+    inheritanceInfo.pNext = &renderingInheritance;
+  }
+
   VkCommandBufferBeginInfo beginInfo{};
   beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
   beginInfo.flags =
@@ -125,6 +152,8 @@ void CommandBuffer::Reset()
 {
   vkResetCommandBuffer(m_buffer, 0);
   m_commandsCount = 0;
+  m_stateCache.Reset();
+  m_barriers.Clear();
 }
 
 void CommandBuffer::AddCommands(const std::vector<VkCommandBuffer> & buffers)
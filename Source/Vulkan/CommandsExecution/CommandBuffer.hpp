@@ -1,6 +1,8 @@
 #pragma once
 #include <numeric>
 
+#include <CommandsExecution/BarrierBatch.hpp>
+#include <CommandsExecution/CommandStateCache.hpp>
 #include <Private/OwnedBy.hpp>
 #include <RHI.hpp>
 #include <vulkan/vulkan.hpp>
@@ -22,8 +24,12 @@ struct CommandBuffer : public OwnedBy<Context>
   MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
 
   void BeginWriting() const;
+  /// @param inheritViewportScissor - viewport and scissor are set by primary buffer
+  /// @param renderingInfo - formats of attachments for dynamic rendering (renderPass is null)
   void BeginWriting(VkRenderPass renderPass, uint32_t subpassIndex,
-                    VkFramebuffer framebuffer = VK_NULL_HANDLE) const;
+                    VkFramebuffer framebuffer = VK_NULL_HANDLE,
+                    bool inheritViewportScissor = false,
+                    const VkCommandBufferInheritanceRenderingInfo * renderingInfo = nullptr) const;
   void EndWriting() const;
   virtual void Reset();
   void AddCommands(const std::vector<VkCommandBuffer> & buffers);
@@ -37,6 +43,14 @@ struct CommandBuffer : public OwnedBy<Context>
 
   bool IsEmpty() const noexcept { return m_commandsCount == 0; }
 
+  /// @brief state set by recorded commands. It's forgotten on Reset
+  CommandStateCache & GetStateCache() & noexcept { return m_stateCache; }
+  const CommandStateCache & GetStateCache() const & noexcept { return m_stateCache; }
+
+  /// @brief barriers which are recorded with one command on FlushBarriers
+  BarrierBatch & GetBarriers() & noexcept { return m_barriers; }
+  void FlushBarriers() { m_barriers.Flush(*this); }
+
 public:
   VkCommandBuffer GetHandle() const noexcept { return m_buffer; }
 
@@ -45,6 +59,8 @@ private:
   VkCommandPool m_pool = VK_NULL_HANDLE;
   VkCommandBuffer m_buffer = VK_NULL_HANDLE;
   size_t m_commandsCount = 0;
+  CommandStateCache m_stateCache;
+  BarrierBatch m_barriers;
 };
 
 } // namespace RHI::vulkan::details
@@ -0,0 +1,153 @@
+#include "CommandStateCache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace RHI::vulkan::details
+{
+namespace
+{
+template<typename T>
+bool IsEqual(const T & lhs, const T & rhs) noexcept
+{
+  return lhs == rhs;
+}
+
+bool IsEqual(const VkViewport & lhs, const VkViewport & rhs) noexcept
+{
+  return lhs.x == rhs.x && lhs.y == rhs.y && lhs.width == rhs.width &&
+         lhs.height == rhs.height && lhs.minDepth == rhs.minDepth && lhs.maxDepth == rhs.maxDepth;
+}
+
+bool IsEqual(const VkRect2D & lhs, const VkRect2D & rhs) noexcept
+{
+  return lhs.offset.x == rhs.offset.x && lhs.offset.y == rhs.offset.y &&
+         lhs.extent.width == rhs.extent.width && lhs.extent.height == rhs.extent.height;
+}
+} // namespace
+
+void CommandStateCache::Reset() noexcept
+{
+  m_viewport.reset();
+  m_scissor.reset();
+  m_indexBuffer.reset();
+  m_vertexBuffers.clear();
+  m_pushConstants.clear();
+  m_dynamicStates.clear();
+  m_elidedCommandsCount = 0;
+}
+
+template<typename T>
+bool CommandStateCache::UpdateState(std::optional<T> & cached, const T & value)
+{
+  if (cached.has_value() && IsEqual(*cached, value))
+  {
+    m_elidedCommandsCount++;
+    return false;
+  }
+  cached = value;
+  return true;
+}
+
+bool CommandStateCache::UpdateViewport(const VkViewport & viewport)
+{
+  return UpdateState(m_viewport, viewport);
+}
+
+bool CommandStateCache::UpdateScissor(const VkRect2D & scissor)
+{
+  return UpdateState(m_scissor, scissor);
+}
+
+bool CommandStateCache::UpdateVertexBuffers(uint32_t firstBinding,
+                                            std::span<const VkBuffer> buffers,
+                                            std::span<const VkDeviceSize> offsets)
+{
+  assert(buffers.size() == offsets.size());
+  bool changed = false;
+  for (uint32_t i = 0; i < buffers.size() && !changed; ++i)
+  {
+    auto it = m_vertexBuffers.find(firstBinding + i);
+    changed = it == m_vertexBuffers.end() || it->second.buffer != buffers[i] ||
+              it->second.offset != offsets[i];
+  }
+
+  if (!changed)
+  {
+    m_elidedCommandsCount++;
+    return false;
+  }
+
+  for (uint32_t i = 0; i < buffers.size(); ++i)
+    m_vertexBuffers[firstBinding + i] = VertexBufferState{buffers[i], offsets[i]};
+  return true;
+}
+
+bool CommandStateCache::UpdateIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type)
+{
+  IndexBufferState state{};
+  state.buffer = buffer;
+  state.offset = offset;
+  state.type = type;
+  return UpdateState(m_indexBuffer, state);
+}
+
+bool CommandStateCache::UpdatePushConstants(VkShaderStageFlags stages, uint32_t offset,
+                                            uint32_t size, const void * data)
+{
+  const auto * bytes = reinterpret_cast<const uint8_t *>(data);
+  const uint32_t end = offset + size;
+
+  // every stage has own copy of push constants, so compare them per stage
+  bool changed = false;
+  for (VkShaderStageFlags stage = 1; stage != 0 && stage <= stages && !changed; stage <<= 1)
+  {
+    if ((stages & stage) == 0)
+      continue;
+    auto it = m_pushConstants.find(stage);
+    if (it == m_pushConstants.end() || it->second.data.size() < end)
+    {
+      changed = true;
+      break;
+    }
+    auto && cached = it->second;
+    for (uint32_t i = offset; i < end && !changed; ++i)
+      changed = !cached.known[i] || cached.data[i] != bytes[i - offset];
+  }
+
+  if (!changed)
+  {
+    m_elidedCommandsCount++;
+    return false;
+  }
+
+  for (VkShaderStageFlags stage = 1; stage != 0 && stage <= stages; stage <<= 1)
+  {
+    if ((stages & stage) == 0)
+      continue;
+    auto && cached = m_pushConstants[stage];
+    if (cached.data.size() < end)
+    {
+      cached.data.resize(end, 0);
+      cached.known.resize(end, false);
+    }
+    std::memcpy(cached.data.data() + offset, bytes, size);
+    std::fill(cached.known.begin() + offset, cached.known.begin() + end, true);
+  }
+  return true;
+}
+
+bool CommandStateCache::UpdateDynamicState(VkDynamicState state, uint64_t packedValue)
+{
+  auto [it, inserted] = m_dynamicStates.try_emplace(state, packedValue);
+  if (!inserted && it->second == packedValue)
+  {
+    m_elidedCommandsCount++;
+    return false;
+  }
+  it->second = packedValue;
+  return true;
+}
+
+} // namespace RHI::vulkan::details
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan::details
+{
+
+/// @brief shadow copy of state set in command buffer. Used to drop commands which set the same
+/// state again. Every Update* method returns true if command must be recorded
+struct CommandStateCache final
+{
+  /// @brief forgets all tracked state (state is undefined at the beginning of command buffer)
+  void Reset() noexcept;
+
+  bool UpdateViewport(const VkViewport & viewport);
+  bool UpdateScissor(const VkRect2D & scissor);
+  bool UpdateVertexBuffers(uint32_t firstBinding, std::span<const VkBuffer> buffers,
+                           std::span<const VkDeviceSize> offsets);
+  bool UpdateIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type);
+  bool UpdatePushConstants(VkShaderStageFlags stages, uint32_t offset, uint32_t size,
+                           const void * data);
+  /// @brief tracks dynamic state which arguments can be packed in one value
+  bool UpdateDynamicState(VkDynamicState state, uint64_t packedValue);
+
+  /// @brief count of commands dropped since last Reset
+  size_t GetElidedCommandsCount() const noexcept { return m_elidedCommandsCount; }
+
+private:
+  struct VertexBufferState
+  {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+  };
+
+  struct IndexBufferState
+  {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkIndexType type = VK_INDEX_TYPE_UINT16;
+
+    bool operator==(const IndexBufferState & rhs) const noexcept = default;
+  };
+
+  /// @brief push constant bytes of one shader stage. Unknown bytes are never equal
+  struct PushConstantBytes
+  {
+    std::vector<uint8_t> data;
+    std::vector<bool> known;
+  };
+
+  /// @brief returns false and counts elided command if state is equal to cached one
+  template<typename T>
+  bool UpdateState(std::optional<T> & cached, const T & value);
+
+private:
+  std::optional<VkViewport> m_viewport;
+  std::optional<VkRect2D> m_scissor;
+  std::optional<IndexBufferState> m_indexBuffer;
+  std::unordered_map<uint32_t, VertexBufferState> m_vertexBuffers;
+  std::unordered_map<VkShaderStageFlags, PushConstantBytes> m_pushConstants;
+  std::unordered_map<VkDynamicState, uint64_t> m_dynamicStates;
+  size_t m_elidedCommandsCount = 0;
+};
+
+} // namespace RHI::vulkan::details
@@ -0,0 +1,84 @@
+#include "FrameFences.hpp"
+
+#include <algorithm>
+
+#include <Utils/FenceBuilder.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan::details
+{
+FrameFences::FrameFences(Context & ctx)
+  : OwnedBy<Context>(ctx)
+{
+}
+
+FrameFences::~FrameFences()
+{
+  for (auto && mark : m_marks)
+    m_freeFences.insert(m_freeFences.end(), mark.fences.begin(), mark.fences.end());
+  for (auto && fence : m_freeFences)
+    GetContext().GetGarbageCollector().PushVkObjectToDestroy(fence, nullptr);
+}
+
+FrameFences::FrameIndex FrameFences::SignalFrameEnd()
+{
+  // per-frame resources are used by passes on graphics queues and compute queue
+  auto && gpu = GetContext().GetGpuConnection();
+  std::vector<VkQueue> queues;
+  for (uint32_t i = 0; i < gpu.GetGraphicsQueuesCount(); ++i)
+    queues.push_back(gpu.GetGraphicsQueue(i));
+  if (auto [_, computeQueue] = gpu.GetQueue(QueueType::Compute);
+      std::find(queues.begin(), queues.end(), computeQueue) == queues.end())
+    queues.push_back(computeQueue);
+
+  std::lock_guard lk{m_lock};
+  auto && mark = m_marks.emplace_back();
+  mark.frame = ++m_lastFrame;
+  auto queuesLock = gpu.LockQueues();
+  for (VkQueue queue : queues)
+  {
+    if (m_freeFences.empty())
+      m_freeFences.push_back(utils::FenceBuilder().Make(gpu.GetDevice()));
+    mark.fences.push_back(m_freeFences.back());
+    m_freeFences.pop_back();
+    // empty submit signals fence when all previously submitted work is completed
+    if (vkQueueSubmit(queue, 0, nullptr, mark.fences.back()) != VK_SUCCESS)
+      throw std::runtime_error("Failed to submit fence of frame end");
+  }
+  return mark.frame;
+}
+
+bool FrameFences::IsCompleted(FrameIndex frame) const noexcept
+{
+  std::lock_guard lk{m_lock};
+  PopCompletedMarks(frame, false /*wait*/);
+  return frame <= m_completedFrame;
+}
+
+void FrameFences::WaitForCompleted(FrameIndex frame) const noexcept
+{
+  std::lock_guard lk{m_lock};
+  PopCompletedMarks(frame, true /*wait*/);
+}
+
+void FrameFences::PopCompletedMarks(FrameIndex frame, bool wait) const noexcept
+{
+  const VkDevice device = GetContext().GetGpuConnection().GetDevice();
+  while (!m_marks.empty() && m_marks.front().frame <= frame)
+  {
+    auto && mark = m_marks.front();
+    const uint32_t fencesCount = static_cast<uint32_t>(mark.fences.size());
+    // frames are completed in order of their ends
+    const VkResult status =
+      vkWaitForFences(device, fencesCount, mark.fences.data(), VK_TRUE, wait ? UINT64_MAX : 0);
+    if (status != VK_SUCCESS)
+      break;
+
+    vkResetFences(device, fencesCount, mark.fences.data());
+    m_freeFences.insert(m_freeFences.end(), mark.fences.begin(), mark.fences.end());
+    m_completedFrame = mark.frame;
+    m_marks.pop_front();
+  }
+}
+
+} // namespace RHI::vulkan::details
@@ -0,0 +1,59 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan::details
+{
+
+/// @brief marks ends of frames on queues which execute per-frame work (graphics queues and compute
+/// queue). Each mark is a group of fences signaled by empty submits, so resources released in
+/// frame are reused when GPU completes all work submitted before the end of that frame
+struct FrameFences final : public OwnedBy<Context>
+{
+  using FrameIndex = uint64_t;
+
+  explicit FrameFences(Context & ctx);
+  virtual ~FrameFences() override;
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(FrameFences);
+
+public:
+  /// @brief signals fences after work submitted to queues. It's called when frame is ended
+  /// @return index of ended frame, indices start from 1
+  FrameIndex SignalFrameEnd();
+  /// @brief true if GPU has completed work submitted before the end of frame. It doesn't wait
+  bool IsCompleted(FrameIndex frame) const noexcept;
+  /// @brief waits while GPU completes work submitted before the end of frame
+  void WaitForCompleted(FrameIndex frame) const noexcept;
+
+private:
+  struct FrameMark
+  {
+    FrameIndex frame = 0;
+    std::vector<VkFence> fences; ///< fence of each queue
+  };
+
+private:
+  /// @brief pops marks of completed frames up to frame. If wait is false, only signaled marks
+  /// are popped
+  void PopCompletedMarks(FrameIndex frame, bool wait) const noexcept;
+
+private:
+  mutable std::mutex m_lock;
+  mutable std::deque<FrameMark> m_marks;
+  mutable std::vector<VkFence> m_freeFences; ///< unsignaled fences for next marks
+  mutable FrameIndex m_completedFrame = 0;
+  FrameIndex m_lastFrame = 0;
+};
+
+} // namespace RHI::vulkan::details
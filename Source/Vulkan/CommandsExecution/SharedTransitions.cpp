@@ -0,0 +1,49 @@
+#include "SharedTransitions.hpp"
+
+#include <Utils/SemaphoreBuilder.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan::details
+{
+SharedTransitions::SharedTransitions(Context & ctx)
+  : OwnedBy<Context>(ctx)
+  , m_submitter(ctx, QueueType::Graphics, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT)
+{
+}
+
+SharedTransitions::~SharedTransitions()
+{
+  for (VkSemaphore semaphore : m_semaphores)
+    GetContext().GetGarbageCollector().PushVkObjectToDestroy(semaphore, nullptr);
+}
+
+CommandBuffer & SharedTransitions::BeginWriting()
+{
+  m_submitter.WaitForSubmitCompleted();
+  m_submitter.BeginWriting();
+  return m_submitter;
+}
+
+VkSemaphore SharedTransitions::GetSemaphore(uint32_t queueIndex)
+{
+  if (queueIndex == 0)
+    return VK_NULL_HANDLE;
+  while (m_semaphores.size() < queueIndex)
+    m_semaphores.push_back(
+      utils::SemaphoreBuilder().Make(GetContext().GetGpuConnection().GetDevice()));
+  return m_semaphores[queueIndex - 1];
+}
+
+AsyncTask * SharedTransitions::Submit(SubmitBatch & batch, uint32_t queuesCount)
+{
+  std::vector<VkSemaphore> signals;
+  for (uint32_t i = 1; i < queuesCount; ++i)
+    signals.push_back(GetSemaphore(i));
+
+  m_submitter.FlushBarriers();
+  m_submitter.EndWriting();
+  m_submitter.SetQueueIndex(0);
+  return m_submitter.Submit(batch, true /*waitPrevSubmitOnGPU*/, {}, {}, std::move(signals));
+}
+
+} // namespace RHI::vulkan::details
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+
+#include <CommandsExecution/Submitter.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan::details
+{
+
+/// @brief layout transitions of images used by frames which are rendered on several graphics
+/// queues. Layouts are tracked on CPU, so one frame records the transition and another one relies
+/// on it. Transitions are submitted on the first graphics queue before frames and other queues
+/// wait for them
+struct SharedTransitions final : public OwnedBy<Context>
+{
+  explicit SharedTransitions(Context & ctx);
+  virtual ~SharedTransitions() override;
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(SharedTransitions);
+
+public:
+  /// @brief waits for previous submit and begins recording of transitions
+  CommandBuffer & BeginWriting();
+  /// @brief semaphore waited by the first frame on the queue. Frames on first queue don't need it
+  VkSemaphore GetSemaphore(uint32_t queueIndex);
+  /// @brief adds submit of transitions to batch, it signals semaphores of queues [1, queuesCount)
+  AsyncTask * Submit(SubmitBatch & batch, uint32_t queuesCount);
+
+private:
+  Submitter m_submitter;
+  std::vector<VkSemaphore> m_semaphores; ///< semaphores for queues starting from second one
+};
+
+} // namespace RHI::vulkan::details
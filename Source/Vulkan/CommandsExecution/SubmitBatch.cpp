@@ -0,0 +1,154 @@
+#include "SubmitBatch.hpp"
+
+#include <algorithm>
+
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan::details
+{
+void SubmitBatch::AddSubmit(VkQueue queue, VkCommandBuffer commandBuffer,
+                            std::vector<SemaphoreWait> && waitSemaphores,
+                            std::vector<VkSemaphore> && signalSemaphores, VkFence fence)
+{
+  m_submits.push_back(
+    {queue, commandBuffer, std::move(waitSemaphores), std::move(signalSemaphores), fence});
+}
+
+void SubmitBatch::Append(SubmitBatch && other)
+{
+  m_submits.insert(m_submits.end(), std::make_move_iterator(other.m_submits.begin()),
+                   std::make_move_iterator(other.m_submits.end()));
+  other.Clear();
+}
+
+bool SubmitBatch::Empty() const noexcept
+{
+  return m_submits.empty();
+}
+
+void SubmitBatch::Clear() noexcept
+{
+  m_submits.clear();
+}
+
+void SubmitBatch::Flush(const Context & ctx)
+{
+  const bool useSync2 = ctx.GetGpuConnection().GetFeatures().synchronization2;
+  std::vector<VkQueue> queues;
+  for (auto && submit : m_submits)
+  {
+    if (std::find(queues.begin(), queues.end(), submit.queue) == queues.end())
+      queues.push_back(submit.queue);
+  }
+
+  auto lk = ctx.GetGpuConnection().LockQueues();
+  for (VkQueue queue : queues)
+  {
+    QueueSubmits submits;
+    for (auto && submit : m_submits)
+    {
+      if (submit.queue == queue)
+        submits.push_back(&submit);
+    }
+
+    // only one fence is signaled by call, it's the fence of the last submit
+    const VkFence fence = submits.back()->fence;
+    if (useSync2)
+      SubmitToQueue2(queue, submits, fence);
+    else
+      SubmitToQueue(queue, submits, fence);
+
+    // empty submit signals fence when all previously submitted work is completed
+    for (auto it = submits.begin(); it != std::prev(submits.end()); ++it)
+    {
+      if ((*it)->fence && vkQueueSubmit(queue, 0, nullptr, (*it)->fence) != VK_SUCCESS)
+        throw std::runtime_error("failed to submit fence of command buffer!");
+    }
+  }
+  Clear();
+}
+
+void SubmitBatch::SubmitToQueue(VkQueue queue, const QueueSubmits & submits, VkFence fence)
+{
+  std::vector<std::vector<VkSemaphore>> waitSemaphores;
+  std::vector<std::vector<VkPipelineStageFlags>> waitStages;
+  std::vector<VkSubmitInfo> infos;
+  waitSemaphores.reserve(submits.size());
+  waitStages.reserve(submits.size());
+  infos.reserve(submits.size());
+  for (const SubmitInfo * submit : submits)
+  {
+    auto && semaphores = waitSemaphores.emplace_back();
+    auto && stages = waitStages.emplace_back();
+    for (auto && wait : submit->waitSemaphores)
+    {
+      semaphores.push_back(wait.semaphore);
+      stages.push_back(wait.stages);
+    }
+    VkSubmitInfo & info = infos.emplace_back();
+    info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    info.waitSemaphoreCount = static_cast<uint32_t>(semaphores.size());
+    info.pWaitSemaphores = semaphores.data();
+    info.pWaitDstStageMask = stages.data();
+    info.commandBufferCount = 1;
+    info.pCommandBuffers = &submit->commandBuffer;
+    info.signalSemaphoreCount = static_cast<uint32_t>(submit->signalSemaphores.size());
+    info.pSignalSemaphores = submit->signalSemaphores.data();
+  }
+
+  auto res = vkQueueSubmit(queue, static_cast<uint32_t>(infos.size()), infos.data(), fence);
+  if (res != VK_SUCCESS)
+    throw std::runtime_error("failed to submit command buffer!");
+}
+
+void SubmitBatch::SubmitToQueue2(VkQueue queue, const QueueSubmits & submits, VkFence fence)
+{
+  std::vector<std::vector<VkSemaphoreSubmitInfo>> waitInfos;
+  std::vector<VkCommandBufferSubmitInfo> bufferInfos;
+  std::vector<std::vector<VkSemaphoreSubmitInfo>> signalInfos;
+  std::vector<VkSubmitInfo2> infos;
+  waitInfos.reserve(submits.size());
+  bufferInfos.reserve(submits.size());
+  signalInfos.reserve(submits.size());
+  infos.reserve(submits.size());
+  for (const SubmitInfo * submit : submits)
+  {
+    // stages of Vulkan 1.0 have the same values in VkPipelineStageFlags2
+    auto && waits = waitInfos.emplace_back();
+    for (auto && semaphoreWait : submit->waitSemaphores)
+    {
+      VkSemaphoreSubmitInfo & wait = waits.emplace_back();
+      wait.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+      wait.semaphore = semaphoreWait.semaphore;
+      wait.stageMask = static_cast<VkPipelineStageFlags2>(semaphoreWait.stages);
+    }
+
+    VkCommandBufferSubmitInfo & buffer = bufferInfos.emplace_back();
+    buffer.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    buffer.commandBuffer = submit->commandBuffer;
+
+    auto && signals = signalInfos.emplace_back();
+    for (VkSemaphore semaphore : submit->signalSemaphores)
+    {
+      VkSemaphoreSubmitInfo & signal = signals.emplace_back();
+      signal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+      signal.semaphore = semaphore;
+      signal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    }
+
+    VkSubmitInfo2 & info = infos.emplace_back();
+    info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    info.waitSemaphoreInfoCount = static_cast<uint32_t>(waits.size());
+    info.pWaitSemaphoreInfos = waits.data();
+    info.commandBufferInfoCount = 1;
+    info.pCommandBufferInfos = &buffer;
+    info.signalSemaphoreInfoCount = static_cast<uint32_t>(signals.size());
+    info.pSignalSemaphoreInfos = signals.data();
+  }
+
+  auto res = vkQueueSubmit2(queue, static_cast<uint32_t>(infos.size()), infos.data(), fence);
+  if (res != VK_SUCCESS)
+    throw std::runtime_error("failed to submit command buffer!");
+}
+
+} // namespace RHI::vulkan::details
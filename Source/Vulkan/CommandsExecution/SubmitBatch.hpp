@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan::details
+{
+/// @brief semaphore which is waited before the stages of submitted commands
+struct SemaphoreWait
+{
+  VkSemaphore semaphore;
+  VkPipelineStageFlags stages;
+};
+
+/// @brief collects submits of command buffers and sends them with one call per queue
+struct SubmitBatch final
+{
+  void AddSubmit(VkQueue queue, VkCommandBuffer commandBuffer,
+                 std::vector<SemaphoreWait> && waitSemaphores,
+                 std::vector<VkSemaphore> && signalSemaphores, VkFence fence);
+  /// @brief moves submits of other batch to the end of this one
+  void Append(SubmitBatch && other);
+  bool Empty() const noexcept;
+  void Clear() noexcept;
+
+  /// @brief submits collected command buffers in order of adding and clears the batch.
+  /// vkQueueSubmit2 is used if synchronization2 is enabled, otherwise vkQueueSubmit
+  void Flush(const Context & ctx);
+
+private:
+  struct SubmitInfo
+  {
+    VkQueue queue;
+    VkCommandBuffer commandBuffer;
+    std::vector<SemaphoreWait> waitSemaphores;
+    std::vector<VkSemaphore> signalSemaphores;
+    VkFence fence;
+  };
+
+  using QueueSubmits = std::vector<const SubmitInfo *>;
+  static void SubmitToQueue(VkQueue queue, const QueueSubmits & submits, VkFence fence);
+  static void SubmitToQueue2(VkQueue queue, const QueueSubmits & submits, VkFence fence);
+
+private:
+  std::vector<SubmitInfo> m_submits;
+};
+
+} // namespace RHI::vulkan::details
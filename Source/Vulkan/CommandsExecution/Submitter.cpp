@@ -20,6 +20,7 @@ Submitter::Submitter(Submitter && rhs) noexcept
 {
   std::swap(m_waitStages, rhs.m_waitStages);
   std::swap(m_queueType, rhs.m_queueType);
+  std::swap(m_queueIndex, rhs.m_queueIndex);
   std::swap(m_isFirstSubmit, rhs.m_isFirstSubmit);
 }
 
@@ -32,6 +33,7 @@ Submitter & Submitter::operator=(Submitter && rhs) noexcept
     std::swap(m_newBarrier, rhs.m_newBarrier);
     std::swap(m_oldBarrier, rhs.m_oldBarrier);
     std::swap(m_queueType, rhs.m_queueType);
+    std::swap(m_queueIndex, rhs.m_queueIndex);
     std::swap(m_isFirstSubmit, rhs.m_isFirstSubmit);
   }
   return *this;
@@ -39,9 +41,20 @@ Submitter & Submitter::operator=(Submitter && rhs) noexcept
 
 AsyncTask * Submitter::Submit(bool waitPrevSubmitOnGPU, std::vector<VkSemaphore> && waitSemaphores)
 {
-  const VkSemaphore signalSem = m_newBarrier.GetSemaphore();
-  const VkCommandBuffer buffer = GetHandle();
-  auto [_, queue] = GetContext().GetGpuConnection().GetQueue(m_queueType);
+  SubmitBatch batch;
+  AsyncTask * result = Submit(batch, waitPrevSubmitOnGPU, std::move(waitSemaphores));
+  batch.Flush(GetContext());
+  return result;
+}
+
+AsyncTask * Submitter::Submit(SubmitBatch & batch, bool waitPrevSubmitOnGPU,
+                              std::vector<VkSemaphore> && waitSemaphores,
+                              std::vector<SemaphoreWait> && extraWaits /* = {}*/,
+                              std::vector<VkSemaphore> && extraSignals /* = {}*/)
+{
+  auto && device = GetContext().GetGpuConnection();
+  const VkQueue queue = m_queueType == QueueType::Graphics ? device.GetGraphicsQueue(m_queueIndex)
+                                                           : device.GetQueue(m_queueType).second;
 
   if (!m_isFirstSubmit && waitPrevSubmitOnGPU)
     waitSemaphores.push_back(m_oldBarrier.GetSemaphore());
@@ -49,21 +62,14 @@ AsyncTask * Submitter::Submit(bool waitPrevSubmitOnGPU, std::vector<VkSemaphore>
   assert(std::all_of(waitSemaphores.begin(), waitSemaphores.end(),
                      [](VkSemaphore sem) { return !!sem; }));
 
-  std::vector<VkPipelineStageFlags> waitStages(waitSemaphores.size(), m_waitStages);
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
-  submitInfo.pWaitSemaphores = reinterpret_cast<const VkSemaphore *>(waitSemaphores.data());
-  submitInfo.pWaitDstStageMask = waitStages.data();
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &buffer;
-  submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = &signalSem;
+  std::vector<SemaphoreWait> waits = std::move(extraWaits);
+  for (VkSemaphore semaphore : waitSemaphores)
+    waits.push_back({semaphore, m_waitStages});
+  extraSignals.push_back(m_newBarrier.GetSemaphore());
 
   m_newBarrier.StartTask();
-  auto res = vkQueueSubmit(queue, 1, &submitInfo, m_newBarrier.GetFence());
-  if (res != VK_SUCCESS)
-    throw std::runtime_error("failed to submit command buffer!");
+  batch.AddSubmit(queue, GetHandle(), std::move(waits), std::move(extraSignals),
+                  m_newBarrier.GetFence());
   std::swap(m_oldBarrier, m_newBarrier);
   m_isFirstSubmit = false;
   waitSemaphores.clear();
@@ -2,6 +2,7 @@
 
 #include <CommandsExecution/AsyncTask.hpp>
 #include <CommandsExecution/CommandBuffer.hpp>
+#include <CommandsExecution/SubmitBatch.hpp>
 #include <Device.hpp>
 #include <RHI.hpp>
 #include <vulkan/vulkan.hpp>
@@ -17,11 +18,21 @@ struct Submitter : public CommandBuffer
   Submitter & operator=(Submitter && rhs) noexcept;
 
   AsyncTask * Submit(bool waitPrevSubmitOnGPU, std::vector<VkSemaphore> && waitSemaphores);
+  /// @brief adds submit to batch. Commands are sent to queue when batch is flushed
+  /// @param extraWaits - semaphores waited before their own stages
+  /// @param extraSignals - semaphores signaled together with semaphore of returned task
+  AsyncTask * Submit(SubmitBatch & batch, bool waitPrevSubmitOnGPU,
+                     std::vector<VkSemaphore> && waitSemaphores,
+                     std::vector<SemaphoreWait> && extraWaits = {},
+                     std::vector<VkSemaphore> && extraSignals = {});
   void WaitForSubmitCompleted();
+  /// @brief selects one of graphics queues (see Device::GetGraphicsQueue)
+  void SetQueueIndex(uint32_t index) noexcept { m_queueIndex = index; }
 
 protected:
   VkPipelineStageFlags m_waitStages;
   QueueType m_queueType;
+  uint32_t m_queueIndex = 0;
 
   AsyncTask m_oldBarrier;
   AsyncTask m_newBarrier;
@@ -0,0 +1,153 @@
+#include "ComputeConfiguration.hpp"
+
+#include <ComputePass/ComputePass.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan
+{
+
+ComputeConfiguration::ComputeConfiguration(Context & ctx, ComputePass & owner)
+  : OwnedBy<Context>(ctx)
+  , OwnedBy<ComputePass>(owner)
+  , m_descriptorsLayout(ctx, owner)
+{
+}
+
+ComputeConfiguration::~ComputeConfiguration()
+{
+  GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pipeline, nullptr);
+  GetContext().GetLayoutCache().ReleasePipelineLayout(m_pipelineLayout);
+}
+
+void ComputeConfiguration::AttachShader(const SpirV & spirv)
+{
+  m_pipelineBuilder.AttachShader(spirv);
+  m_invalidPipeline = true;
+}
+
+void ComputeConfiguration::DefinePushConstant(uint32_t size, uint32_t offset)
+{
+  VkPushConstantRange newPushConstantRange{};
+  newPushConstantRange.offset = offset;
+  newPushConstantRange.size = size;
+  newPushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  utils::DefinePushConstantRange(
+    m_pushConstantRanges, newPushConstantRange,
+    GetContext().GetGpuConnection().GetGpuProperties().limits.maxPushConstantsSize);
+  m_invalidPipelineLayout = true;
+}
+
+IBufferUniformDescriptor * ComputeConfiguration::DeclareUniform(LayoutIndex index)
+{
+  IBufferUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                                 ShaderType::Compute, 1, &result);
+  return result;
+}
+
+ISamplerUniformDescriptor * ComputeConfiguration::DeclareSampler(LayoutIndex index)
+{
+  ISamplerUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareSamplerUniformsArray(index, ShaderType::Compute, 1, &result);
+  return result;
+}
+
+void ComputeConfiguration::DeclareUniformsArray(LayoutIndex index, uint32_t size,
+                                                IBufferUniformDescriptor * outArray[])
+{
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                                 ShaderType::Compute, size, outArray);
+}
+
+void ComputeConfiguration::DeclareSamplersArray(LayoutIndex index, uint32_t size,
+                                                ISamplerUniformDescriptor * outArray[])
+{
+  m_descriptorsLayout.DeclareSamplerUniformsArray(index, ShaderType::Compute, size, outArray);
+}
+
+IBufferUniformDescriptor * ComputeConfiguration::DeclareStorageBuffer(LayoutIndex index)
+{
+  IBufferUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                 ShaderType::Compute, 1, &result);
+  return result;
+}
+
+IStorageImageDescriptor * ComputeConfiguration::DeclareStorageImage(LayoutIndex index)
+{
+  IStorageImageDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareStorageImagesArray(index, ShaderType::Compute, 1, &result);
+  return result;
+}
+
+ISamplerUniformDescriptor * ComputeConfiguration::DeclareImmutableSampler(LayoutIndex index)
+{
+  ISamplerUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareSamplerUniformsArray(index, ShaderType::Compute, 1, &result, true);
+  return result;
+}
+
+void ComputeConfiguration::UseBindlessTextures(uint32_t set)
+{
+  m_descriptorsLayout.UseBindlessTable(set);
+  m_invalidPipelineLayout = true;
+}
+
+void ComputeConfiguration::Invalidate()
+{
+  // pipeline layout refers to set layouts, so it's rebuilt with them
+  if (m_descriptorsLayout.Invalidate())
+    m_invalidPipelineLayout = true;
+
+  if (m_invalidPipelineLayout || !m_pipelineLayout)
+  {
+    m_pipelineLayoutBuilder.Reset();
+    m_pipelineLayoutBuilder.SetDescriptorSetLayouts(m_descriptorsLayout.GetHandles());
+    for (auto && range : m_pushConstantRanges)
+      m_pipelineLayoutBuilder.AddPushConstantRange(range);
+    // identical pipeline layouts are shared, so pipeline is rebuilt only if layout is changed
+    auto && layoutCache = GetContext().GetLayoutCache();
+    auto new_layout = layoutCache.AcquirePipelineLayout(m_pipelineLayoutBuilder);
+    layoutCache.ReleasePipelineLayout(m_pipelineLayout);
+    if (new_layout != m_pipelineLayout)
+      m_invalidPipeline = true;
+    m_pipelineLayout = new_layout;
+    m_invalidPipelineLayout = false;
+  }
+
+  if ((m_invalidPipeline || !m_pipeline) && m_pipelineBuilder.HasShader())
+  {
+    auto new_pipeline =
+      m_pipelineBuilder.Make(GetContext().GetGpuConnection().GetDevice(), m_pipelineLayout);
+    GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pipeline, nullptr);
+    m_pipeline = new_pipeline;
+    m_invalidPipeline = false;
+    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "Compute VkPipeline has been rebuilt");
+  }
+}
+
+void ComputeConfiguration::SetInvalid()
+{
+  m_descriptorsLayout.SetInvalid();
+  m_invalidPipeline = true;
+  m_invalidPipelineLayout = true;
+}
+
+const DescriptorBufferLayout & ComputeConfiguration::GetDescriptorsLayout() const & noexcept
+{
+  return m_descriptorsLayout;
+}
+
+void ComputeConfiguration::BindToCommandBuffer(const VkCommandBuffer & buffer)
+{
+  assert(!!m_pipeline);
+  vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+}
+
+void ComputeConfiguration::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer)
+{
+  m_descriptorsLayout.TransitLayoutForUsedImages(commandBuffer,
+                                                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+}
+
+} // namespace RHI::vulkan
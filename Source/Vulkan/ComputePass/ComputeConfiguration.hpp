@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Descriptors/DescriptorBufferLayout.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <Utils/ComputePipelineBuilder.hpp>
+#include <Utils/PipelineLayoutBuilder.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+struct ComputePass;
+} // namespace RHI::vulkan
+
+namespace RHI::vulkan
+{
+
+struct ComputeConfiguration final : public IComputeConfiguration,
+                                    public OwnedBy<Context>,
+                                    public OwnedBy<ComputePass>
+{
+  explicit ComputeConfiguration(Context & ctx, ComputePass & owner);
+  virtual ~ComputeConfiguration() override;
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  MAKE_ALIAS_FOR_GET_OWNER(ComputePass, GetComputePass);
+
+public: // IComputeConfiguration interface
+  virtual void AttachShader(const SpirV & spirv) override;
+  virtual void DefinePushConstant(uint32_t size, uint32_t offset = 0) override;
+  virtual IBufferUniformDescriptor * DeclareUniform(LayoutIndex index) override;
+  virtual ISamplerUniformDescriptor * DeclareSampler(LayoutIndex index) override;
+  virtual void DeclareUniformsArray(LayoutIndex index, uint32_t size,
+                                    IBufferUniformDescriptor * outArray[]) override;
+  virtual void DeclareSamplersArray(LayoutIndex index, uint32_t size,
+                                    ISamplerUniformDescriptor * outArray[]) override;
+  virtual IBufferUniformDescriptor * DeclareStorageBuffer(LayoutIndex index) override;
+  virtual IStorageImageDescriptor * DeclareStorageImage(LayoutIndex index) override;
+  virtual ISamplerUniformDescriptor * DeclareImmutableSampler(LayoutIndex index) override;
+  virtual void UseBindlessTextures(uint32_t set) override;
+
+public: // IInvalidable Interface
+  virtual void Invalidate() override;
+  virtual void SetInvalid() override;
+
+public: // public internal API
+  VkPipeline GetPipelineHandle() const noexcept { return m_pipeline; }
+  VkPipelineLayout GetPipelineLayoutHandle() const noexcept { return m_pipelineLayout; }
+  const DescriptorBufferLayout & GetDescriptorsLayout() const & noexcept;
+  const std::vector<VkPushConstantRange> & GetPushConstantRanges() const & noexcept
+  {
+    return m_pushConstantRanges;
+  }
+  void BindToCommandBuffer(const VkCommandBuffer & buffer);
+  void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer);
+
+private:
+  std::vector<VkPushConstantRange> m_pushConstantRanges;
+  DescriptorBufferLayout m_descriptorsLayout;
+  VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+  VkPipeline m_pipeline = VK_NULL_HANDLE;
+
+  utils::PipelineLayoutBuilder m_pipelineLayoutBuilder;
+  utils::ComputePipelineBuilder m_pipelineBuilder;
+
+  bool m_invalidPipeline = false;
+  bool m_invalidPipelineLayout = false;
+};
+
+} // namespace RHI::vulkan
@@ -0,0 +1,101 @@
+#include "ComputePass.hpp"
+
+#include <Resources/BufferGPU.hpp>
+#include <Utils/CastHelper.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan
+{
+ComputePass::ComputePass(Context & ctx)
+  : OwnedBy<Context>(ctx)
+  , m_configuration(ctx, *this)
+  , m_submitter(ctx, QueueType::Compute, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT)
+  , m_descriptorBuffer(ctx, m_configuration.GetDescriptorsLayout())
+{
+}
+
+ComputePass::~ComputePass()
+{
+  m_submitter.WaitForSubmitCompleted();
+}
+
+bool ComputePass::BeginPass()
+{
+  return BeginPass(RecordBarriersFunc{});
+}
+
+bool ComputePass::BeginPass(const RecordBarriersFunc & recordBarriers)
+{
+  // command buffer and descriptors can't be changed while GPU uses them
+  m_submitter.WaitForSubmitCompleted();
+  m_configuration.Invalidate();
+  if (!m_configuration.GetPipelineHandle())
+    return false;
+  m_descriptorBuffer.Invalidate();
+
+  m_readyToSubmit = false;
+  m_submitter.Reset();
+  m_submitter.BeginWriting();
+  // barriers of graph already transit declared images, so layouts of descriptors aren't changed
+  if (recordBarriers)
+    recordBarriers(m_submitter);
+  else
+    m_configuration.TransitLayoutForUsedImages(m_submitter);
+  m_submitter.FlushBarriers();
+  m_configuration.BindToCommandBuffer(m_submitter.GetHandle());
+  m_descriptorBuffer.BindToCommandBuffer(m_submitter.GetHandle(),
+                                         m_configuration.GetPipelineLayoutHandle(),
+                                         VK_PIPELINE_BIND_POINT_COMPUTE);
+  return true;
+}
+
+void ComputePass::EndPass()
+{
+  m_submitter.EndWriting();
+  m_readyToSubmit = true;
+}
+
+IAwaitable * ComputePass::Submit()
+{
+  if (!m_readyToSubmit)
+    return nullptr;
+  m_readyToSubmit = false;
+  return m_submitter.Submit(true /*waitPrevSubmitOnGPU*/, {});
+}
+
+IComputeConfiguration & ComputePass::GetConfiguration() & noexcept
+{
+  return m_configuration;
+}
+
+void ComputePass::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+  m_submitter.PushCommand(vkCmdDispatch, groupCountX, groupCountY, groupCountZ);
+}
+
+void ComputePass::DispatchIndirect(const IBufferGPU & buffer, uint32_t offset)
+{
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  m_submitter.PushCommand(vkCmdDispatchIndirect, vkBuffer.GetHandle(), VkDeviceSize{offset});
+}
+
+void ComputePass::PushConstant(const void * data, size_t size)
+{
+  PushConstant(0, data, size);
+}
+
+void ComputePass::PushConstant(uint32_t offset, const void * data, size_t size)
+{
+  const auto vkSize = static_cast<uint32_t>(size);
+  if (const char * error = utils::ValidatePushConstant(m_configuration.GetPushConstantRanges(),
+                                                      VK_SHADER_STAGE_COMPUTE_BIT, offset, vkSize))
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                     std::string("Push constant is ignored - ") + error);
+    return;
+  }
+  m_submitter.PushCommand(vkCmdPushConstants, m_configuration.GetPipelineLayoutHandle(),
+                          VK_SHADER_STAGE_COMPUTE_BIT, offset, vkSize, data);
+}
+
+} // namespace RHI::vulkan
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <CommandsExecution/Submitter.hpp>
+#include <ComputePass/ComputeConfiguration.hpp>
+#include <Descriptors/DescriptorsBuffer.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+} // namespace RHI::vulkan
+
+namespace RHI::vulkan
+{
+/// @brief Records compute commands into primary command buffer and submits it into compute queue
+struct ComputePass : public IComputePass,
+                     public IDescriptorsOwner,
+                     public OwnedBy<Context>
+{
+  explicit ComputePass(Context & ctx);
+  virtual ~ComputePass() override;
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+
+public: // IComputePass Interface
+  virtual bool BeginPass() override;
+  virtual void EndPass() override;
+  virtual IAwaitable * Submit() override;
+  virtual IComputeConfiguration & GetConfiguration() & noexcept override;
+
+public: // Commands
+  virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1,
+                        uint32_t groupCountZ = 1) override;
+  virtual void DispatchIndirect(const IBufferGPU & buffer, uint32_t offset = 0) override;
+  using IComputePass::PushConstant;
+  virtual void PushConstant(const void * data, size_t size) override;
+  virtual void PushConstant(uint32_t offset, const void * data, size_t size) override;
+
+public: // public internal API
+  using RecordBarriersFunc = std::function<void(details::CommandBuffer & commandBuffer)>;
+  /// @brief begins pass. Barriers appended by recordBarriers are recorded with one command
+  /// before any command of pass (used by RenderGraph). They replace layout transitions of
+  /// images bound to descriptors
+  bool BeginPass(const RecordBarriersFunc & recordBarriers);
+
+public: // IDescriptorsOwner interface
+  virtual void OnDescriptorChanged(const BufferUniform & descriptor) noexcept override
+  {
+    m_descriptorBuffer.UpdateDescriptor(descriptor);
+  }
+  virtual void OnDescriptorChanged(const SamplerUniform & descriptor) noexcept override
+  {
+    m_descriptorBuffer.UpdateDescriptor(descriptor);
+  }
+  virtual void OnDescriptorChanged(const SamplerArrayUniform & descriptor) noexcept override
+  {
+    m_descriptorBuffer.UpdateDescriptor(descriptor);
+  }
+  virtual void OnDescriptorChanged(const StorageImageUniform & descriptor) noexcept override
+  {
+    m_descriptorBuffer.UpdateDescriptor(descriptor);
+  }
+
+private:
+  ComputeConfiguration m_configuration;
+  details::Submitter m_submitter;
+  DescriptorBuffer m_descriptorBuffer;
+  bool m_readyToSubmit = false; ///< commands are recorded, but not submitted yet
+};
+} // namespace RHI::vulkan
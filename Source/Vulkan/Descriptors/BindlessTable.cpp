@@ -0,0 +1,230 @@
+#include "BindlessTable.hpp"
+
+#include <algorithm>
+
+#include <Utils/SamplerBuilder.hpp>
+#include <VulkanContext.hpp>
+
+namespace
+{
+/// @brief upper bound of table size. Real size is limited by GPU
+constexpr uint32_t kMaxBindlessTextures = 16384;
+
+uint32_t CalcBindlessCapacity(VkPhysicalDevice gpu) noexcept
+{
+  VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{};
+  indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+  VkPhysicalDeviceProperties2 properties{};
+  properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+  properties.pNext = &indexingProperties;
+  vkGetPhysicalDeviceProperties2(gpu, &properties);
+  // combined image sampler is counted both as sampler and as sampled image
+  return std::min({kMaxBindlessTextures,
+                   indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                   indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                   indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                   indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages});
+}
+} // namespace
+
+namespace RHI::vulkan
+{
+
+BindlessTable::BindlessTable(Context & ctx)
+  : OwnedBy<Context>(ctx)
+{
+  auto && gpuConnection = ctx.GetGpuConnection();
+  if (!gpuConnection.GetFeatures().descriptorIndexing)
+    return;
+
+  m_capacity = CalcBindlessCapacity(gpuConnection.GetGPU());
+  const VkDevice device = gpuConnection.GetDevice();
+
+  const VkDescriptorBindingFlags bindingFlags =
+    VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+    VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+    VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+  VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+  bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+  bindingFlagsInfo.bindingCount = 1;
+  bindingFlagsInfo.pBindingFlags = &bindingFlags;
+
+  VkDescriptorSetLayoutBinding binding{};
+  binding.binding = 0;
+  binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  binding.descriptorCount = m_capacity;
+  binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.pNext = &bindingFlagsInfo;
+  layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+  layoutInfo.bindingCount = 1;
+  layoutInfo.pBindings = &binding;
+  if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_layout) != VK_SUCCESS)
+    throw std::runtime_error("Failed to create bindless descriptor set layout");
+
+  VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_capacity};
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+  poolInfo.poolSizeCount = 1;
+  poolInfo.pPoolSizes = &poolSize;
+  poolInfo.maxSets = 1;
+  if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_pool) != VK_SUCCESS)
+    throw std::runtime_error("Failed to create bindless descriptor pool");
+
+  VkDescriptorSetVariableDescriptorCountAllocateInfo countInfo{};
+  countInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+  countInfo.descriptorSetCount = 1;
+  countInfo.pDescriptorCounts = &m_capacity;
+
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.pNext = &countInfo;
+  allocInfo.descriptorPool = m_pool;
+  allocInfo.descriptorSetCount = 1;
+  allocInfo.pSetLayouts = &m_layout;
+  if (vkAllocateDescriptorSets(device, &allocInfo, &m_set) != VK_SUCCESS)
+    throw std::runtime_error("Failed to allocate bindless descriptor set");
+
+  utils::SamplerBuilder samplerBuilder;
+  samplerBuilder.Reset();
+  m_sampler = ctx.GetSamplerCache().Acquire(samplerBuilder);
+
+  m_slots.reserve(m_capacity);
+  ctx.Log(RHI::LogMessageStatus::LOG_DEBUG,
+          "Bindless table has been created with " + std::to_string(m_capacity) + " slots");
+}
+
+BindlessTable::~BindlessTable()
+{
+  // set is freed with its pool
+  GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pool, nullptr);
+  GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_layout, nullptr);
+  GetContext().GetSamplerCache().Release(m_sampler);
+}
+
+uint32_t BindlessTable::Register(IInternalTexture & texture, VkImageLayout layout) const
+{
+  if (!IsEnabled())
+    return InvalidBindlessIndex;
+
+  std::lock_guard lk{m_lock};
+  uint32_t index = InvalidBindlessIndex;
+  if (!m_freeIndices.empty())
+  {
+    index = m_freeIndices.back();
+    m_freeIndices.pop_back();
+  }
+  else if (m_slots.size() < m_capacity)
+  {
+    index = static_cast<uint32_t>(m_slots.size());
+    m_slots.emplace_back();
+  }
+  else
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_WARNING,
+                     "Bindless table is full, texture has no bindless index");
+    return InvalidBindlessIndex;
+  }
+  // new texture has undefined layout
+  m_slots[index] = Slot{&texture, layout, true};
+  m_dirtyIndices.push_back(index);
+
+  VkDescriptorImageInfo imageInfo{};
+  imageInfo.sampler = m_sampler;
+  imageInfo.imageView = texture.GetImageView();
+  imageInfo.imageLayout = layout;
+
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = m_set;
+  write.dstBinding = 0;
+  write.dstArrayElement = index;
+  write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  write.descriptorCount = 1;
+  write.pImageInfo = &imageInfo;
+  vkUpdateDescriptorSets(GetContext().GetGpuConnection().GetDevice(), 1, &write, 0, nullptr);
+  return index;
+}
+
+void BindlessTable::Release(uint32_t index) const noexcept
+{
+  if (index == InvalidBindlessIndex)
+    return;
+  std::lock_guard lk{m_lock};
+  assert(index < m_slots.size());
+  // slot keeps stale descriptor, it's legal for partially bound array until slot is accessed
+  m_slots[index] = Slot{};
+  m_releasedIndices.push_back(index);
+}
+
+void BindlessTable::EndFrame(details::FrameFences::FrameIndex frame)
+{
+  std::lock_guard lk{m_lock};
+  ReclaimPendingIndices(false /*wait*/);
+  if (m_releasedIndices.empty())
+    return;
+
+  // slots can be accessed by any work submitted before the end of frame
+  auto && pending = m_pendingIndices.emplace_back();
+  std::swap(pending.indices, m_releasedIndices);
+  pending.frame = frame;
+}
+
+void BindlessTable::ReclaimReleasedIndices() noexcept
+{
+  std::lock_guard lk{m_lock};
+  ReclaimPendingIndices(true /*wait*/);
+  m_freeIndices.insert(m_freeIndices.end(), m_releasedIndices.begin(), m_releasedIndices.end());
+  m_releasedIndices.clear();
+}
+
+void BindlessTable::ReclaimPendingIndices(bool wait) noexcept
+{
+  auto && frameFences = GetContext().GetFrameFences();
+  while (!m_pendingIndices.empty())
+  {
+    auto && pending = m_pendingIndices.front();
+    // groups are completed in order of their frames
+    if (wait)
+      frameFences.WaitForCompleted(pending.frame);
+    else if (!frameFences.IsCompleted(pending.frame))
+      break;
+
+    m_freeIndices.insert(m_freeIndices.end(), pending.indices.begin(), pending.indices.end());
+    m_pendingIndices.pop_front();
+  }
+}
+
+void BindlessTable::MarkDirty(uint32_t index) const noexcept
+{
+  if (index == InvalidBindlessIndex)
+    return;
+  std::lock_guard lk{m_lock};
+  assert(index < m_slots.size());
+  auto && slot = m_slots[index];
+  if (slot.texture && !slot.dirty)
+  {
+    slot.dirty = true;
+    m_dirtyIndices.push_back(index);
+  }
+}
+
+void BindlessTable::TransitLayoutForUsedImages(details::BarrierBatch & batch,
+                                               VkPipelineStageFlags2 stages) const
+{
+  std::lock_guard lk{m_lock};
+  for (uint32_t index : m_dirtyIndices)
+  {
+    // released slot could be reused after it was marked
+    auto && slot = m_slots[index];
+    if (slot.texture && slot.dirty)
+      slot.texture->TransferLayout(batch, slot.layout, stages);
+    slot.dirty = false;
+  }
+  m_dirtyIndices.clear();
+}
+
+} // namespace RHI::vulkan
@@ -0,0 +1,88 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <CommandsExecution/FrameFences.hpp>
+#include <ImageUtils/TextureInterface.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan
+{
+
+/// @brief context-wide table of sampled textures for bindless access (descriptor indexing).
+/// It's one big partially bound array which can be updated after bind, so each texture is written
+/// once on creation and shaders access it by stable index (for example, from push constants)
+struct BindlessTable final : public OwnedBy<Context>
+{
+  explicit BindlessTable(Context & ctx);
+  ~BindlessTable();
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(BindlessTable);
+
+public:
+  /// @brief false if GPU doesn't support descriptor indexing
+  bool IsEnabled() const noexcept { return m_set != VK_NULL_HANDLE; }
+  /// @brief writes texture into free slot of the table
+  /// @param layout - layout of texture in shaders (GENERAL for storage images)
+  /// @return index of slot or InvalidBindlessIndex if table is disabled or full
+  uint32_t Register(IInternalTexture & texture, VkImageLayout layout) const;
+  /// @brief slot isn't reused until GPU completes work submitted before the next EndFrame
+  void Release(uint32_t index) const noexcept;
+  /// @brief binds released slots to ended frame and makes slots of completed frames free.
+  /// It's called at the end of frame, it doesn't wait for GPU
+  void EndFrame(details::FrameFences::FrameIndex frame);
+  /// @brief makes all released slots free. GPU must not use them at this moment
+  void ReclaimReleasedIndices() noexcept;
+  /// @brief texture of slot has left its layout, so it's transited by next pass
+  void MarkDirty(uint32_t index) const noexcept;
+  /// @brief transits dirty textures into their layouts
+  void TransitLayoutForUsedImages(details::BarrierBatch & batch,
+                                  VkPipelineStageFlags2 stages) const;
+
+  VkDescriptorSetLayout GetLayoutHandle() const noexcept { return m_layout; }
+  VkDescriptorSet GetHandle() const noexcept { return m_set; }
+
+private:
+  struct Slot
+  {
+    IInternalTexture * texture = nullptr;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    bool dirty = false;
+  };
+
+  /// @brief released slots which are used by work submitted before the end of frame
+  struct PendingIndices
+  {
+    std::vector<uint32_t> indices;
+    details::FrameFences::FrameIndex frame = 0;
+  };
+
+private:
+  /// @brief makes slots of pending groups free. If wait is false, only groups of completed
+  /// frames are freed
+  void ReclaimPendingIndices(bool wait) noexcept;
+
+private:
+  uint32_t m_capacity = 0;
+  VkDescriptorSetLayout m_layout = VK_NULL_HANDLE;
+  VkDescriptorPool m_pool = VK_NULL_HANDLE;
+  VkDescriptorSet m_set = VK_NULL_HANDLE;
+  VkSampler m_sampler = VK_NULL_HANDLE; ///< default sampler for all textures of the table
+
+  mutable std::mutex m_lock;
+  mutable std::vector<Slot> m_slots;
+  mutable std::vector<uint32_t> m_freeIndices;
+  mutable std::vector<uint32_t> m_releasedIndices;
+  std::deque<PendingIndices> m_pendingIndices;
+  mutable std::vector<uint32_t> m_dirtyIndices; ///< slots which need layout transition
+};
+
+} // namespace RHI::vulkan
@@ -7,9 +7,10 @@
 namespace RHI::vulkan
 {
 BufferUniform::BufferUniform(Context & ctx, DescriptorBufferLayout & owner, VkDescriptorType type,
-                             LayoutIndex index, uint32_t arrayIndex)
+                             LayoutIndex index, uint32_t arrayIndex, size_t range)
   : BaseUniform(ctx, owner, type, index, arrayIndex)
   , IBufferUniformDescriptor()
+  , m_range(range)
 {
 }
 
@@ -19,6 +20,7 @@ BufferUniform::BufferUniform(BufferUniform && rhs) noexcept
   std::swap(m_buffer, rhs.m_buffer);
   std::swap(m_size, rhs.m_size);
   std::swap(m_offset, rhs.m_offset);
+  std::swap(m_range, rhs.m_range);
 }
 
 BufferUniform & BufferUniform::operator=(BufferUniform && rhs) noexcept
@@ -29,6 +31,7 @@ BufferUniform & BufferUniform::operator=(BufferUniform && rhs) noexcept
     std::swap(m_buffer, rhs.m_buffer);
     std::swap(m_size, rhs.m_size);
     std::swap(m_offset, rhs.m_offset);
+    std::swap(m_range, rhs.m_range);
   }
   return *this;
 }
@@ -40,7 +43,7 @@ void BufferUniform::AssignBuffer(const IBufferGPU & buffer, size_t offset)
   m_buffer = internalBuffer.GetHandle();
   m_size = internalBuffer.Size();
   m_offset = offset;
-  GetLayout().GetConfiguration().GetSubpass().OnDescriptorChanged(*this);
+  GetLayout().GetDescriptorsOwner().OnDescriptorChanged(*this);
 }
 
 bool BufferUniform::IsBufferAssigned() const noexcept
@@ -48,6 +51,12 @@ bool BufferUniform::IsBufferAssigned() const noexcept
   return m_buffer;
 }
 
+bool BufferUniform::IsDynamicOffsetInRange(uint32_t dynamicOffset) const noexcept
+{
+  const size_t range = m_range != 0 ? m_range : m_size;
+  return !m_buffer || m_offset + dynamicOffset + range <= m_size;
+}
+
 void BufferUniform::Invalidate()
 {
 }
@@ -56,13 +65,14 @@ void BufferUniform::SetInvalid()
 {
 }
 
-std::vector<VkDescriptorBufferInfo> BufferUniform::CreateDescriptorInfo() const
+void BufferUniform::CreateDescriptorInfo(std::vector<VkDescriptorBufferInfo> & outInfos) const
 {
-  VkDescriptorBufferInfo bufferInfo{};
+  if (!m_buffer)
+    return;
+  auto && bufferInfo = outInfos.emplace_back();
   bufferInfo.buffer = m_buffer;
-  bufferInfo.range = m_size;
+  bufferInfo.range = m_range != 0 ? m_range : m_size;
   bufferInfo.offset = m_offset;
-  return {bufferInfo};
 }
 
 } // namespace RHI::vulkan
@@ -13,13 +13,14 @@ struct BufferUniform final : public IBufferUniformDescriptor,
                              public details::BaseUniform
 {
   explicit BufferUniform(Context & ctx, DescriptorBufferLayout & owner, VkDescriptorType type,
-                         LayoutIndex index, uint32_t arrayIndex = 0);
+                         LayoutIndex index, uint32_t arrayIndex = 0, size_t range = 0);
   virtual ~BufferUniform() override = default;
   BufferUniform(BufferUniform && rhs) noexcept;
   BufferUniform & operator=(BufferUniform && rhs) noexcept;
 
 public:
-  std::vector<VkDescriptorBufferInfo> CreateDescriptorInfo() const;
+  /// @brief appends infos of descriptor into outInfos
+  void CreateDescriptorInfo(std::vector<VkDescriptorBufferInfo> & outInfos) const;
 
 
 public: // IBufferUniformDescriptor interface
@@ -37,6 +38,8 @@ public: // IInvalidable interface
 
 public: // public internal API
   size_t GetOffset() const noexcept { return m_offset; }
+  /// @brief checks that visible range shifted by dynamic offset fits into assigned buffer
+  bool IsDynamicOffsetInRange(uint32_t dynamicOffset) const noexcept;
   VkBuffer GetBuffer() const noexcept { return m_buffer; }
   using BaseUniform::GetDescriptorType;
 
@@ -44,6 +47,7 @@ private:
   VkBuffer m_buffer = VK_NULL_HANDLE;
   size_t m_size = 0;
   size_t m_offset = 0;
+  size_t m_range = 0; ///< visible size for dynamic descriptors, 0 means whole buffer
 };
 
 } // namespace RHI::vulkan
@@ -0,0 +1,159 @@
+#include "DescriptorAllocator.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include <VulkanContext.hpp>
+
+namespace
+{
+constexpr uint32_t kSetsPerPool = 256;
+
+/// @brief average count of descriptors of each type per set. It's used to size pool pages
+constexpr std::array<std::pair<VkDescriptorType, uint32_t>, 6> kPoolRatios = {{
+  {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2},
+  {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
+  {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
+  {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1},
+  {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4},
+  {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1},
+}};
+} // namespace
+
+namespace RHI::vulkan
+{
+
+DescriptorAllocator::DescriptorAllocator(Context & ctx)
+  : OwnedBy<Context>(ctx)
+{
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+  for (auto && pool : m_pools)
+    GetContext().GetGarbageCollector().PushVkObjectToDestroy(pool, nullptr);
+}
+
+VkDescriptorSet DescriptorAllocator::Allocate(const utils::DescriptorSetLayoutBuilder & description,
+                                              VkDescriptorSetLayout layout) const
+{
+  std::lock_guard lk{m_lock};
+  if (auto it = m_freeSets.find(description); it != m_freeSets.end() && !it->second.empty())
+  {
+    VkDescriptorSet set = it->second.back();
+    it->second.pop_back();
+    return set;
+  }
+
+  VkDescriptorSet set = m_pools.empty() ? VK_NULL_HANDLE : AllocateFromPool(m_pools.back(), layout);
+  if (!set)
+  {
+    // current page is full, start new one
+    m_pools.push_back(CreatePool(description));
+    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkDescriptorPool page has been created");
+    set = AllocateFromPool(m_pools.back(), layout);
+  }
+  if (!set)
+    throw std::runtime_error("Failed to allocate VkDescriptorSet");
+  return set;
+}
+
+void DescriptorAllocator::Release(const utils::DescriptorSetLayoutBuilder & description,
+                                  VkDescriptorSet set) const noexcept
+{
+  if (!set)
+    return;
+  std::lock_guard lk{m_lock};
+  m_releasedSets.emplace_back(description, set);
+}
+
+void DescriptorAllocator::EndFrame(details::FrameFences::FrameIndex frame)
+{
+  std::lock_guard lk{m_lock};
+  ReclaimPendingSets(false /*wait*/);
+  if (m_releasedSets.empty())
+    return;
+
+  // sets can be used by any work submitted before the end of frame
+  auto && pending = m_pendingSets.emplace_back();
+  std::swap(pending.sets, m_releasedSets);
+  pending.frame = frame;
+}
+
+void DescriptorAllocator::ReclaimReleasedSets() noexcept
+{
+  std::lock_guard lk{m_lock};
+  ReclaimPendingSets(true /*wait*/);
+  for (auto && [description, set] : m_releasedSets)
+    m_freeSets[description].push_back(set);
+  m_releasedSets.clear();
+}
+
+void DescriptorAllocator::ReclaimPendingSets(bool wait) noexcept
+{
+  auto && frameFences = GetContext().GetFrameFences();
+  while (!m_pendingSets.empty())
+  {
+    auto && pending = m_pendingSets.front();
+    // groups are completed in order of their frames
+    if (wait)
+      frameFences.WaitForCompleted(pending.frame);
+    else if (!frameFences.IsCompleted(pending.frame))
+      break;
+
+    for (auto && [description, set] : pending.sets)
+      m_freeSets[description].push_back(set);
+    m_pendingSets.pop_front();
+  }
+}
+
+VkDescriptorPool DescriptorAllocator::CreatePool(
+  const utils::DescriptorSetLayoutBuilder & description) const
+{
+  std::vector<VkDescriptorPoolSize> poolSizes;
+  poolSizes.reserve(kPoolRatios.size());
+  for (auto && [type, ratio] : kPoolRatios)
+    poolSizes.push_back(VkDescriptorPoolSize{type, ratio * kSetsPerPool});
+
+  // page must fit at least one set of requested layout (for example, big arrays of samplers)
+  for (auto && binding : description.GetBindings())
+  {
+    auto it = std::find_if(poolSizes.begin(), poolSizes.end(),
+                           [&binding](const VkDescriptorPoolSize & size)
+                           { return size.type == binding.descriptorType; });
+    if (it == poolSizes.end())
+      poolSizes.push_back(VkDescriptorPoolSize{binding.descriptorType, binding.descriptorCount});
+    else
+      it->descriptorCount = std::max(it->descriptorCount, binding.descriptorCount);
+  }
+
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+  poolInfo.pPoolSizes = poolSizes.data();
+  poolInfo.maxSets = kSetsPerPool;
+
+  VkDescriptorPool pool;
+  if (vkCreateDescriptorPool(GetContext().GetGpuConnection().GetDevice(), &poolInfo, nullptr,
+                             &pool) != VK_SUCCESS)
+    throw std::runtime_error("failed to create VkDescriptorPool!");
+  return pool;
+}
+
+VkDescriptorSet DescriptorAllocator::AllocateFromPool(VkDescriptorPool pool,
+                                                      VkDescriptorSetLayout layout) const
+{
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.descriptorPool = pool;
+  allocInfo.descriptorSetCount = 1;
+  allocInfo.pSetLayouts = &layout;
+
+  VkDescriptorSet set = VK_NULL_HANDLE;
+  if (vkAllocateDescriptorSets(GetContext().GetGpuConnection().GetDevice(), &allocInfo, &set) !=
+      VK_SUCCESS)
+    return VK_NULL_HANDLE; // pool is out of memory or fragmented
+  return set;
+}
+
+} // namespace RHI::vulkan
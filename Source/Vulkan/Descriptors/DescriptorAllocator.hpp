@@ -0,0 +1,71 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CommandsExecution/FrameFences.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <Utils/DescriptorSetLayoutBuilder.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan
+{
+
+/// @brief context-wide allocator of descriptor sets. Pools are allocated by pages and shared
+/// between all passes. Released sets are kept in free lists per layout description and reused
+/// after GPU has finished work with them (see EndFrame)
+struct DescriptorAllocator final : public OwnedBy<Context>
+{
+  explicit DescriptorAllocator(Context & ctx);
+  ~DescriptorAllocator();
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(DescriptorAllocator);
+
+public:
+  /// @brief allocates set from free list or from current pool page
+  VkDescriptorSet Allocate(const utils::DescriptorSetLayoutBuilder & description,
+                           VkDescriptorSetLayout layout) const;
+  /// @brief set isn't reused until GPU completes work submitted before the next EndFrame
+  void Release(const utils::DescriptorSetLayoutBuilder & description,
+               VkDescriptorSet set) const noexcept;
+  /// @brief binds released sets to ended frame and moves sets of completed frames to free lists.
+  /// It's called at the end of frame, it doesn't wait for GPU
+  void EndFrame(details::FrameFences::FrameIndex frame);
+  /// @brief moves all released sets to free lists. GPU must not use them at this moment
+  void ReclaimReleasedSets() noexcept;
+
+private:
+  using ReleasedSets = std::vector<std::pair<utils::DescriptorSetLayoutBuilder, VkDescriptorSet>>;
+
+  /// @brief released sets which are used by work submitted before the end of frame
+  struct PendingSets
+  {
+    ReleasedSets sets;
+    details::FrameFences::FrameIndex frame = 0;
+  };
+
+private:
+  VkDescriptorPool CreatePool(const utils::DescriptorSetLayoutBuilder & description) const;
+  VkDescriptorSet AllocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout layout) const;
+  /// @brief moves sets of pending groups to free lists. If wait is false, only groups of
+  /// completed frames are moved
+  void ReclaimPendingSets(bool wait) noexcept;
+
+private:
+  mutable std::mutex m_lock;
+  mutable std::vector<VkDescriptorPool> m_pools; ///< the last one is current page
+  mutable std::unordered_map<utils::DescriptorSetLayoutBuilder, std::vector<VkDescriptorSet>>
+    m_freeSets;
+  mutable ReleasedSets m_releasedSets;
+  std::deque<PendingSets> m_pendingSets;
+};
+
+} // namespace RHI::vulkan
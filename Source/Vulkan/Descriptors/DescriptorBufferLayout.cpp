@@ -4,73 +4,82 @@
 #include <cassert>
 #include <numeric>
 
-#include <RenderPass/SubpassConfiguration.hpp>
 #include <VulkanContext.hpp>
 
-namespace RHI::vulkan::details
+namespace
 {
-VkDescriptorPool CreateDescriptorPool(const Context & ctx,
-                                      const std::vector<VkDescriptorPoolSize> & poolSizes)
+constexpr VkPipelineStageFlags2 ShaderStages2PipelineStages(VkShaderStageFlags stages) noexcept
 {
-  VkDescriptorPoolCreateInfo poolInfo{};
-  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-  poolInfo.pPoolSizes = poolSizes.data();
-  poolInfo.maxSets = std::accumulate(poolSizes.begin(), poolSizes.end(), 0u,
-                                     [](uint32_t acc, const VkDescriptorPoolSize & pool_size)
-                                     { return acc + pool_size.descriptorCount; });
-  assert(poolInfo.maxSets != 0);
-
-  VkDescriptorPool c_pool;
-  if (vkCreateDescriptorPool(ctx.GetGpuConnection().GetDevice(), &poolInfo, nullptr, &c_pool) !=
-      VK_SUCCESS)
-    throw std::runtime_error("failed to create VkDescriptorPool!");
-  return VkDescriptorPool(c_pool);
-}
-
-VkDescriptorSet CreateDescriptorSet(const Context & ctx, VkDescriptorPool pool,
-                                    VkDescriptorSetLayout layout)
-{
-  VkDescriptorSetAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-  allocInfo.descriptorPool = pool;
-  allocInfo.descriptorSetCount = 1;
-  allocInfo.pSetLayouts = &layout;
-
-  VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
-  if (vkAllocateDescriptorSets(ctx.GetGpuConnection().GetDevice(), &allocInfo, &descriptor_set) !=
-      VK_SUCCESS)
-    throw std::runtime_error("failed to allocate VkDescriptorSet!");
-  return VkDescriptorSet(descriptor_set);
+  VkPipelineStageFlags2 result = VK_PIPELINE_STAGE_2_NONE;
+  if (stages & VK_SHADER_STAGE_VERTEX_BIT)
+    result |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+  if (stages & VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT)
+    result |= VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT;
+  if (stages & VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT)
+    result |= VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT;
+  if (stages & VK_SHADER_STAGE_GEOMETRY_BIT)
+    result |= VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT;
+  if (stages & VK_SHADER_STAGE_FRAGMENT_BIT)
+    result |= VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+  if (stages & VK_SHADER_STAGE_COMPUTE_BIT)
+    result |= VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  return result;
 }
-
-
-} // namespace RHI::vulkan::details
+} // namespace
 
 namespace RHI::vulkan
 {
 
-DescriptorBufferLayout::DescriptorBufferLayout(Context & ctx, SubpassConfiguration & owner)
+DescriptorBufferLayout::DescriptorBufferLayout(Context & ctx, IDescriptorsOwner & owner)
   : OwnedBy<Context>(ctx)
-  , OwnedBy<SubpassConfiguration>(owner)
+  , OwnedBy<IDescriptorsOwner>(owner)
 {
 }
 
 DescriptorBufferLayout::~DescriptorBufferLayout()
 {
-  for (auto layout : m_layouts)
-    GetContext().GetGarbageCollector().PushVkObjectToDestroy(layout, nullptr);
+  for (size_t i = 0; i < m_layouts.size(); ++i)
+  {
+    // layout of bindless set is owned by context
+    if (!IsBindlessSet(i))
+      GetContext().GetLayoutCache().ReleaseSetLayout(m_layouts[i]);
+  }
 }
 
-void DescriptorBufferLayout::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer)
+void DescriptorBufferLayout::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer,
+                                                        VkPipelineStageFlags2 passStages)
 {
+  // images which are already in required layout don't add barriers
+  auto && batch = commandBuffer.GetBarriers();
   for (auto && sampler : m_samplerDescriptors)
   {
-    sampler.TransitLayoutForUsedImages(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    sampler.TransitLayoutForUsedImages(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       GetUsageStages(sampler, passStages));
   }
 
   for (auto && sampler : m_samplerArrayDescriptors)
-    sampler.TransitLayoutForUsedImages(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    sampler.TransitLayoutForUsedImages(batch, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       GetUsageStages(sampler, passStages));
+
+  for (auto && image : m_storageImageDescriptors)
+    image.TransitLayoutForUsedImages(batch, VK_IMAGE_LAYOUT_GENERAL,
+                                     GetUsageStages(image, passStages));
+
+  // bindless table is visible to all stages
+  if (m_bindlessSet.has_value())
+    GetContext().GetBindlessTable().TransitLayoutForUsedImages(batch, passStages);
+}
+
+VkPipelineStageFlags2 DescriptorBufferLayout::GetUsageStages(
+  const details::BaseUniform & uniform, VkPipelineStageFlags2 passStages) const noexcept
+{
+  auto && bindings = m_builders[uniform.GetSet()].GetBindings();
+  auto it = std::find_if(bindings.begin(), bindings.end(), [&uniform](auto && binding)
+                         { return binding.binding == uniform.GetBinding(); });
+  const VkPipelineStageFlags2 stages =
+    it != bindings.end() ? ShaderStages2PipelineStages(it->stageFlags) & passStages
+                         : VK_PIPELINE_STAGE_2_NONE;
+  return stages != VK_PIPELINE_STAGE_2_NONE ? stages : passStages;
 }
 
 void DescriptorBufferLayout::SetInvalid()
@@ -78,46 +87,64 @@ void DescriptorBufferLayout::SetInvalid()
   std::fill(m_invalidLayouts.begin(), m_invalidLayouts.end(), ValidityFlag::NotValid);
 }
 
-void DescriptorBufferLayout::Invalidate()
+bool DescriptorBufferLayout::Invalidate()
 {
   size_t setsCount = m_layouts.size();
   assert(setsCount == m_invalidLayouts.size() && setsCount == m_builders.size());
 
-  for (size_t i = 0; i < setsCount; ++i)
-  {
-    if (m_invalidLayouts[i] == ValidityFlag::NotValid || !m_layouts[i])
-    {
-      auto newLayout = m_builders[i].Make(GetContext().GetGpuConnection().GetDevice());
-      GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_layouts[i], nullptr);
-      m_layouts[i] = newLayout;
-      m_invalidLayouts[i] = ValidityFlag::Valid;
-      GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkDescriptorSetLayout has been rebuilt");
-    }
-  }
-
   for (auto && uniform : m_bufferUniformDescriptors)
     uniform.Invalidate();
 
+  // samplers are created before layouts because immutable samplers are baked into layouts
   for (auto && uniform : m_samplerDescriptors)
+  {
     uniform.Invalidate();
+    if (uniform.IsImmutable() &&
+        m_builders[uniform.GetSet()].SetImmutableSampler(
+          uniform.GetBinding(), uniform.GetArrayIndex(), uniform.GetHandle()))
+      m_invalidLayouts[uniform.GetSet()] = ValidityFlag::NotValid;
+  }
 
   for (auto && uniform : m_samplerArrayDescriptors)
     uniform.Invalidate();
+
+  bool rebuilt = false;
+  for (size_t i = 0; i < setsCount; ++i)
+  {
+    if (IsBindlessSet(i))
+    {
+      rebuilt |= m_layouts[i] != GetContext().GetBindlessTable().GetLayoutHandle();
+      m_layouts[i] = GetContext().GetBindlessTable().GetLayoutHandle();
+      m_invalidLayouts[i] = ValidityFlag::Valid;
+    }
+    else if (m_invalidLayouts[i] == ValidityFlag::NotValid || !m_layouts[i])
+    {
+      // identical layouts are shared, so handle could stay the same
+      auto newLayout = GetContext().GetLayoutCache().AcquireSetLayout(m_builders[i]);
+      GetContext().GetLayoutCache().ReleaseSetLayout(m_layouts[i]);
+      rebuilt |= newLayout != m_layouts[i];
+      m_layouts[i] = newLayout;
+      m_invalidLayouts[i] = ValidityFlag::Valid;
+    }
+  }
+  return rebuilt;
 }
 
-void DescriptorBufferLayout::DeclareBufferUniformsArray(LayoutIndex index, ShaderType shaderStage,
-                                                        uint32_t size,
-                                                        IBufferUniformDescriptor * outArray[])
+void DescriptorBufferLayout::DeclareBufferUniformsArray(LayoutIndex index, VkDescriptorType type,
+                                                        ShaderType shaderStage, uint32_t size,
+                                                        IBufferUniformDescriptor * outArray[],
+                                                        size_t range)
 {
-  constexpr VkDescriptorType type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  assert(type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+         type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+         type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
   DeclareDescriptorsArray(index, type, shaderStage, size);
 
   for (uint32_t i = 0; i < size; ++i)
   {
     auto && [it, inserted] = m_indexedDescriptors.insert({index, {}});
-    BufferUniform uniform(GetContext(), *this, type, index, i);
     auto && newDescriptor =
-      m_bufferUniformDescriptors.emplace_back(GetContext(), *this, type, index, i);
+      m_bufferUniformDescriptors.emplace_back(GetContext(), *this, type, index, i, range);
     it->second.push_back(&newDescriptor);
     outArray[i] = &newDescriptor;
   }
@@ -125,7 +152,8 @@ void DescriptorBufferLayout::DeclareBufferUniformsArray(LayoutIndex index, Shade
 
 void DescriptorBufferLayout::DeclareSamplerUniformsArray(LayoutIndex index, ShaderType shaderStage,
                                                          uint32_t size,
-                                                         ISamplerUniformDescriptor * outArray[])
+                                                         ISamplerUniformDescriptor * outArray[],
+                                                         bool immutable)
 {
   const VkDescriptorType type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   DeclareDescriptorsArray(index, type, shaderStage, size);
@@ -133,7 +161,8 @@ void DescriptorBufferLayout::DeclareSamplerUniformsArray(LayoutIndex index, Shad
   for (uint32_t i = 0; i < size; ++i)
   {
     auto && [it, inserted] = m_indexedDescriptors.insert({index, {}});
-    auto && newDescriptor = m_samplerDescriptors.emplace_back(GetContext(), *this, type, index, i);
+    auto && newDescriptor =
+      m_samplerDescriptors.emplace_back(GetContext(), *this, type, index, i, immutable);
     it->second.push_back(&newDescriptor);
     outArray[i] = &newDescriptor;
   }
@@ -155,38 +184,91 @@ void DescriptorBufferLayout::DeclareSamplerArrayUniformsArray(
   }
 }
 
-std::pair<VkDescriptorPool, std::vector<VkDescriptorSet>> DescriptorBufferLayout::
-  AllocDescriptorSets() const
+void DescriptorBufferLayout::DeclareStorageImagesArray(LayoutIndex index, ShaderType shaderStage,
+                                                       uint32_t size,
+                                                       IStorageImageDescriptor * outArray[])
 {
-  std::vector<VkDescriptorPoolSize> poolSizes;
-  poolSizes.reserve(m_setsInfo.size());
-  for (auto && [type, metaInfos] : m_setsInfo)
+  const VkDescriptorType type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+  DeclareDescriptorsArray(index, type, shaderStage, size);
+
+  for (uint32_t i = 0; i < size; ++i)
   {
-    VkDescriptorPoolSize poolSize{};
-    poolSize.type = type;
-    poolSize.descriptorCount = std::accumulate(metaInfos.begin(), metaInfos.end(), 0,
-                                               [](uint32_t acc, const DescriptorMetaInfo & info)
-                                               { return acc + info.arraySize; });
-    poolSizes.push_back(poolSize);
+    auto && [it, inserted] = m_indexedDescriptors.insert({index, {}});
+    auto && newDescriptor =
+      m_storageImageDescriptors.emplace_back(GetContext(), *this, type, index, i);
+    it->second.push_back(&newDescriptor);
+    outArray[i] = &newDescriptor;
   }
-  auto pool = details::CreateDescriptorPool(GetContext(), poolSizes);
+}
+
+void DescriptorBufferLayout::UseBindlessTable(uint32_t set)
+{
+  if (!GetContext().GetBindlessTable().IsEnabled())
+    throw std::runtime_error("Bindless textures aren't supported by GPU");
+  if (m_bindlessSet.has_value() && *m_bindlessSet != set)
+    throw std::runtime_error("Bindless table is already bound to another set");
+  ReserveSet(set);
+  if (!m_builders[set].GetBindings().empty())
+    throw std::runtime_error("Set of bindless table must not contain other descriptors");
+  if (!m_bindlessSet.has_value())
+  {
+    // empty layout could be built for the set before
+    GetContext().GetLayoutCache().ReleaseSetLayout(m_layouts[set]);
+    m_layouts[set] = VK_NULL_HANDLE;
+  }
+  m_bindlessSet = set;
+  m_invalidLayouts[set] = ValidityFlag::NotValid;
+}
+
+std::vector<VkDescriptorSet> DescriptorBufferLayout::AllocDescriptorSets() const
+{
+  assert(m_layouts.size() == m_builders.size());
+  auto && allocator = GetContext().GetDescriptorAllocator();
   std::vector<VkDescriptorSet> sets;
   sets.reserve(m_layouts.size());
-  for (auto && layout : m_layouts)
-    sets.push_back(details::CreateDescriptorSet(GetContext(), pool, layout));
-  return {pool, std::move(sets)};
+  for (size_t i = 0; i < m_layouts.size(); ++i)
+  {
+    sets.push_back(IsBindlessSet(i) ? GetContext().GetBindlessTable().GetHandle()
+                                    : allocator.Allocate(m_builders[i], m_layouts[i]));
+  }
+  return sets;
 }
 
-uint32_t DescriptorBufferLayout::GetCountOfOneTypeDescriptors(VkDescriptorType type) const
+const std::vector<utils::DescriptorSetLayoutBuilder> & DescriptorBufferLayout::GetDescriptions()
+  const & noexcept
 {
-  uint32_t result = 0;
-  auto it = m_setsInfo.find(type);
-  if (it != m_setsInfo.end())
+  return m_builders;
+}
+
+uint32_t DescriptorBufferLayout::GetDynamicDescriptorsCount(uint32_t set) const noexcept
+{
+  return set < m_dynamicDescriptorsCount.size() ? m_dynamicDescriptorsCount[set] : 0;
+}
+
+uint32_t DescriptorBufferLayout::GetDynamicDescriptorsCount() const noexcept
+{
+  return std::accumulate(m_dynamicDescriptorsCount.begin(), m_dynamicDescriptorsCount.end(), 0u);
+}
+
+std::vector<const BufferUniform *> DescriptorBufferLayout::GetDynamicDescriptors(
+  uint32_t set) const
+{
+  std::vector<const BufferUniform *> result;
+  result.reserve(GetDynamicDescriptorsCount(set));
+  for (auto && uniform : m_bufferUniformDescriptors)
   {
-    result = std::accumulate(it->second.begin(), it->second.end(), 0,
-                             [](uint32_t acc, const DescriptorMetaInfo & info)
-                             { return acc + info.arraySize; });
+    const auto type = uniform.GetDescriptorType();
+    if (uniform.GetSet() == set && (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+                                    type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC))
+      result.push_back(&uniform);
   }
+  // offsets are consumed in order of bindings and array elements
+  std::sort(result.begin(), result.end(),
+            [](const BufferUniform * lhs, const BufferUniform * rhs)
+            {
+              return std::make_pair(lhs->GetBinding(), lhs->GetArrayIndex()) <
+                     std::make_pair(rhs->GetBinding(), rhs->GetArrayIndex());
+            });
   return result;
 }
 
@@ -200,16 +282,28 @@ void DescriptorBufferLayout::DeclareDescriptorsArray(const LayoutIndex & index,
                                                      uint32_t size)
 {
   const uint32_t setIdx = index.set;
+  if (IsBindlessSet(setIdx))
+    throw std::runtime_error("Set of bindless table must not contain other descriptors");
+  ReserveSet(setIdx);
+
+  if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+      type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
+    m_dynamicDescriptorsCount[setIdx] += size;
+
+  m_builders[setIdx].DeclareDescriptorsArray(index.binding, type, shaderStage, size);
+  m_invalidLayouts[setIdx] = ValidityFlag::NotValid;
+}
+
+void DescriptorBufferLayout::ReserveSet(uint32_t setIdx)
+{
   while (m_layouts.size() <= setIdx)
     m_layouts.push_back(VK_NULL_HANDLE);
   while (m_builders.size() <= setIdx)
     m_builders.emplace_back();
   while (m_invalidLayouts.size() <= setIdx)
     m_invalidLayouts.emplace_back(ValidityFlag::NotValid);
-
-  m_builders[setIdx].DeclareDescriptorsArray(index.binding, type, shaderStage, size);
-  m_setsInfo[type].emplace_back(index, size);
-  m_invalidLayouts[setIdx] = ValidityFlag::NotValid;
+  while (m_dynamicDescriptorsCount.size() <= setIdx)
+    m_dynamicDescriptorsCount.push_back(0);
 }
 
 } // namespace RHI::vulkan
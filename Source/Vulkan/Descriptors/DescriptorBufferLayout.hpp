@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <deque>
 #include <span>
 
@@ -7,6 +8,7 @@
 #include <Descriptors/BufferUniform.hpp>
 #include <Descriptors/SamplerArrayUniform.hpp>
 #include <Descriptors/SamplerUniform.hpp>
+#include <Descriptors/StorageImageUniform.hpp>
 #include <Private/OwnedBy.hpp>
 #include <RHI.hpp>
 #include <Utils/DescriptorSetLayoutBuilder.hpp>
@@ -15,46 +17,86 @@
 namespace RHI::vulkan
 {
 struct Context;
-struct SubpassConfiguration;
 } // namespace RHI::vulkan
 
 namespace RHI::vulkan
 {
 
-struct DescriptorMetaInfo
+/// @brief pass which uses declared descriptors (subpass or compute pass).
+/// It's notified when resources of descriptors are changed
+struct IDescriptorsOwner
 {
-  LayoutIndex index;
-  uint32_t arraySize;
+  virtual ~IDescriptorsOwner() = default;
+  virtual void OnDescriptorChanged(const BufferUniform & descriptor) noexcept = 0;
+  virtual void OnDescriptorChanged(const SamplerUniform & descriptor) noexcept = 0;
+  virtual void OnDescriptorChanged(const SamplerArrayUniform & descriptor) noexcept = 0;
+  virtual void OnDescriptorChanged(const StorageImageUniform & descriptor) noexcept = 0;
 };
 
 struct DescriptorBufferLayout final : public OwnedBy<Context>,
-                                      public OwnedBy<SubpassConfiguration>
+                                      public OwnedBy<IDescriptorsOwner>
 {
-  explicit DescriptorBufferLayout(Context & ctx, SubpassConfiguration & owner);
+  explicit DescriptorBufferLayout(Context & ctx, IDescriptorsOwner & owner);
   ~DescriptorBufferLayout();
   MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
-  MAKE_ALIAS_FOR_GET_OWNER(SubpassConfiguration, GetConfiguration);
+  MAKE_ALIAS_FOR_GET_OWNER(IDescriptorsOwner, GetDescriptorsOwner);
 
-  void DeclareBufferUniformsArray(LayoutIndex index, ShaderType shaderStage, uint32_t size,
-                                  IBufferUniformDescriptor * outArray[]);
+  /// @param type - uniform or storage buffer, dynamic or not
+  /// @param range - size of block visible to shader for dynamic buffers, 0 means whole buffer
+  void DeclareBufferUniformsArray(LayoutIndex index, VkDescriptorType type, ShaderType shaderStage,
+                                  uint32_t size, IBufferUniformDescriptor * outArray[],
+                                  size_t range = 0);
+  /// @param immutable - samplers are baked into set layout. Their changes rebuild the layout
   void DeclareSamplerUniformsArray(LayoutIndex index, ShaderType shaderStage, uint32_t size,
-                                   ISamplerUniformDescriptor * outArray[]);
+                                   ISamplerUniformDescriptor * outArray[], bool immutable = false);
   void DeclareSamplerArrayUniformsArray(LayoutIndex index, ShaderType shaderStage, uint32_t size,
                                         ISamplerArrayUniformDescriptor * outArray[]);
+  void DeclareStorageImagesArray(LayoutIndex index, ShaderType shaderStage, uint32_t size,
+                                 IStorageImageDescriptor * outArray[]);
+  /// @brief set uses layout and descriptor set of context's bindless table
+  void UseBindlessTable(uint32_t set);
 
-  void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer);
+  /// @brief appends transitions of used images into barriers of command buffer.
+  /// Caller flushes them before commands which use descriptors
+  /// @param passStages - shader stages of the pass (graphics or compute)
+  void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer,
+                                  VkPipelineStageFlags2 passStages);
 
 public:
   void SetInvalid();
-  void Invalidate();
-  std::pair<VkDescriptorPool, std::vector<VkDescriptorSet>> AllocDescriptorSets() const;
-  uint32_t GetCountOfOneTypeDescriptors(VkDescriptorType type) const;
+  /// @return true if any set layout has been rebuilt
+  bool Invalidate();
+  /// @brief allocates one descriptor set for each layout from context's DescriptorAllocator
+  std::vector<VkDescriptorSet> AllocDescriptorSets() const;
+  /// @brief count of descriptors with dynamic offset in the set
+  uint32_t GetDynamicDescriptorsCount(uint32_t set) const noexcept;
+  /// @brief count of descriptors with dynamic offset in all sets
+  uint32_t GetDynamicDescriptorsCount() const noexcept;
+  /// @brief descriptors with dynamic offset in the set, ordered as their offsets are bound
+  std::vector<const BufferUniform *> GetDynamicDescriptors(uint32_t set) const;
 
   const std::vector<VkDescriptorSetLayout> & GetHandles() const & noexcept;
+  /// @brief descriptions of set layouts (in the same order as handles)
+  const std::vector<utils::DescriptorSetLayoutBuilder> & GetDescriptions() const & noexcept;
+
+  /// @brief calls func for each declared descriptor
+  template<typename FuncT>
+  void ForEachDescriptor(FuncT && func) const
+  {
+    std::for_each(m_bufferUniformDescriptors.begin(), m_bufferUniformDescriptors.end(), func);
+    std::for_each(m_samplerDescriptors.begin(), m_samplerDescriptors.end(), func);
+    std::for_each(m_samplerArrayDescriptors.begin(), m_samplerArrayDescriptors.end(), func);
+    std::for_each(m_storageImageDescriptors.begin(), m_storageImageDescriptors.end(), func);
+  }
 
 private:
   void DeclareDescriptorsArray(const LayoutIndex & index, VkDescriptorType type,
                                ShaderType shaderStage, uint32_t size);
+  void ReserveSet(uint32_t setIdx);
+  bool IsBindlessSet(size_t setIdx) const noexcept { return m_bindlessSet == setIdx; }
+  /// @brief pipeline stages of shaders which use the descriptor
+  VkPipelineStageFlags2 GetUsageStages(const details::BaseUniform & uniform,
+                                       VkPipelineStageFlags2 passStages) const noexcept;
 
 private:
   enum class ValidityFlag : uint8_t
@@ -65,15 +107,18 @@ private:
   using BufferUniforms = std::deque<BufferUniform>;
   using SamplerUniforms = std::deque<SamplerUniform>;
   using SamplerArrayUniforms = std::deque<SamplerArrayUniform>;
+  using StorageImageUniforms = std::deque<StorageImageUniform>;
 
   std::vector<VkDescriptorSetLayout> m_layouts;
   std::vector<utils::DescriptorSetLayoutBuilder> m_builders;
   std::vector<ValidityFlag> m_invalidLayouts;
+  std::vector<uint32_t> m_dynamicDescriptorsCount;
+  std::optional<uint32_t> m_bindlessSet;
 
   BufferUniforms m_bufferUniformDescriptors;
   SamplerUniforms m_samplerDescriptors;
   SamplerArrayUniforms m_samplerArrayDescriptors;
-  std::unordered_map<VkDescriptorType, std::vector<DescriptorMetaInfo>> m_setsInfo;
+  StorageImageUniforms m_storageImageDescriptors;
   std::unordered_map<LayoutIndex, std::vector<details::BaseUniform *>> m_indexedDescriptors;
 };
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <tuple>
 
 #include <Resources/BufferGPU.hpp>
 #include <Utils/CastHelper.hpp>
@@ -12,43 +13,28 @@
 #include "BufferUniform.hpp"
 #include "DescriptorBufferLayout.hpp"
 #include "SamplerUniform.hpp"
+#include "StorageImageUniform.hpp"
 
 
 namespace RHI::vulkan::details
 {
 
-//discover https://kylehalladay.com/blog/tutorial/vulkan/2018/01/28/Textue-Arrays-Vulkan.html
-template<typename UniformT>
-  requires(std::is_same_v<UniformT, BufferUniform> || std::is_same_v<UniformT, SamplerUniform> ||
-           std::is_same_v<UniformT, SamplerArrayUniform>)
-void UpdateDescriptorResource(const Context & ctx, VkDescriptorSet set, const UniformT & uniform)
+/// @brief position of descriptor (set, binding, array index). Updates are sorted by it
+using DescriptorPosition = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+template<typename UniformPtrT>
+DescriptorPosition GetDescriptorPosition(const UniformPtrT & uniform) noexcept
 {
-  assert(set);
-  auto && infos = uniform.CreateDescriptorInfo();
-
-  VkWriteDescriptorSet descriptorWrite{};
-  descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  descriptorWrite.dstSet = set;
-  descriptorWrite.dstBinding = uniform.GetBinding();
-  descriptorWrite.dstArrayElement = uniform.GetArrayIndex();
-  descriptorWrite.descriptorType = uniform.GetDescriptorType();
-  descriptorWrite.descriptorCount = static_cast<uint32_t>(infos.size());
-  if constexpr (std::is_same_v<UniformT, BufferUniform>)
-  {
-    descriptorWrite.pBufferInfo = infos.data();
-    descriptorWrite.pImageInfo = nullptr; // Optional
-  }
-  else if constexpr (std::is_same_v<UniformT, SamplerUniform>)
-  {
-    assert(uniform.GetDescriptorType() == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER ||
-           uniform.GetDescriptorType() == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ||
-           uniform.GetDescriptorType() == VK_DESCRIPTOR_TYPE_SAMPLER);
-    descriptorWrite.pBufferInfo = nullptr;
-    descriptorWrite.pImageInfo = infos.data(); // Optional
-  }
-  descriptorWrite.pTexelBufferView = nullptr; // Optional
+  return std::visit([](auto && ptr) -> DescriptorPosition
+                    { return {ptr->GetSet(), ptr->GetBinding(), ptr->GetArrayIndex()}; },
+                    uniform);
+}
 
-  vkUpdateDescriptorSets(ctx.GetGpuConnection().GetDevice(), 1, &descriptorWrite, 0, nullptr);
+constexpr bool IsBufferDescriptor(VkDescriptorType type) noexcept
+{
+  return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+         type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+         type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
 }
 
 
@@ -59,8 +45,10 @@ constexpr RHI::BufferGPUUsage DescriptorType2BufferUsage(VkDescriptorType type)
     /*case VK_DESCRIPTOR_TYPE_SAMPLER:
       return VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;*/
     case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
       return BufferGPUUsage::UniformBuffer;
     case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
       return BufferGPUUsage::StorageBuffer;
     default:
       throw std::runtime_error("Failed to cast DescriptorType to BufferUsage");
@@ -80,16 +68,16 @@ DescriptorBuffer::DescriptorBuffer(Context & ctx, const DescriptorBufferLayout &
 
 DescriptorBuffer::~DescriptorBuffer()
 {
-  vkDestroyDescriptorPool(GetContext().GetGpuConnection().GetDevice(), m_pool, nullptr);
+  ReleaseSets();
 }
 
 DescriptorBuffer::DescriptorBuffer(DescriptorBuffer && rhs) noexcept
   : OwnedBy<Context>(std::move(rhs))
   , OwnedBy<const DescriptorBufferLayout>(std::move(rhs))
 {
-  std::swap(m_pool, rhs.m_pool);
   std::swap(m_sets, rhs.m_sets);
   std::swap(m_cachedLayouts, rhs.m_cachedLayouts);
+  std::swap(m_cachedDescriptions, rhs.m_cachedDescriptions);
   std::swap(m_updateTasks, rhs.m_updateTasks);
 }
 
@@ -99,9 +87,9 @@ DescriptorBuffer & DescriptorBuffer::operator=(DescriptorBuffer && rhs) noexcept
   {
     OwnedBy<Context>::operator=(std::move(rhs));
     OwnedBy<const DescriptorBufferLayout>::operator=(std::move(rhs));
-    std::swap(m_pool, rhs.m_pool);
     std::swap(m_sets, rhs.m_sets);
     std::swap(m_cachedLayouts, rhs.m_cachedLayouts);
+    std::swap(m_cachedDescriptions, rhs.m_cachedDescriptions);
     std::swap(m_updateTasks, rhs.m_updateTasks);
   }
   return *this;
@@ -111,16 +99,33 @@ void DescriptorBuffer::Invalidate()
 {
   if (m_cachedLayouts != GetLayout().GetHandles())
   {
-    auto [newPool, newSets] = GetLayout().AllocDescriptorSets();
-    std::lock_guard lk{m_setsLock};
-    vkDestroyDescriptorPool(GetContext().GetGpuConnection().GetDevice(), m_pool, nullptr);
-    m_pool = newPool;
-    m_sets = std::move(newSets);
-    m_cachedLayouts = GetLayout().GetHandles();
-    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkDescriptorPool & Sets have been rebuilt");
+    auto newSets = GetLayout().AllocDescriptorSets();
+    {
+      std::lock_guard lk{m_setsLock};
+      ReleaseSets();
+      m_sets = std::move(newSets);
+      m_cachedLayouts = GetLayout().GetHandles();
+      m_cachedDescriptions = GetLayout().GetDescriptions();
+    }
+    // new sets could be recycled from other passes, so all descriptors must be written
+    GetLayout().ForEachDescriptor([this](auto && descriptor) { UpdateDescriptor(descriptor); });
+    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkDescriptorSets have been reallocated");
   }
 }
 
+void DescriptorBuffer::ReleaseSets() noexcept
+{
+  assert(m_sets.size() == m_cachedDescriptions.size());
+  auto && allocator = GetContext().GetDescriptorAllocator();
+  for (size_t i = 0; i < m_sets.size(); ++i)
+  {
+    // set of bindless table is owned by context
+    if (m_sets[i] != GetContext().GetBindlessTable().GetHandle())
+      allocator.Release(m_cachedDescriptions[i], m_sets[i]);
+  }
+  m_sets.clear();
+}
+
 
 void DescriptorBuffer::BindToCommandBuffer(const VkCommandBuffer & buffer,
                                            VkPipelineLayout pipelineLayout,
@@ -133,20 +138,129 @@ void DescriptorBuffer::BindToCommandBuffer(const VkCommandBuffer & buffer,
   assert(!m_sets.empty());
   {
     std::lock_guard lk{m_updateDescriptorsLock};
-    for (const GenericUniformPtr & task : m_updateTasks)
+    FlushDescriptorUpdates();
+  }
+  // dynamic descriptors are bound with zero offsets until BindDynamicOffsets is called
+  std::vector<uint32_t> dynamicOffsets(GetLayout().GetDynamicDescriptorsCount(), 0);
+  vkCmdBindDescriptorSets(buffer, bindPoint, pipelineLayout, 0,
+                          static_cast<uint32_t>(m_sets.size()), m_sets.data(),
+                          static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+}
+
+void DescriptorBuffer::FlushDescriptorUpdates()
+{
+  if (m_updateTasks.empty())
+    return;
+
+  // sort updates to merge neighbour array elements and remove repeated updates of one descriptor
+  auto lessPosition = [](const GenericUniformPtr & lhs, const GenericUniformPtr & rhs)
+  { return details::GetDescriptorPosition(lhs) < details::GetDescriptorPosition(rhs); };
+  auto equalPosition = [](const GenericUniformPtr & lhs, const GenericUniformPtr & rhs)
+  { return details::GetDescriptorPosition(lhs) == details::GetDescriptorPosition(rhs); };
+  std::sort(m_updateTasks.begin(), m_updateTasks.end(), lessPosition);
+  m_updateTasks.erase(std::unique(m_updateTasks.begin(), m_updateTasks.end(), equalPosition),
+                      m_updateTasks.end());
+
+  m_writes.clear();
+  m_writesInfoOffsets.clear();
+  m_bufferInfos.clear();
+  m_imageInfos.clear();
+  for (const GenericUniformPtr & task : m_updateTasks)
+    std::visit([this](auto && uniformPtr) { AppendDescriptorWrite(*uniformPtr); }, task);
+  m_updateTasks.clear();
+
+  // arenas could be reallocated while writes are gathered, so pointers are set at the end
+  for (size_t i = 0; i < m_writes.size(); ++i)
+  {
+    auto && write = m_writes[i];
+    if (details::IsBufferDescriptor(write.descriptorType))
+      write.pBufferInfo = m_bufferInfos.data() + m_writesInfoOffsets[i];
+    else
+      write.pImageInfo = m_imageInfos.data() + m_writesInfoOffsets[i];
+  }
+
+  if (!m_writes.empty())
+    vkUpdateDescriptorSets(GetContext().GetGpuConnection().GetDevice(),
+                           static_cast<uint32_t>(m_writes.size()), m_writes.data(), 0, nullptr);
+}
+
+template<typename UniformT>
+void DescriptorBuffer::AppendDescriptorWrite(const UniformT & uniform)
+{
+  constexpr bool isBuffer = std::is_same_v<UniformT, BufferUniform>;
+  assert(isBuffer == details::IsBufferDescriptor(uniform.GetDescriptorType()));
+  auto && infos = [this]() -> auto &
+  {
+    if constexpr (isBuffer)
+      return m_bufferInfos;
+    else
+      return m_imageInfos;
+  }();
+
+  const size_t infoOffset = infos.size();
+  uniform.CreateDescriptorInfo(infos);
+  const auto count = static_cast<uint32_t>(infos.size() - infoOffset);
+  if (count == 0)
+    return;
+
+  const VkDescriptorSet set = m_sets[uniform.GetSet()];
+  assert(set);
+  if (!m_writes.empty())
+  {
+    // continue previous write if it updates previous elements of the same array
+    auto && last = m_writes.back();
+    if (last.dstSet == set && last.dstBinding == uniform.GetBinding() &&
+        last.descriptorType == uniform.GetDescriptorType() &&
+        last.dstArrayElement + last.descriptorCount == uniform.GetArrayIndex() &&
+        m_writesInfoOffsets.back() + last.descriptorCount == infoOffset)
     {
-      std::visit(
-        [this](auto && uniformPtr)
-        {
-          uint32_t setIdx = uniformPtr->GetSet();
-          details::UpdateDescriptorResource(GetContext(), m_sets[setIdx], *uniformPtr);
-        },
-        task);
+      last.descriptorCount += count;
+      return;
     }
-    m_updateTasks.clear();
   }
-  vkCmdBindDescriptorSets(buffer, bindPoint, pipelineLayout, 0,
-                          static_cast<uint32_t>(m_sets.size()), m_sets.data(), 0, nullptr);
+
+  auto && write = m_writes.emplace_back();
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = set;
+  write.dstBinding = uniform.GetBinding();
+  write.dstArrayElement = uniform.GetArrayIndex();
+  write.descriptorType = uniform.GetDescriptorType();
+  write.descriptorCount = count;
+  m_writesInfoOffsets.push_back(infoOffset);
+}
+
+bool DescriptorBuffer::BindDynamicOffsets(details::CommandBuffer & buffer,
+                                          VkPipelineLayout pipelineLayout,
+                                          VkPipelineBindPoint bindPoint, uint32_t set,
+                                          std::span<const uint32_t> offsets)
+{
+  auto reportError = [this](const char * reason)
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                     std::string("Dynamic offsets are ignored - ") + reason);
+    return false;
+  };
+
+  std::lock_guard lk{m_setsLock};
+  if (set >= m_sets.size())
+    return reportError("set is not declared");
+  if (offsets.size() != GetLayout().GetDynamicDescriptorsCount(set))
+    return reportError("count of offsets doesn't match dynamic descriptors");
+
+  const size_t alignment = GetContext().GetDynamicOffsetAlignment();
+  const auto descriptors = GetLayout().GetDynamicDescriptors(set);
+  assert(descriptors.size() == offsets.size());
+  for (size_t i = 0; i < offsets.size(); ++i)
+  {
+    if (offsets[i] % alignment != 0)
+      return reportError("offset is not aligned to IContext::GetDynamicOffsetAlignment()");
+    if (!descriptors[i]->IsDynamicOffsetInRange(offsets[i]))
+      return reportError("offset moves descriptor range out of buffer");
+  }
+
+  buffer.PushCommand(vkCmdBindDescriptorSets, bindPoint, pipelineLayout, set, 1u, &m_sets[set],
+                     static_cast<uint32_t>(offsets.size()), offsets.data());
+  return true;
 }
 
 } // namespace RHI::vulkan
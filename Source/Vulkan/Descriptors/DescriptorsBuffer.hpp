@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <variant>
 #include <vector>
 
@@ -17,6 +18,7 @@ struct DescriptorBufferLayout;
 struct BufferUniform;
 struct SamplerUniform;
 struct SamplerArrayUniform;
+struct StorageImageUniform;
 } // namespace RHI::vulkan
 
 namespace RHI::vulkan
@@ -43,17 +45,37 @@ struct DescriptorBuffer final : public RHI::OwnedBy<Context>,
 
   void BindToCommandBuffer(const VkCommandBuffer & buffer, VkPipelineLayout pipelineLayout,
                            VkPipelineBindPoint bindPoint);
+  /// @brief rebinds one set with new offsets for its dynamic descriptors.
+  /// Invalid offsets are reported to log and the command is dropped
+  /// @return true if command is recorded
+  bool BindDynamicOffsets(details::CommandBuffer & buffer, VkPipelineLayout pipelineLayout,
+                          VkPipelineBindPoint bindPoint, uint32_t set,
+                          std::span<const uint32_t> offsets);
 
 private:
-  using GenericUniformPtr =
-    std::variant<const BufferUniform *, const SamplerUniform *, const SamplerArrayUniform *>;
+  /// @brief returns sets to DescriptorAllocator. They are reused after GPU completes work
+  void ReleaseSets() noexcept;
+  /// @brief writes all pending descriptor updates with one vkUpdateDescriptorSets call
+  void FlushDescriptorUpdates();
+  template<typename UniformT>
+  void AppendDescriptorWrite(const UniformT & uniform);
+
+private:
+  using GenericUniformPtr = std::variant<const BufferUniform *, const SamplerUniform *,
+                                         const SamplerArrayUniform *, const StorageImageUniform *>;
 
   std::mutex m_setsLock;
-  VkDescriptorPool m_pool = VK_NULL_HANDLE;
-  std::vector<VkDescriptorSet> m_sets;
+  std::vector<VkDescriptorSet> m_sets; ///< allocated from context's DescriptorAllocator
   std::vector<VkDescriptorSetLayout> m_cachedLayouts;
+  std::vector<utils::DescriptorSetLayoutBuilder> m_cachedDescriptions;
   std::mutex m_updateDescriptorsLock;
   std::vector<GenericUniformPtr> m_updateTasks;
+
+  // reusable storage for descriptor writes, it's cleared on each flush
+  std::vector<VkWriteDescriptorSet> m_writes;
+  std::vector<size_t> m_writesInfoOffsets; ///< offset of first info of write in info arena
+  std::vector<VkDescriptorBufferInfo> m_bufferInfos;
+  std::vector<VkDescriptorImageInfo> m_imageInfos;
 };
 
 } // namespace RHI::vulkan
@@ -0,0 +1,82 @@
+#include "LayoutCache.hpp"
+
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan
+{
+
+LayoutCache::LayoutCache(Context & ctx)
+  : OwnedBy<Context>(ctx)
+{
+}
+
+LayoutCache::~LayoutCache()
+{
+  auto && gc = GetContext().GetGarbageCollector();
+  m_pipelineLayouts.ForEach([&gc](VkPipelineLayout layout)
+                            { gc.PushVkObjectToDestroy(layout, nullptr); });
+  m_setLayouts.ForEach([&gc](VkDescriptorSetLayout layout)
+                       { gc.PushVkObjectToDestroy(layout, nullptr); });
+}
+
+VkDescriptorSetLayout LayoutCache::AcquireSetLayout(
+  const utils::DescriptorSetLayoutBuilder & description) const
+{
+  std::lock_guard lk{m_lock};
+  return m_setLayouts.Acquire(description,
+                              [this](const utils::DescriptorSetLayoutBuilder & builder)
+                              {
+                                auto layout =
+                                  builder.Make(GetContext().GetGpuConnection().GetDevice());
+                                GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG,
+                                                 "VkDescriptorSetLayout has been created");
+                                return layout;
+                              });
+}
+
+void LayoutCache::ReleaseSetLayout(VkDescriptorSetLayout layout) const noexcept
+{
+  std::lock_guard lk{m_lock};
+  ReleaseSetLayoutLocked(layout);
+}
+
+void LayoutCache::ReleaseSetLayoutLocked(VkDescriptorSetLayout layout) const noexcept
+{
+  // layouts which aren't owned by cache (bindless table) are skipped
+  m_setLayouts.Release(
+    layout, [this](VkDescriptorSetLayout handle, const utils::DescriptorSetLayoutBuilder &)
+    { GetContext().GetGarbageCollector().PushVkObjectToDestroy(handle, nullptr); });
+}
+
+VkPipelineLayout LayoutCache::AcquirePipelineLayout(
+  const utils::PipelineLayoutBuilder & description) const
+{
+  std::lock_guard lk{m_lock};
+  return m_pipelineLayouts.Acquire(
+    description,
+    [this](const utils::PipelineLayoutBuilder & builder)
+    {
+      auto layout = builder.Make(GetContext().GetGpuConnection().GetDevice());
+      // set layouts must live while pipeline layout is cached, otherwise their handles could be
+      // reused by other layouts and the key would become wrong
+      for (VkDescriptorSetLayout setLayout : builder.GetDescriptorSetLayouts())
+        m_setLayouts.AddRef(setLayout);
+      GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkPipelineLayout has been created");
+      return layout;
+    });
+}
+
+void LayoutCache::ReleasePipelineLayout(VkPipelineLayout layout) const noexcept
+{
+  std::lock_guard lk{m_lock};
+  m_pipelineLayouts.Release(
+    layout,
+    [this](VkPipelineLayout handle, const utils::PipelineLayoutBuilder & description)
+    {
+      GetContext().GetGarbageCollector().PushVkObjectToDestroy(handle, nullptr);
+      for (VkDescriptorSetLayout setLayout : description.GetDescriptorSetLayouts())
+        ReleaseSetLayoutLocked(setLayout);
+    });
+}
+
+} // namespace RHI::vulkan
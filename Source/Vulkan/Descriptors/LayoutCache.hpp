@@ -0,0 +1,49 @@
+#pragma once
+#include <mutex>
+
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <Utils/DescriptorSetLayoutBuilder.hpp>
+#include <Utils/PipelineLayoutBuilder.hpp>
+#include <Utils/RefCountedCache.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan
+{
+
+/// @brief context-wide cache of descriptor set layouts and pipeline layouts.
+/// Identically declared layouts are shared between passes, so their descriptor sets are compatible
+/// and stay bound when pipelines are switched. Layouts are ref-counted and destroyed by
+/// GarbageCollector when the last reference is released
+struct LayoutCache final : public OwnedBy<Context>
+{
+  explicit LayoutCache(Context & ctx);
+  ~LayoutCache();
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(LayoutCache);
+
+public:
+  VkDescriptorSetLayout AcquireSetLayout(
+    const utils::DescriptorSetLayoutBuilder & description) const;
+  void ReleaseSetLayout(VkDescriptorSetLayout layout) const noexcept;
+  /// @brief pipeline layout keeps references to its set layouts
+  VkPipelineLayout AcquirePipelineLayout(const utils::PipelineLayoutBuilder & description) const;
+  void ReleasePipelineLayout(VkPipelineLayout layout) const noexcept;
+
+private:
+  void ReleaseSetLayoutLocked(VkDescriptorSetLayout layout) const noexcept;
+
+private:
+  mutable std::mutex m_lock;
+  mutable utils::RefCountedCache<utils::DescriptorSetLayoutBuilder, VkDescriptorSetLayout>
+    m_setLayouts;
+  mutable utils::RefCountedCache<utils::PipelineLayoutBuilder, VkPipelineLayout>
+    m_pipelineLayouts;
+};
+
+} // namespace RHI::vulkan
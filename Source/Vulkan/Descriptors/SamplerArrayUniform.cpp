@@ -18,7 +18,7 @@ SamplerArrayUniform::SamplerArrayUniform(Context & ctx, DescriptorBufferLayout &
 
 SamplerArrayUniform::~SamplerArrayUniform()
 {
-  GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_sampler, nullptr);
+  GetContext().GetSamplerCache().Release(m_sampler);
 }
 
 SamplerArrayUniform::SamplerArrayUniform(SamplerArrayUniform && rhs) noexcept
@@ -48,28 +48,27 @@ VkSampler SamplerArrayUniform::GetHandle() const noexcept
   return m_sampler;
 }
 
-std::vector<VkDescriptorImageInfo> SamplerArrayUniform::CreateDescriptorInfo() const
+void SamplerArrayUniform::CreateDescriptorInfo(std::vector<VkDescriptorImageInfo> & outInfos) const
 {
   assert(m_sampler);
-  std::vector<VkDescriptorImageInfo> infos;
   for (auto * texture : m_boundTextures)
   {
     assert(texture != nullptr);
-    auto && imageInfo = infos.emplace_back();
+    auto && imageInfo = outInfos.emplace_back();
     imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     imageInfo.imageView = texture->GetImageView();
     imageInfo.sampler = m_sampler;
   }
-  return infos;
 }
 
-void SamplerArrayUniform::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer,
-                                                     VkImageLayout layout)
+void SamplerArrayUniform::TransitLayoutForUsedImages(details::BarrierBatch & batch,
+                                                     VkImageLayout layout,
+                                                     VkPipelineStageFlags2 stages)
 {
   for (auto * texture : m_boundTextures)
   {
     if (texture)
-      texture->TransferLayout(commandBuffer, layout);
+      texture->TransferLayout(batch, layout, stages);
   }
 }
 
@@ -77,11 +76,14 @@ void SamplerArrayUniform::Invalidate()
 {
   if (m_invalidSampler || !m_sampler)
   {
-    auto new_sampler = m_builder.Make(GetContext().GetGpuConnection().GetDevice());
-    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "new VkSampler has been created");
-    GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_sampler, nullptr);
+    // samplers with identical state are shared, so handle could stay the same
+    auto new_sampler = GetContext().GetSamplerCache().Acquire(m_builder);
+    GetContext().GetSamplerCache().Release(m_sampler);
+    const bool changed = new_sampler != m_sampler;
     m_sampler = new_sampler;
     m_invalidSampler = false;
+    if (changed)
+      GetLayout().GetDescriptorsOwner().OnDescriptorChanged(*this);
   }
 }
 
@@ -94,7 +96,7 @@ void SamplerArrayUniform::AssignImage(uint32_t index, ITexture * image)
 {
   m_boundTextures[index] = image ? dynamic_cast<IInternalTexture *>(image)
                                  : dynamic_cast<IInternalTexture *>(GetContext().GetNullTexture());
-  GetLayout().GetConfiguration().GetSubpass().OnDescriptorChanged(*this);
+  GetLayout().GetDescriptorsOwner().OnDescriptorChanged(*this);
 }
 
 
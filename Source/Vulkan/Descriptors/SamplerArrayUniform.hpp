@@ -25,8 +25,11 @@ public: // ISamplerDescriptor interface
                          RHI::TextureFilteration magFilter) noexcept override;
 
 public:
-  std::vector<VkDescriptorImageInfo> CreateDescriptorInfo() const;
-  void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer, VkImageLayout layout);
+  /// @brief appends infos of descriptor into outInfos
+  void CreateDescriptorInfo(std::vector<VkDescriptorImageInfo> & outInfos) const;
+  /// @param stages - shader stages which use images of descriptor
+  void TransitLayoutForUsedImages(details::BarrierBatch & batch, VkImageLayout layout,
+                                  VkPipelineStageFlags2 stages);
 
 public: // IUniformDescriptor interface
   virtual uint32_t GetSet() const noexcept override { return BaseUniform::GetSet(); }
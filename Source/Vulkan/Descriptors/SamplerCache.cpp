@@ -0,0 +1,45 @@
+#include "SamplerCache.hpp"
+
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan
+{
+
+SamplerCache::SamplerCache(Context & ctx)
+  : OwnedBy<Context>(ctx)
+{
+}
+
+SamplerCache::~SamplerCache()
+{
+  m_samplers.ForEach(
+    [this](VkSampler sampler)
+    { GetContext().GetGarbageCollector().PushVkObjectToDestroy(sampler, nullptr); });
+}
+
+VkSampler SamplerCache::Acquire(const utils::SamplerBuilder & description) const
+{
+  std::lock_guard lk{m_lock};
+  return m_samplers.Acquire(description,
+                            [this](const utils::SamplerBuilder & builder)
+                            {
+                              auto sampler =
+                                builder.Make(GetContext().GetGpuConnection().GetDevice());
+                              GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG,
+                                               "new VkSampler has been created");
+                              return sampler;
+                            });
+}
+
+void SamplerCache::Release(VkSampler sampler) const noexcept
+{
+  if (!sampler)
+    return;
+  std::lock_guard lk{m_lock};
+  // sampler could be used by commands in flight, so it's destroyed by GarbageCollector
+  m_samplers.Release(
+    sampler, [this](VkSampler handle, const utils::SamplerBuilder &)
+    { GetContext().GetGarbageCollector().PushVkObjectToDestroy(handle, nullptr); });
+}
+
+} // namespace RHI::vulkan
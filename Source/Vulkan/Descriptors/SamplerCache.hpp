@@ -0,0 +1,38 @@
+#pragma once
+#include <mutex>
+
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <Utils/RefCountedCache.hpp>
+#include <Utils/SamplerBuilder.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan
+{
+
+/// @brief context-wide cache of samplers. Samplers with identical state are shared between all
+/// descriptors and destroyed when the last reference is released
+struct SamplerCache final : public OwnedBy<Context>
+{
+  explicit SamplerCache(Context & ctx);
+  ~SamplerCache();
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(SamplerCache);
+
+public:
+  /// @brief returns sampler with described state and adds reference to it
+  VkSampler Acquire(const utils::SamplerBuilder & description) const;
+  /// @brief removes reference to sampler. Unused sampler is destroyed by GarbageCollector
+  void Release(VkSampler sampler) const noexcept;
+
+private:
+  mutable std::mutex m_lock;
+  mutable utils::RefCountedCache<utils::SamplerBuilder, VkSampler> m_samplers;
+};
+
+} // namespace RHI::vulkan
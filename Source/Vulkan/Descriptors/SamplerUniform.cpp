@@ -8,9 +8,10 @@ namespace RHI::vulkan
 {
 
 SamplerUniform::SamplerUniform(Context & ctx, DescriptorBufferLayout & owner, VkDescriptorType type,
-                               LayoutIndex index, uint32_t arrayIndex)
+                               LayoutIndex index, uint32_t arrayIndex, bool immutable)
   : BaseUniform(ctx, owner, type, index, arrayIndex)
   , ISamplerUniformDescriptor()
+  , m_immutable(immutable)
 {
   m_builder.Reset();
   AssignImage(nullptr);
@@ -18,7 +19,7 @@ SamplerUniform::SamplerUniform(Context & ctx, DescriptorBufferLayout & owner, Vk
 
 SamplerUniform::~SamplerUniform()
 {
-  GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_sampler, nullptr);
+  GetContext().GetSamplerCache().Release(m_sampler);
 }
 
 SamplerUniform::SamplerUniform(SamplerUniform && rhs) noexcept
@@ -29,6 +30,7 @@ SamplerUniform::SamplerUniform(SamplerUniform && rhs) noexcept
   std::swap(rhs.m_sampler, m_sampler);
   std::swap(rhs.m_invalidSampler, m_invalidSampler);
   std::swap(rhs.m_builder, m_builder);
+  std::swap(rhs.m_immutable, m_immutable);
 }
 
 SamplerUniform & SamplerUniform::operator=(SamplerUniform && rhs) noexcept
@@ -40,6 +42,7 @@ SamplerUniform & SamplerUniform::operator=(SamplerUniform && rhs) noexcept
     std::swap(rhs.m_sampler, m_sampler);
     std::swap(rhs.m_invalidSampler, m_invalidSampler);
     std::swap(rhs.m_builder, m_builder);
+    std::swap(rhs.m_immutable, m_immutable);
   }
   return *this;
 }
@@ -49,33 +52,35 @@ VkSampler SamplerUniform::GetHandle() const noexcept
   return m_sampler;
 }
 
-std::vector<VkDescriptorImageInfo> SamplerUniform::CreateDescriptorInfo() const
+void SamplerUniform::CreateDescriptorInfo(std::vector<VkDescriptorImageInfo> & outInfos) const
 {
   assert(m_sampler);
   assert(m_boundTexture);
-  VkDescriptorImageInfo imageInfo{};
+  auto && imageInfo = outInfos.emplace_back();
   imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
   imageInfo.imageView = m_boundTexture->GetImageView();
   imageInfo.sampler = m_sampler;
-  return {imageInfo};
 }
 
-void SamplerUniform::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer,
-                                                 VkImageLayout layout)
+void SamplerUniform::TransitLayoutForUsedImages(details::BarrierBatch & batch, VkImageLayout layout,
+                                                VkPipelineStageFlags2 stages)
 {
   if (m_boundTexture)
-    m_boundTexture->TransferLayout(commandBuffer, layout);
+    m_boundTexture->TransferLayout(batch, layout, stages);
 }
 
 void SamplerUniform::Invalidate()
 {
   if (m_invalidSampler || !m_sampler)
   {
-    auto new_sampler = m_builder.Make(GetContext().GetGpuConnection().GetDevice());
-    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "new VkSampler has been created");
-    GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_sampler, nullptr);
+    // samplers with identical state are shared, so handle could stay the same
+    auto new_sampler = GetContext().GetSamplerCache().Acquire(m_builder);
+    GetContext().GetSamplerCache().Release(m_sampler);
+    const bool changed = new_sampler != m_sampler;
     m_sampler = new_sampler;
     m_invalidSampler = false;
+    if (changed)
+      GetLayout().GetDescriptorsOwner().OnDescriptorChanged(*this);
   }
 }
 
@@ -88,7 +93,7 @@ void SamplerUniform::AssignImage(ITexture * image)
 {
   m_boundTexture = image ? dynamic_cast<IInternalTexture *>(image)
                          : dynamic_cast<IInternalTexture *>(GetContext().GetNullTexture());
-  GetLayout().GetConfiguration().GetSubpass().OnDescriptorChanged(*this);
+  GetLayout().GetDescriptorsOwner().OnDescriptorChanged(*this);
 }
 
 void SamplerUniform::SetWrapping(RHI::TextureWrapping uWrap, RHI::TextureWrapping vWrap,
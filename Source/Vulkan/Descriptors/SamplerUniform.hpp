@@ -12,8 +12,9 @@ namespace RHI::vulkan
 struct SamplerUniform final : public ISamplerUniformDescriptor,
                               public details::BaseUniform
 {
+  /// @param immutable - sampler is baked into descriptor set layout
   explicit SamplerUniform(Context & ctx, DescriptorBufferLayout & owner, VkDescriptorType type,
-                          LayoutIndex index, uint32_t arrayIndex = 0);
+                          LayoutIndex index, uint32_t arrayIndex = 0, bool immutable = false);
   virtual ~SamplerUniform() override;
   SamplerUniform(SamplerUniform && rhs) noexcept;
   SamplerUniform & operator=(SamplerUniform && rhs) noexcept;
@@ -28,8 +29,11 @@ public: // ISamplerUniformDescriptor interface
   virtual void AssignImage(ITexture * image) override;
 
 public:
-  std::vector<VkDescriptorImageInfo> CreateDescriptorInfo() const;
-  void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer, VkImageLayout layout);
+  /// @brief appends infos of descriptor into outInfos
+  void CreateDescriptorInfo(std::vector<VkDescriptorImageInfo> & outInfos) const;
+  /// @param stages - shader stages which use images of descriptor
+  void TransitLayoutForUsedImages(details::BarrierBatch & batch, VkImageLayout layout,
+                                  VkPipelineStageFlags2 stages);
 
 public: // IUniformDescriptor interface
   virtual uint32_t GetSet() const noexcept override { return BaseUniform::GetSet(); }
@@ -42,6 +46,7 @@ public: // IInvalidable interface
 
 public: // public internal API
   VkSampler GetHandle() const noexcept;
+  bool IsImmutable() const noexcept { return m_immutable; }
   using BaseUniform::GetDescriptorType;
 
 private:
@@ -49,6 +54,7 @@ private:
   VkSampler m_sampler = VK_NULL_HANDLE;
   utils::SamplerBuilder m_builder;
   bool m_invalidSampler = true;
+  bool m_immutable = false;
 };
 
 } // namespace RHI::vulkan
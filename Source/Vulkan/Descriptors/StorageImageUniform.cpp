@@ -0,0 +1,72 @@
+#include "StorageImageUniform.hpp"
+
+#include <Descriptors/DescriptorBufferLayout.hpp>
+#include <Resources/Texture.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan
+{
+
+StorageImageUniform::StorageImageUniform(Context & ctx, DescriptorBufferLayout & owner,
+                                         VkDescriptorType type, LayoutIndex index,
+                                         uint32_t arrayIndex)
+  : BaseUniform(ctx, owner, type, index, arrayIndex)
+  , IStorageImageDescriptor()
+{
+}
+
+StorageImageUniform::StorageImageUniform(StorageImageUniform && rhs) noexcept
+  : BaseUniform(std::move(rhs))
+  , IStorageImageDescriptor()
+{
+  std::swap(rhs.m_boundTexture, m_boundTexture);
+}
+
+StorageImageUniform & StorageImageUniform::operator=(StorageImageUniform && rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    BaseUniform::operator=(std::move(rhs));
+    std::swap(rhs.m_boundTexture, m_boundTexture);
+  }
+  return *this;
+}
+
+void StorageImageUniform::AssignImage(ITexture * image)
+{
+  // storage image can't be unbound without nullDescriptor feature, so bound view would stay
+  if (!image)
+    throw std::invalid_argument("Storage image can't be unassigned");
+  auto * texture = dynamic_cast<Texture *>(image);
+  if (!texture || !texture->GetStorageImageView())
+    throw std::invalid_argument(
+      "Texture can't be used as storage image. Create it with TextureUsage::Storage");
+
+  m_boundTexture = texture;
+  GetLayout().GetDescriptorsOwner().OnDescriptorChanged(*this);
+}
+
+bool StorageImageUniform::IsImageAssigned() const noexcept
+{
+  return m_boundTexture != nullptr;
+}
+
+void StorageImageUniform::CreateDescriptorInfo(std::vector<VkDescriptorImageInfo> & outInfos) const
+{
+  if (!m_boundTexture)
+    return;
+  auto && imageInfo = outInfos.emplace_back();
+  imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+  imageInfo.imageView = m_boundTexture->GetStorageImageView();
+  imageInfo.sampler = VK_NULL_HANDLE;
+}
+
+void StorageImageUniform::TransitLayoutForUsedImages(details::BarrierBatch & batch,
+                                                     VkImageLayout layout,
+                                                     VkPipelineStageFlags2 stages)
+{
+  if (m_boundTexture)
+    m_boundTexture->TransferLayout(batch, layout, stages);
+}
+
+} // namespace RHI::vulkan
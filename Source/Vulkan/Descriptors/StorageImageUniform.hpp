@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Descriptors/BaseUniform.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Texture;
+namespace details
+{
+struct BarrierBatch;
+}
+} // namespace RHI::vulkan
+
+namespace RHI::vulkan
+{
+
+struct StorageImageUniform final : public IStorageImageDescriptor,
+                                   public details::BaseUniform
+{
+  explicit StorageImageUniform(Context & ctx, DescriptorBufferLayout & owner,
+                               VkDescriptorType type, LayoutIndex index, uint32_t arrayIndex = 0);
+  virtual ~StorageImageUniform() override = default;
+  StorageImageUniform(StorageImageUniform && rhs) noexcept;
+  StorageImageUniform & operator=(StorageImageUniform && rhs) noexcept;
+
+public: // IStorageImageDescriptor interface
+  virtual void AssignImage(ITexture * image) override;
+  virtual bool IsImageAssigned() const noexcept override;
+
+public:
+  /// @brief appends infos of descriptor into outInfos
+  void CreateDescriptorInfo(std::vector<VkDescriptorImageInfo> & outInfos) const;
+  /// @param stages - shader stages which use images of descriptor
+  void TransitLayoutForUsedImages(details::BarrierBatch & batch, VkImageLayout layout,
+                                  VkPipelineStageFlags2 stages);
+
+public: // IUniformDescriptor interface
+  virtual uint32_t GetSet() const noexcept override { return BaseUniform::GetSet(); }
+  virtual uint32_t GetBinding() const noexcept override { return BaseUniform::GetBinding(); }
+  virtual uint32_t GetArrayIndex() const noexcept override { return BaseUniform::GetArrayIndex(); }
+
+public: // public internal API
+  using BaseUniform::GetDescriptorType;
+
+private:
+  Texture * m_boundTexture = nullptr;
+};
+
+} // namespace RHI::vulkan
@@ -1,7 +1,9 @@
 
 #include "Device.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <format>
 
 #include <VkBootstrap.h>
 #include <vulkan/vulkan.h>
@@ -89,6 +91,28 @@ vkb::PhysicalDevice SelectPhysicalDevice(vkb::Instance inst, const RHI::GpuTrait
   return phys_ret.value();
 }
 
+/// @brief one queue in every family and several queues in graphics family
+std::vector<vkb::CustomQueueDescription> MakeQueuesDescriptions(
+  const vkb::PhysicalDevice & gpu, uint32_t graphicsQueuesCount, uint32_t & resultGraphicsCount)
+{
+  std::vector<vkb::CustomQueueDescription> result;
+  resultGraphicsCount = 1;
+  bool graphicsFound = false;
+  auto && families = gpu.get_queue_families();
+  for (uint32_t i = 0; i < static_cast<uint32_t>(families.size()); ++i)
+  {
+    uint32_t count = 1;
+    if (!graphicsFound && (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+    {
+      count = std::min(graphicsQueuesCount, families[i].queueCount);
+      resultGraphicsCount = count;
+      graphicsFound = true;
+    }
+    result.emplace_back(i, std::vector<float>(count, 1.0f));
+  }
+  return result;
+}
+
 struct DeviceInternal final
 {
   explicit DeviceInternal(const RHI::GpuTraits & gpuTraits, RHI::vulkan::Context & ctx);
@@ -99,8 +123,19 @@ struct DeviceInternal final
   VkPhysicalDevice GetPhysicalDevice() const noexcept { return physicalDevice; }
   const VkPhysicalDeviceProperties & GetGpuProperties() const & noexcept;
   bool GetQueue(vkb::QueueType type, uint32_t & resultFamily, VkQueue & resultQueue) const noexcept;
+  std::vector<VkQueue> GetGraphicsQueues(uint32_t family) const;
+  const RHI::vulkan::DeviceFeatures & GetEnabledFeatures() const & noexcept
+  {
+    return enabledFeatures;
+  }
+
+private:
+  /// @brief enables optional features which are supported by GPU
+  void EnableOptionalFeatures();
 
 private:
+  RHI::vulkan::DeviceFeatures enabledFeatures;
+  uint32_t graphicsQueuesCount = 1;
   vkb::Instance instance;
   vkb::PhysicalDevice physicalDevice;
   vkb::Device device;
@@ -114,7 +149,13 @@ DeviceInternal::DeviceInternal(const RHI::GpuTraits & gpuTraits, RHI::vulkan::Co
   physicalDevice = SelectPhysicalDevice(instance, gpuTraits, VulkanAPIVersionPair);
   ctx.Log(RHI::LogMessageStatus::LOG_DEBUG,
           "VkPhysicalDevice has been selected successfully - " + physicalDevice.name);
+  EnableOptionalFeatures();
+
   vkb::DeviceBuilder device_builder{physicalDevice};
+  // by default vk-bootstrap creates one queue per family
+  if (gpuTraits.graphics_queues_count > 1)
+    device_builder.custom_queue_setup(MakeQueuesDescriptions(
+      physicalDevice, gpuTraits.graphics_queues_count, graphicsQueuesCount));
   auto dev_ret = device_builder.build();
   if (!dev_ret)
   {
@@ -125,6 +166,77 @@ DeviceInternal::DeviceInternal(const RHI::GpuTraits & gpuTraits, RHI::vulkan::Co
   dispatchTable = device.make_table();
 }
 
+void DeviceInternal::EnableOptionalFeatures()
+{
+  VkPhysicalDeviceFeatures features{};
+  features.multiDrawIndirect = VK_TRUE;
+  features.drawIndirectFirstInstance = VK_TRUE;
+  enabledFeatures.multiDrawIndirect = physicalDevice.enable_features_if_present(features);
+
+  if (physicalDevice.enable_extension_if_present(VK_NV_INHERITED_VIEWPORT_SCISSOR_EXTENSION_NAME))
+  {
+    VkPhysicalDeviceInheritedViewportScissorFeaturesNV inheritedViewport{};
+    inheritedViewport.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INHERITED_VIEWPORT_SCISSOR_FEATURES_NV;
+    inheritedViewport.inheritedViewportScissor2D = VK_TRUE;
+    enabledFeatures.inheritedViewportScissor =
+      physicalDevice.enable_extension_features_if_present(inheritedViewport);
+  }
+
+  if (physicalDevice.properties.apiVersion < VK_API_VERSION_1_2)
+    return;
+
+  // Vulkan 1.2/1.3 features are requested with one struct, so only supported ones are enabled
+  const bool vulkan13 = physicalDevice.properties.apiVersion >= VK_API_VERSION_1_3;
+  VkPhysicalDeviceVulkan13Features supported13{};
+  supported13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+  VkPhysicalDeviceVulkan12Features supported{};
+  supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+  supported.pNext = vulkan13 ? &supported13 : nullptr;
+  VkPhysicalDeviceFeatures2 features2{};
+  features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  features2.pNext = &supported;
+  vkGetPhysicalDeviceFeatures2(physicalDevice.physical_device, &features2);
+
+  // features for bindless textures. They are enabled only if GPU supports all of them
+  const bool descriptorIndexing = supported.shaderSampledImageArrayNonUniformIndexing &&
+                                  supported.descriptorBindingSampledImageUpdateAfterBind &&
+                                  supported.descriptorBindingUpdateUnusedWhilePending &&
+                                  supported.descriptorBindingPartiallyBound &&
+                                  supported.descriptorBindingVariableDescriptorCount &&
+                                  supported.runtimeDescriptorArray;
+
+  VkPhysicalDeviceVulkan12Features requested{};
+  requested.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+  if (descriptorIndexing)
+  {
+    requested.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    requested.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    requested.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    requested.descriptorBindingPartiallyBound = VK_TRUE;
+    requested.descriptorBindingVariableDescriptorCount = VK_TRUE;
+    requested.runtimeDescriptorArray = VK_TRUE;
+  }
+  requested.drawIndirectCount = supported.drawIndirectCount;
+
+  if (physicalDevice.enable_extension_features_if_present(requested))
+  {
+    enabledFeatures.descriptorIndexing = descriptorIndexing;
+    enabledFeatures.drawIndirectCount = requested.drawIndirectCount == VK_TRUE;
+  }
+
+  if (vulkan13 && (supported13.dynamicRendering || supported13.synchronization2))
+  {
+    VkPhysicalDeviceVulkan13Features requested13{};
+    requested13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    requested13.dynamicRendering = supported13.dynamicRendering;
+    requested13.synchronization2 = supported13.synchronization2;
+    const bool enabled13 = physicalDevice.enable_extension_features_if_present(requested13);
+    enabledFeatures.dynamicRendering = enabled13 && requested13.dynamicRendering == VK_TRUE;
+    enabledFeatures.synchronization2 = enabled13 && requested13.synchronization2 == VK_TRUE;
+  }
+}
+
 DeviceInternal::~DeviceInternal()
 {
   vkb::destroy_device(device);
@@ -148,6 +260,14 @@ bool DeviceInternal::GetQueue(vkb::QueueType type, uint32_t & resultFamily,
   return true;
 }
 
+std::vector<VkQueue> DeviceInternal::GetGraphicsQueues(uint32_t family) const
+{
+  std::vector<VkQueue> result(graphicsQueuesCount, VK_NULL_HANDLE);
+  for (uint32_t i = 0; i < graphicsQueuesCount; ++i)
+    vkGetDeviceQueue(device.device, family, i, &result[i]);
+  return result;
+}
+
 } // namespace
 
 namespace RHI::vulkan
@@ -161,6 +281,10 @@ Device::Device(Context & ctx, const GpuTraits & gpuTraits)
 
   privData->GetQueue(vkb::QueueType::graphics, m_queues[QueueType::Graphics].first,
                      m_queues[QueueType::Graphics].second);
+  m_graphicsQueues = privData->GetGraphicsQueues(m_queues[QueueType::Graphics].first);
+  if (m_graphicsQueues.size() > 1)
+    ctx.Log(RHI::LogMessageStatus::LOG_DEBUG,
+            std::format("{} graphics queues have been created", m_graphicsQueues.size()));
 
   if (!privData->GetQueue(vkb::QueueType::transfer, m_queues[QueueType::Transfer].first,
                           m_queues[QueueType::Transfer].second))
@@ -173,6 +297,15 @@ Device::Device(Context & ctx, const GpuTraits & gpuTraits)
   if (!privData->GetQueue(vkb::QueueType::present, m_queues[QueueType::Present].first,
                           m_queues[QueueType::Present].second))
     m_queues[QueueType::Present] = m_queues[QueueType::Graphics];
+
+  m_computeSharingFamilies.push_back(m_queues[QueueType::Graphics].first);
+  if (m_queues[QueueType::Compute].first != m_queues[QueueType::Graphics].first)
+    m_computeSharingFamilies.push_back(m_queues[QueueType::Compute].first);
+
+  m_features = privData->GetEnabledFeatures();
+  m_features.geometryShader = gpuTraits.require_geometry_shaders;
+  // extended dynamic state is a part of core since Vulkan 1.3
+  m_features.extendedDynamicState = GetVulkanVersion() >= VK_API_VERSION_1_3;
 }
 
 Device::~Device()
@@ -212,6 +345,26 @@ std::pair<uint32_t, VkQueue> Device::GetQueue(QueueType type) const
   return m_queues[type];
 }
 
+uint32_t Device::GetGraphicsQueuesCount() const noexcept
+{
+  return static_cast<uint32_t>(m_graphicsQueues.size());
+}
+
+VkQueue Device::GetGraphicsQueue(uint32_t index) const noexcept
+{
+  return m_graphicsQueues[index % m_graphicsQueues.size()];
+}
+
+const std::vector<uint32_t> & Device::GetComputeSharingFamilies() const & noexcept
+{
+  return m_computeSharingFamilies;
+}
+
+std::unique_lock<std::mutex> Device::LockQueues() const
+{
+  return std::unique_lock{m_queuesLock};
+}
+
 uint32_t Device::GetVulkanVersion() const noexcept
 {
   return GetGpuProperties().apiVersion;
@@ -1,5 +1,7 @@
 #pragma once
 #include <array>
+#include <mutex>
+#include <vector>
 
 #include <Private/OwnedBy.hpp>
 #include <RHI.hpp>
@@ -21,6 +23,29 @@ enum QueueType : uint8_t
   Total
 };
 
+/// @brief optional GPU capabilities. They are used only if device supports them
+struct DeviceFeatures final
+{
+  /// depth/stencil, culling and topology states can be set in command buffer (Vulkan 1.3)
+  bool extendedDynamicState = false;
+  /// partially bound, update-after-bind and variable sized arrays of sampled images (Vulkan 1.2)
+  bool descriptorIndexing = false;
+  /// several draws in one indirect command
+  bool multiDrawIndirect = false;
+  /// count of indirect draws is read from buffer (Vulkan 1.2)
+  bool drawIndirectCount = false;
+  /// secondary command buffers inherit viewport and scissor (VK_NV_inherited_viewport_scissor)
+  bool inheritedViewportScissor = false;
+  /// rendering without VkRenderPass and VkFramebuffer objects (Vulkan 1.3)
+  bool dynamicRendering = false;
+  /// vkCmdPipelineBarrier2 with per-barrier stage masks (Vulkan 1.3)
+  bool synchronization2 = false;
+  /// geometry shader stage. It's enabled only if GpuTraits requires it
+  bool geometryShader = false;
+  /// tessellation shader stages. They aren't enabled now
+  bool tessellationShader = false;
+};
+
 struct Device final : public OwnedBy<Context>
 {
   explicit Device(Context & ctx, const GpuTraits & gpuTraits);
@@ -31,11 +56,26 @@ struct Device final : public OwnedBy<Context>
   VkPhysicalDevice GetGPU() const noexcept;
   const VkPhysicalDeviceProperties & GetGpuProperties() const & noexcept;
   std::pair<uint32_t, VkQueue> GetQueue(QueueType type) const;
+  /// @brief queues of graphics family. The first one is returned by GetQueue(Graphics)
+  uint32_t GetGraphicsQueuesCount() const noexcept;
+  /// @param index - index of queue, it's wrapped by count of queues
+  VkQueue GetGraphicsQueue(uint32_t index) const noexcept;
+  /// @brief distinct families of graphics and compute queues. Resources used by compute passes
+  /// are shared between them concurrently, because compute submits aren't ordered with frames
+  const std::vector<uint32_t> & GetComputeSharingFamilies() const & noexcept;
+  /// @brief queue commands (submit, present, wait idle) must be externally synchronized.
+  /// Queues of different types can be the same queue, so one lock is used for all of them
+  std::unique_lock<std::mutex> LockQueues() const;
   uint32_t GetVulkanVersion() const noexcept;
+  const DeviceFeatures & GetFeatures() const & noexcept { return m_features; }
 
 private:
   std::array<uint8_t, 9216> m_privateData; ///< private data. You can change size if it doesn't compile
   std::array<std::pair<uint32_t, VkQueue>, QueueType::Total> m_queues;
+  std::vector<VkQueue> m_graphicsQueues;
+  std::vector<uint32_t> m_computeSharingFamilies;
+  DeviceFeatures m_features;
+  mutable std::mutex m_queuesLock;
 };
 
 } // namespace RHI::vulkan
@@ -1,75 +1,104 @@
 #include "ImageLayoutTransferer.hpp"
 
+#include <algorithm>
+#include <optional>
+
+#include <CommandsExecution/BarrierBatch.hpp>
 #include <CommandsExecution/CommandBuffer.hpp>
 #include <ImageUtils/InternalImageTraits.hpp>
 #include <Utils/CastHelper.hpp>
 
 namespace
 {
-constexpr VkAccessFlags LayoutTransfer_MakeAccessFlag(VkImageLayout layout) noexcept
+// only flags of Vulkan 1.0 are used, so they are valid for legacy barriers too
+constexpr VkAccessFlags2 LayoutTransfer_MakeAccessFlag(VkImageLayout layout) noexcept
 {
   switch (layout)
   {
     case VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL:
-      return VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+      return VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+             VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
 
     case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-      return VK_ACCESS_SHADER_READ_BIT;
+      return VK_ACCESS_2_SHADER_READ_BIT;
 
     case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL:
     case VK_IMAGE_LAYOUT_STENCIL_READ_ONLY_OPTIMAL:
-      return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+      return VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
 
     case VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL:
     case VK_IMAGE_LAYOUT_ATTACHMENT_FEEDBACK_LOOP_OPTIMAL_EXT:
-      return VK_ACCESS_SHADER_WRITE_BIT;
+      return VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+             VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
     case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-      return VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+      return VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
 
     case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL:
     case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-      return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_STENCIL_READ_ONLY_OPTIMAL:
+    case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL:
+      return VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+             VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
-    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: //   
-      return VK_ACCESS_TRANSFER_WRITE_BIT;
-    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: //   
-      return VK_ACCESS_TRANSFER_READ_BIT;
+    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: // image is read by transfer
+      return VK_ACCESS_2_TRANSFER_READ_BIT;
+    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: // image is written by transfer
+      return VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+    case VK_IMAGE_LAYOUT_GENERAL: // storage image
+      return VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
 
-    case VK_IMAGE_LAYOUT_GENERAL:
     case VK_IMAGE_LAYOUT_PREINITIALIZED:
     case VK_IMAGE_LAYOUT_UNDEFINED:
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: // visibility for presentation is made by semaphores
     default:
-      return 0;
+      return VK_ACCESS_2_NONE;
   }
 }
 
-constexpr VkPipelineStageFlags LayoutTransfer_MakePipelineStage(VkImageLayout layout) noexcept
+constexpr VkPipelineStageFlags2 LayoutTransfer_MakePipelineStage(VkImageLayout layout) noexcept
 {
   switch (layout)
   {
     case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: // shader sampler
-      return VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    case VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL:
+      return VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
 
     case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: // transfering
     case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-      return VK_PIPELINE_STAGE_TRANSFER_BIT;
+      return VK_PIPELINE_STAGE_2_TRANSFER_BIT;
 
     case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: // color attachment
-      return VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: // swapchain image is acquired and presented at this stage
+      return VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
 
     case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL: // depth/stencil attachment
     case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
     case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_STENCIL_READ_ONLY_OPTIMAL:
     case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL:
-      return VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL:
+    case VK_IMAGE_LAYOUT_STENCIL_READ_ONLY_OPTIMAL:
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+      return VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+             VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+
+    case VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL:
+    case VK_IMAGE_LAYOUT_ATTACHMENT_FEEDBACK_LOOP_OPTIMAL_EXT:
+      return VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+             VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+             VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+
+    case VK_IMAGE_LAYOUT_GENERAL: // storage image can be used in any shader stage
+      return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
 
     case VK_IMAGE_LAYOUT_PREINITIALIZED:
     case VK_IMAGE_LAYOUT_UNDEFINED:
-      return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+      return VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT;
     default:
       assert(false);
-      return VK_PIPELINE_STAGE_NONE;
+      return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
   }
 }
 
@@ -77,63 +106,204 @@ constexpr VkPipelineStageFlags LayoutTransfer_MakePipelineStage(VkImageLayout la
 
 namespace RHI::vulkan
 {
-ImageLayoutTransferer::ImageLayoutTransferer(VkImage image)
+ImageLayoutTransferer::ImageLayoutTransferer(VkImage image, VkImageAspectFlags aspect,
+                                             uint32_t mipLevels, uint32_t layersCount)
   : m_image(image)
+  , m_aspect(aspect)
+  , m_layersCount(layersCount)
+  , m_mips(mipLevels, MipState{LayersState{0, layersCount}})
 {
 }
 
 
 ImageLayoutTransferer::ImageLayoutTransferer(ImageLayoutTransferer && rhs) noexcept
 {
+  std::lock_guard lk{rhs.m_lock};
   std::swap(m_image, rhs.m_image);
-  rhs.m_layout = m_layout.exchange(rhs.m_layout.load());
+  std::swap(m_aspect, rhs.m_aspect);
+  std::swap(m_layersCount, rhs.m_layersCount);
+  std::swap(m_mips, rhs.m_mips);
 }
 
 ImageLayoutTransferer & ImageLayoutTransferer::operator=(ImageLayoutTransferer && rhs) noexcept
 {
   if (this != &rhs)
   {
+    std::scoped_lock lk{m_lock, rhs.m_lock};
     std::swap(m_image, rhs.m_image);
-    rhs.m_layout = m_layout.exchange(rhs.m_layout.load());
+    std::swap(m_aspect, rhs.m_aspect);
+    std::swap(m_layersCount, rhs.m_layersCount);
+    std::swap(m_mips, rhs.m_mips);
   }
   return *this;
 }
 
 void ImageLayoutTransferer::TransferLayout(VkImageLayout newLayout) noexcept
 {
-  if (newLayout != VK_IMAGE_LAYOUT_UNDEFINED && newLayout != VK_IMAGE_LAYOUT_PREINITIALIZED)
-    m_layout = newLayout;
+  if (newLayout == VK_IMAGE_LAYOUT_UNDEFINED || newLayout == VK_IMAGE_LAYOUT_PREINITIALIZED)
+    return;
+  std::lock_guard lk{m_lock};
+  for (auto && mip : m_mips)
+  {
+    mip.resize(1);
+    mip.front() = LayersState{0, m_layersCount, newLayout};
+  }
 }
 
 void ImageLayoutTransferer::TransferLayout(details::CommandBuffer & commandBuffer,
-                                           VkImageLayout newLayout) noexcept
+                                           VkImageLayout newLayout,
+                                           const VkImageSubresourceRange & range)
 {
-  if (newLayout == VK_IMAGE_LAYOUT_UNDEFINED || newLayout == VK_IMAGE_LAYOUT_PREINITIALIZED ||
-      newLayout == m_layout)
+  // transition is merged with barriers which are already collected for the command buffer
+  TransferLayout(commandBuffer.GetBarriers(), newLayout, VK_PIPELINE_STAGE_2_NONE, range);
+  commandBuffer.FlushBarriers();
+}
+
+void ImageLayoutTransferer::TransferLayout(details::BarrierBatch & batch, VkImageLayout newLayout,
+                                           VkPipelineStageFlags2 stages,
+                                           const VkImageSubresourceRange & range)
+{
+  if (newLayout == VK_IMAGE_LAYOUT_UNDEFINED || newLayout == VK_IMAGE_LAYOUT_PREINITIALIZED)
     return;
-  VkImageMemoryBarrier barrier{};
+  if (stages == VK_PIPELINE_STAGE_2_NONE)
+    stages = LayoutTransfer_MakePipelineStage(newLayout);
+
+  std::lock_guard lk{m_lock};
+  const uint32_t mipsCount = static_cast<uint32_t>(m_mips.size());
+  const uint32_t baseMip = std::min(range.baseMipLevel, mipsCount);
+  const uint32_t mipsEnd = range.levelCount == VK_REMAINING_MIP_LEVELS
+                             ? mipsCount
+                             : std::min(baseMip + range.levelCount, mipsCount);
+  const uint32_t baseLayer = std::min(range.baseArrayLayer, m_layersCount);
+  const uint32_t layersEnd = range.layerCount == VK_REMAINING_ARRAY_LAYERS
+                               ? m_layersCount
+                               : std::min(baseLayer + range.layerCount, m_layersCount);
+
+  std::vector<VkImageMemoryBarrier2> barriers;
+  for (uint32_t mipLevel = baseMip; mipLevel < mipsEnd; ++mipLevel)
   {
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = m_layout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = m_image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
-    barrier.srcAccessMask = LayoutTransfer_MakeAccessFlag(m_layout);
-    barrier.dstAccessMask = LayoutTransfer_MakeAccessFlag(newLayout);
+    auto && mip = m_mips[mipLevel];
+    SplitLayers(mip, baseLayer);
+    SplitLayers(mip, layersEnd);
+    for (auto && state : mip)
+    {
+      if (state.baseLayer < baseLayer || state.baseLayer >= layersEnd ||
+          state.layout == newLayout)
+        continue;
+
+      // content of undefined image isn't waited for, but transition must follow semaphore waits
+      const VkPipelineStageFlags2 srcStages = state.layout == VK_IMAGE_LAYOUT_UNDEFINED ? stages
+                                              : state.stages != VK_PIPELINE_STAGE_2_NONE
+                                                ? state.stages
+                                                : LayoutTransfer_MakePipelineStage(state.layout);
+
+      // the same layers of neighbour mip levels are transfered with one barrier
+      auto it = std::find_if(barriers.begin(), barriers.end(),
+                             [&state, srcStages, mipLevel](const VkImageMemoryBarrier2 & barrier)
+                             {
+                               auto && subresource = barrier.subresourceRange;
+                               return subresource.baseMipLevel + subresource.levelCount ==
+                                        mipLevel &&
+                                      subresource.baseArrayLayer == state.baseLayer &&
+                                      subresource.layerCount == state.layersCount &&
+                                      barrier.oldLayout == state.layout &&
+                                      barrier.srcStageMask == srcStages;
+                             });
+      if (it != barriers.end())
+      {
+        it->subresourceRange.levelCount++;
+      }
+      else
+      {
+        VkImageMemoryBarrier2 & barrier = barriers.emplace_back();
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.srcStageMask = srcStages;
+        barrier.srcAccessMask = LayoutTransfer_MakeAccessFlag(state.layout);
+        barrier.dstStageMask = stages;
+        barrier.dstAccessMask = LayoutTransfer_MakeAccessFlag(newLayout);
+        barrier.oldLayout = state.layout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_image;
+        barrier.subresourceRange.aspectMask = m_aspect;
+        barrier.subresourceRange.baseMipLevel = mipLevel;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = state.baseLayer;
+        barrier.subresourceRange.layerCount = state.layersCount;
+      }
+      state.layout = newLayout;
+      state.stages = stages;
+    }
+    MergeLayers(mip);
   }
 
-  VkPipelineStageFlags sourceStage = LayoutTransfer_MakePipelineStage(m_layout);
-  VkPipelineStageFlags destinationStage = LayoutTransfer_MakePipelineStage(newLayout);
+  for (auto && barrier : barriers)
+    batch.AddImageBarrier(barrier);
+}
 
-  m_layout = newLayout;
-  commandBuffer.PushCommand(vkCmdPipelineBarrier, sourceStage, destinationStage, 0, 0, nullptr, 0,
-                            nullptr, 1, &barrier);
+VkImageLayout ImageLayoutTransferer::GetLayout(const VkImageSubresourceRange & range) const noexcept
+{
+  std::lock_guard lk{m_lock};
+  const uint32_t mipsCount = static_cast<uint32_t>(m_mips.size());
+  const uint32_t baseMip = std::min(range.baseMipLevel, mipsCount);
+  const uint32_t mipsEnd = range.levelCount == VK_REMAINING_MIP_LEVELS
+                             ? mipsCount
+                             : std::min(baseMip + range.levelCount, mipsCount);
+  const uint32_t baseLayer = range.baseArrayLayer;
+  const uint32_t layersEnd = range.layerCount == VK_REMAINING_ARRAY_LAYERS
+                               ? m_layersCount
+                               : baseLayer + range.layerCount;
+
+  std::optional<VkImageLayout> result;
+  for (uint32_t mipLevel = baseMip; mipLevel < mipsEnd; ++mipLevel)
+  {
+    for (auto && state : m_mips[mipLevel])
+    {
+      // skip ranges which don't intersect with requested layers
+      if (state.baseLayer + state.layersCount <= baseLayer || state.baseLayer >= layersEnd)
+        continue;
+      if (result.has_value() && *result != state.layout)
+        return VK_IMAGE_LAYOUT_UNDEFINED;
+      result = state.layout;
+    }
+  }
+  return result.value_or(VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
+void ImageLayoutTransferer::SplitLayers(MipState & mip, uint32_t layer)
+{
+  auto it = std::find_if(mip.begin(), mip.end(),
+                         [layer](const LayersState & state)
+                         {
+                           return state.baseLayer < layer &&
+                                  layer < state.baseLayer + state.layersCount;
+                         });
+  if (it == mip.end())
+    return;
+  LayersState tail = *it;
+  tail.baseLayer = layer;
+  tail.layersCount = it->baseLayer + it->layersCount - layer;
+  it->layersCount = layer - it->baseLayer;
+  mip.insert(std::next(it), tail);
+}
+
+void ImageLayoutTransferer::MergeLayers(MipState & mip) noexcept
+{
+  auto prev = mip.begin();
+  for (auto it = std::next(prev); it != mip.end(); ++it)
+  {
+    if (it->layout == prev->layout && it->stages == prev->stages)
+    {
+      prev->layersCount += it->layersCount;
+    }
+    else
+    {
+      ++prev;
+      *prev = *it;
+    }
+  }
+  mip.erase(std::next(prev), mip.end());
 }
 
 } // namespace RHI::vulkan
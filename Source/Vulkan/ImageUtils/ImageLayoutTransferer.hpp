@@ -1,6 +1,9 @@
 #pragma once
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
+#include <ImageUtils/TextureInterface.hpp>
 #include <Memory/MemoryBlock.hpp>
 #include <Private/OwnedBy.hpp>
 #include <RHI.hpp>
@@ -13,29 +16,61 @@ struct BufferedTexture;
 namespace details
 {
 struct CommandBuffer;
-}
+struct BarrierBatch;
+} // namespace details
 } // namespace RHI::vulkan
 
 namespace RHI::vulkan
 {
+/// @brief tracks layouts of image subresources. Each mip level keeps sorted ranges of array layers
+/// with the same layout, neighbour ranges with the same state are merged
 struct ImageLayoutTransferer final
 {
-  explicit ImageLayoutTransferer(VkImage image);
+  explicit ImageLayoutTransferer(VkImage image,
+                                 VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+                                 uint32_t mipLevels = 1, uint32_t layersCount = 1);
   ~ImageLayoutTransferer() = default;
   ImageLayoutTransferer(ImageLayoutTransferer && rhs) noexcept;
   ImageLayoutTransferer & operator=(ImageLayoutTransferer && rhs) noexcept;
   RESTRICTED_COPY(ImageLayoutTransferer);
 
 public:
+  /// @brief only updates tracked layout of whole image
   void TransferLayout(VkImageLayout newLayout) noexcept;
-  void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout newLayout) noexcept;
+  void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout newLayout,
+                      const VkImageSubresourceRange & range = g_WholeImageRange);
+  /// @brief appends transitions into batch. Subresources which are already in newLayout are skipped
+  /// @param stages - stages which use image in newLayout, if none they are deduced from layout
+  void TransferLayout(details::BarrierBatch & batch, VkImageLayout newLayout,
+                      VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE,
+                      const VkImageSubresourceRange & range = g_WholeImageRange);
 
   VkImage GetHandle() const noexcept { return m_image; }
-  VkImageLayout GetLayout() const noexcept { return m_layout; }
+  VkImageAspectFlags GetAspect() const noexcept { return m_aspect; }
+  /// @brief layout of subresources or VK_IMAGE_LAYOUT_UNDEFINED if their layouts are different
+  VkImageLayout GetLayout(const VkImageSubresourceRange & range = g_WholeImageRange) const noexcept;
 
-protected:
-  VkImage m_image = VK_NULL_HANDLE;                                ///< handle of vulkan image
-  std::atomic<VkImageLayout> m_layout = VK_IMAGE_LAYOUT_UNDEFINED; ///< image layout
+private:
+  /// @brief state of continuous range of array layers in one mip level
+  struct LayersState
+  {
+    uint32_t baseLayer = 0;
+    uint32_t layersCount = 0;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE; ///< stages used layers in layout
+  };
+  using MipState = std::vector<LayersState>;
+
+  /// @brief splits range of layers which contains layer, so a new range begins with it
+  static void SplitLayers(MipState & mip, uint32_t layer);
+  static void MergeLayers(MipState & mip) noexcept;
+
+private:
+  VkImage m_image = VK_NULL_HANDLE;                        ///< handle of vulkan image
+  VkImageAspectFlags m_aspect = VK_IMAGE_ASPECT_COLOR_BIT; ///< aspects used in barriers
+  uint32_t m_layersCount = 1;
+  std::vector<MipState> m_mips; ///< layouts of layers for each mip level
+  mutable std::mutex m_lock;
 };
 
 } // namespace RHI::vulkan
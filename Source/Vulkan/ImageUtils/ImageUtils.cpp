@@ -3,10 +3,16 @@
 namespace RHI::vulkan::utils
 {
 VkImageView CreateImageView(VkDevice device, VkImage image, VkFormat format, VkImageViewType type,
-                            VkImageAspectFlags aspectFlags)
+                            VkImageAspectFlags aspectFlags, VkImageUsageFlags usage)
 {
+  // restricts usage of view if image has usages which aren't supported by view's format
+  VkImageViewUsageCreateInfo usageInfo{};
+  usageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO;
+  usageInfo.usage = usage;
+
   VkImageViewCreateInfo viewInfo{};
   viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.pNext = usage != 0 ? &usageInfo : nullptr;
   viewInfo.image = image;
   viewInfo.viewType = type;
   viewInfo.format = format;
@@ -5,5 +5,5 @@
 namespace RHI::vulkan::utils
 {
 VkImageView CreateImageView(VkDevice device, VkImage image, VkFormat format, VkImageViewType type,
-                            VkImageAspectFlags aspectFlags);
+                            VkImageAspectFlags aspectFlags, VkImageUsageFlags usage = 0);
 }
@@ -6,18 +6,38 @@
 namespace RHI::vulkan::details
 {
 struct CommandBuffer;
-}
+struct BarrierBatch;
+} // namespace RHI::vulkan::details
 
 namespace RHI::vulkan
 {
+/// @brief all mip levels and array layers of image (aspect is defined by image)
+static constexpr VkImageSubresourceRange g_WholeImageRange{0, 0, VK_REMAINING_MIP_LEVELS, 0,
+                                                           VK_REMAINING_ARRAY_LAYERS};
 
 struct IInternalTexture
 {
   virtual ~IInternalTexture() = default;
   virtual VkImageView GetImageView() const noexcept = 0;
   virtual void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout) = 0;
+  /// @brief transfers layout of mip levels and array layers in range only
+  virtual void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout,
+                              const VkImageSubresourceRange & range) = 0;
+  /// @brief appends transition into batch, which is recorded later
+  /// @param stages - stages which use the image in new layout
+  virtual void TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                              VkPipelineStageFlags2 stages) = 0;
+  /// @brief only updates tracked layout, transition is recorded by somebody else
+  virtual void TransferLayout(VkImageLayout layout) noexcept = 0;
+  /// @brief layout of whole image or VK_IMAGE_LAYOUT_UNDEFINED if subresources have different ones
   virtual VkImageLayout GetLayout() const noexcept = 0;
+  virtual VkImageLayout GetLayout(const VkImageSubresourceRange & range) const noexcept = 0;
   virtual VkImage GetHandle() const noexcept = 0;
+  /// @brief aspects of image used in barriers and views
+  virtual VkImageAspectFlags GetAspect() const noexcept = 0;
+  /// @brief true if image is shared concurrently with compute queue family, so there is no
+  /// ownership transfer for it
+  virtual bool IsSharedWithCompute() const noexcept = 0;
   virtual VkFormat GetInternalFormat() const noexcept = 0;
   virtual VkExtent3D GetInternalExtent() const noexcept = 0;
   virtual uint32_t GetMipLevelsCount() const noexcept = 0;
@@ -38,15 +38,16 @@ MemoryAllocator::~MemoryAllocator()
 }
 
 MemoryBlock MemoryAllocator::AllocBuffer(size_t size, VkBufferUsageFlags usage,
-                                         bool allowHostAccess)
+                                         bool allowHostAccess, VkSharingMode shareMode)
 {
-  return MemoryBlock(*this, size, usage, allowHostAccess);
+  return MemoryBlock(*this, size, usage, allowHostAccess, shareMode);
 }
 
 MemoryBlock MemoryAllocator::AllocImage(const TextureDescription & description,
-                                        VkImageUsageFlags usage, VkSampleCountFlagBits samples, VkSharingMode shareMode)
+                                        VkImageUsageFlags usage, VkSampleCountFlagBits samples,
+                                        VkSharingMode shareMode, VkImageCreateFlags createFlags)
 {
-  return MemoryBlock(*this, description, usage, samples, shareMode);
+  return MemoryBlock(*this, description, usage, samples, shareMode, createFlags);
 }
 
 } // namespace RHI::vulkan::memory
@@ -24,11 +24,13 @@ struct MemoryAllocator final : public OwnedBy<Context>
 public:
   AllocatorHandle GetHandle() const noexcept { return m_allocator; }
 
-  MemoryBlock AllocBuffer(size_t size, VkBufferUsageFlags usage, bool allowHostAccess);
+  MemoryBlock AllocBuffer(size_t size, VkBufferUsageFlags usage, bool allowHostAccess,
+                          VkSharingMode shareMode = VK_SHARING_MODE_EXCLUSIVE);
 
   MemoryBlock AllocImage(const TextureDescription & description, VkImageUsageFlags usage,
                          VkSampleCountFlagBits samples,
-                         VkSharingMode shareMode = VK_SHARING_MODE_EXCLUSIVE);
+                         VkSharingMode shareMode = VK_SHARING_MODE_EXCLUSIVE,
+                         VkImageCreateFlags createFlags = 0);
 
 private:
   AllocatorHandle m_allocator;
@@ -2,6 +2,7 @@
 
 #include <Utils/CastHelper.hpp>
 #include <vk_mem_alloc.h>
+#include <VulkanContext.hpp>
 
 #include "MemoryAllocator.hpp"
 
@@ -47,6 +48,24 @@ constexpr VmaAllocationCreateFlags CalcAllocationFlags<VkImageUsageFlagBits>(
   return VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
 }
 
+/// @brief concurrent resources are shared between graphics and compute queue families
+template<typename CreateInfoT>
+void SetSharingMode(CreateInfoT & info, VkSharingMode shareMode,
+                    const std::vector<uint32_t> & queueFamilies) noexcept
+{
+  // concurrent sharing requires several families
+  if (shareMode == VK_SHARING_MODE_CONCURRENT && queueFamilies.size() > 1)
+  {
+    info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    info.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+    info.pQueueFamilyIndices = queueFamilies.data();
+  }
+  else
+  {
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  }
+}
+
 } // namespace
 
 namespace RHI::vulkan::memory
@@ -54,12 +73,13 @@ namespace RHI::vulkan::memory
 
 MemoryBlock::MemoryBlock(MemoryAllocator & allocator, const TextureDescription & description,
                          VkImageUsageFlags usage, VkSampleCountFlagBits samples,
-                         VkSharingMode shareMode)
+                         VkSharingMode shareMode, VkImageCreateFlags createFlags)
   : OwnedBy<MemoryAllocator>(allocator)
 {
   VkImageCreateInfo imageInfo{};
   {
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.flags = createFlags;
     imageInfo.imageType = utils::CastInterfaceEnum2Vulkan<VkImageType>(description.type);
     imageInfo.extent.width = description.extent[0];
     imageInfo.extent.height = description.extent[1];
@@ -74,12 +94,15 @@ MemoryBlock::MemoryBlock(MemoryAllocator & allocator, const TextureDescription &
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     imageInfo.usage = usage;
     imageInfo.samples = samples;
-    imageInfo.sharingMode = shareMode;
+    SetSharingMode(imageInfo, shareMode,
+                   GetAllocator().GetContext().GetGpuConnection().GetComputeSharingFamilies());
   }
   VmaAllocationCreateFlags allocFlags =
     CalcAllocationFlags(static_cast<VkImageUsageFlagBits>(usage), false);
   VmaAllocationCreateInfo allocCreateInfo = {};
-  allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+  allocCreateInfo.usage = (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+                            ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED
+                            : VMA_MEMORY_USAGE_AUTO;
   allocCreateInfo.flags = allocFlags;
   allocCreateInfo.priority = 1.0f;
 
@@ -87,9 +110,16 @@ MemoryBlock::MemoryBlock(MemoryAllocator & allocator, const TextureDescription &
   VmaAllocation allocation;
   VmaAllocationInfo allocInfo;
   auto * allocatorHandle = reinterpret_cast<VmaAllocator>(GetAllocator().GetHandle());
-  if (auto res = vmaCreateImage(allocatorHandle, &imageInfo, &allocCreateInfo, &image, &allocation,
-                                &allocInfo);
-      res != VK_SUCCESS)
+  auto res = vmaCreateImage(allocatorHandle, &imageInfo, &allocCreateInfo, &image, &allocation,
+                            &allocInfo);
+  // lazily allocated memory exists mostly on tiled GPUs, other ones use device local memory
+  if (res != VK_SUCCESS && allocCreateInfo.usage == VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED)
+  {
+    allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    res = vmaCreateImage(allocatorHandle, &imageInfo, &allocCreateInfo, &image, &allocation,
+                         &allocInfo);
+  }
+  if (res != VK_SUCCESS)
     throw std::invalid_argument("Failed to create VkImage");
 
   m_image = image;
@@ -97,16 +127,19 @@ MemoryBlock::MemoryBlock(MemoryAllocator & allocator, const TextureDescription &
   m_allocInfo = reinterpret_cast<AllocInfoRawMemory &>(allocInfo);
   m_flags = allocFlags;
   m_size = allocInfo.size;
+  m_sharingMode = imageInfo.sharingMode;
 }
 
 MemoryBlock::MemoryBlock(MemoryAllocator & allocator, size_t size, VkBufferUsageFlags usage,
-                         bool allowHostAccess)
+                         bool allowHostAccess, VkSharingMode shareMode)
   : OwnedBy<MemoryAllocator>(allocator)
 {
   VkBufferCreateInfo bufferInfo{};
   bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
   bufferInfo.size = size;
   bufferInfo.usage = usage;
+  SetSharingMode(bufferInfo, shareMode,
+                 GetAllocator().GetContext().GetGpuConnection().GetComputeSharingFamilies());
 
   VmaAllocationCreateFlags allocationFlags =
     CalcAllocationFlags(static_cast<VkBufferUsageFlagBits>(usage), allowHostAccess);
@@ -128,6 +161,7 @@ MemoryBlock::MemoryBlock(MemoryAllocator & allocator, size_t size, VkBufferUsage
   m_allocInfo = reinterpret_cast<AllocInfoRawMemory &>(allocInfo);
   m_size = std::min(allocInfo.size, size); // MemoryAllocator can alloc more then needed
   m_flags = allocationFlags;
+  m_sharingMode = bufferInfo.sharingMode;
 }
 
 MemoryBlock::MemoryBlock(MemoryBlock && rhs) noexcept
@@ -139,6 +173,7 @@ MemoryBlock::MemoryBlock(MemoryBlock && rhs) noexcept
   std::swap(m_flags, rhs.m_flags);
   std::swap(m_memBlock, rhs.m_memBlock);
   std::swap(m_size, rhs.m_size);
+  std::swap(m_sharingMode, rhs.m_sharingMode);
 }
 
 MemoryBlock & MemoryBlock::operator=(MemoryBlock && rhs) noexcept
@@ -152,6 +187,7 @@ MemoryBlock & MemoryBlock::operator=(MemoryBlock && rhs) noexcept
     std::swap(m_flags, rhs.m_flags);
     std::swap(m_memBlock, rhs.m_memBlock);
     std::swap(m_size, rhs.m_size);
+    std::swap(m_sharingMode, rhs.m_sharingMode);
   }
   return *this;
 }
@@ -23,10 +23,12 @@ private:
   /// create memory block for image
   explicit MemoryBlock(MemoryAllocator & allocator, const TextureDescription & description,
                        VkImageUsageFlags usage, VkSampleCountFlagBits samples,
-                       VkSharingMode shareMode = VK_SHARING_MODE_EXCLUSIVE);
+                       VkSharingMode shareMode = VK_SHARING_MODE_EXCLUSIVE,
+                       VkImageCreateFlags createFlags = 0);
   /// Create memory block for buffer
   explicit MemoryBlock(MemoryAllocator & allocator, size_t size, VkBufferUsageFlags usage,
-                       bool allowHostAccess);
+                       bool allowHostAccess,
+                       VkSharingMode shareMode = VK_SHARING_MODE_EXCLUSIVE);
 
 public:
   bool UploadSync(const void * data, size_t size, size_t offset = 0);
@@ -37,6 +39,7 @@ public:
   size_t Size() const noexcept { return m_size; }
   VkImage GetImage() const noexcept { return m_image; }
   VkBuffer GetBuffer() const noexcept { return m_buffer; }
+  VkSharingMode GetSharingMode() const noexcept { return m_sharingMode; }
   operator bool() const noexcept;
 
 private:
@@ -49,6 +52,7 @@ private:
   VkBuffer m_buffer = VK_NULL_HANDLE;
   size_t m_size = 0;
   uint32_t m_flags = 0;
+  VkSharingMode m_sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 };
 
 } // namespace RHI::vulkan::memory
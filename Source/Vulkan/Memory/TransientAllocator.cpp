@@ -0,0 +1,115 @@
+#include "TransientAllocator.hpp"
+
+#include <algorithm>
+
+#include <VulkanContext.hpp>
+
+namespace
+{
+constexpr VkBufferUsageFlags g_transientBufferUsage =
+  VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+} // namespace
+
+namespace RHI::vulkan::memory
+{
+TransientAllocator::TransientAllocator(Context & ctx, size_t pageSize, uint32_t pagesCount)
+  : OwnedBy<Context>(ctx)
+  , m_pageSize(pageSize)
+  , m_pagesCount(pagesCount)
+{
+  assert(m_pagesCount > 0);
+}
+
+TransientAllocator::~TransientAllocator()
+{
+  m_mappedMemory.reset();
+  m_overflowBuffers.clear();
+}
+
+TransientAllocation TransientAllocator::Allocate(size_t size, size_t alignment)
+{
+  std::lock_guard lk{m_lock};
+  if (!m_buffer)
+    InitBuffer();
+
+  if (alignment == 0)
+    alignment = GetContext().GetDynamicOffsetAlignment();
+  const size_t alignedOffset = (m_pageOffset + alignment - 1) / alignment * alignment;
+  if (alignedOffset + size > m_pageSize)
+    return AllocateOverflow(size, alignment);
+
+  m_pageOffset = alignedOffset + size;
+  const size_t offset = m_activePage * m_pageSize + alignedOffset;
+
+  TransientAllocation result{};
+  result.data = m_mappedMemory.get() + offset;
+  result.buffer = m_buffer.get();
+  result.offset = offset;
+  result.size = size;
+  return result;
+}
+
+void TransientAllocator::EndFrame(details::FrameFences::FrameIndex frame)
+{
+  std::lock_guard lk{m_lock};
+  if (!m_buffer)
+    return;
+
+  m_buffer->Flush();
+  for (auto && overflow : m_overflowBuffers[m_activePage])
+  {
+    if (overflow.offset > 0)
+      overflow.buffer->Flush();
+  }
+  m_pagesFrames[m_activePage] = frame;
+
+  m_activePage = (m_activePage + 1) % m_pagesCount;
+  m_pageOffset = 0;
+  GetContext().GetFrameFences().WaitForCompleted(m_pagesFrames[m_activePage]);
+  for (auto && overflow : m_overflowBuffers[m_activePage])
+    overflow.offset = 0;
+}
+
+void TransientAllocator::InitBuffer()
+{
+  m_buffer = std::make_unique<BufferGPU>(GetContext(), m_pageSize * m_pagesCount,
+                                         g_transientBufferUsage, true);
+  m_mappedMemory = m_buffer->Map();
+  m_overflowBuffers.resize(m_pagesCount);
+  // pages which weren't ended by any frame are free
+  m_pagesFrames.assign(m_pagesCount, 0);
+  GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "Transient memory buffer has been allocated");
+}
+
+TransientAllocation TransientAllocator::AllocateOverflow(size_t size, size_t alignment)
+{
+  auto alignOffset = [alignment](size_t offset)
+  { return (offset + alignment - 1) / alignment * alignment; };
+  auto && pageBuffers = m_overflowBuffers[m_activePage];
+  auto hasSpace = [size, &alignOffset](const OverflowBuffer & overflow)
+  { return alignOffset(overflow.offset) + size <= overflow.buffer->Size(); };
+  auto it = std::find_if(pageBuffers.begin(), pageBuffers.end(), hasSpace);
+  if (it == pageBuffers.end())
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_WARNING,
+                     "Transient memory page is overflowed, separate buffer is allocated");
+    auto && overflow = pageBuffers.emplace_back();
+    // the next overflowed allocations of the page fit into the same buffer
+    overflow.buffer = std::make_unique<BufferGPU>(GetContext(), std::max(size, m_pageSize),
+                                                  g_transientBufferUsage, true);
+    overflow.mappedMemory = overflow.buffer->Map();
+    it = std::prev(pageBuffers.end());
+  }
+
+  const size_t offset = alignOffset(it->offset);
+  it->offset = offset + size;
+
+  TransientAllocation result{};
+  result.data = it->mappedMemory.get() + offset;
+  result.buffer = it->buffer.get();
+  result.offset = offset;
+  result.size = size;
+  return result;
+}
+
+} // namespace RHI::vulkan::memory
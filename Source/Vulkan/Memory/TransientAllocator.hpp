@@ -0,0 +1,68 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <CommandsExecution/FrameFences.hpp>
+#include <Private/OwnedBy.hpp>
+#include <Resources/BufferGPU.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+}
+
+namespace RHI::vulkan::memory
+{
+
+/// @brief linear allocator of per-frame memory (uniforms, per-draw data).
+/// It owns one persistently mapped host-visible buffer splitted into pages, one page per frame.
+/// Page is reused when GPU completes all work submitted before the end of its frame.
+/// Frames are ended by context after framebuffers submit them
+struct TransientAllocator final : public OwnedBy<Context>
+{
+  static constexpr size_t kDefaultPageSize = 4 * 1024 * 1024;
+  static constexpr uint32_t kDefaultPagesCount = 3;
+
+  explicit TransientAllocator(Context & ctx, size_t pageSize = kDefaultPageSize,
+                              uint32_t pagesCount = kDefaultPagesCount);
+  ~TransientAllocator();
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(TransientAllocator);
+
+public:
+  /// @brief allocates memory in current page. If page has no enough space, memory is allocated
+  /// in separate buffer which is reused together with the page
+  TransientAllocation Allocate(size_t size, size_t alignment);
+  /// @brief finishes current page and waits while next page is released by GPU
+  /// @param frame - frame which is ended with current page
+  void EndFrame(details::FrameFences::FrameIndex frame);
+
+private:
+  /// @brief buffer for allocations which don't fit into page
+  struct OverflowBuffer
+  {
+    std::unique_ptr<BufferGPU> buffer;
+    IBufferGPU::ScopedPointer mappedMemory; ///< unmapped before buffer is destroyed
+    size_t offset = 0;                      ///< 0 if buffer is unused in its page
+  };
+
+private:
+  void InitBuffer();
+  TransientAllocation AllocateOverflow(size_t size, size_t alignment);
+
+private:
+  size_t m_pageSize;
+  uint32_t m_pagesCount;
+  std::mutex m_lock;
+  std::unique_ptr<BufferGPU> m_buffer; ///< allocated on first use
+  IBufferGPU::ScopedPointer m_mappedMemory;
+  std::vector<details::FrameFences::FrameIndex> m_pagesFrames; ///< frame which ended each page
+  std::vector<std::vector<OverflowBuffer>> m_overflowBuffers; ///< buffers of each page
+  uint32_t m_activePage = 0;
+  size_t m_pageOffset = 0;
+};
+
+} // namespace RHI::vulkan::memory
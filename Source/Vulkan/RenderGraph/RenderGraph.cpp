@@ -0,0 +1,249 @@
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+
+#include <ComputePass/ComputePass.hpp>
+#include <ImageUtils/TextureInterface.hpp>
+#include <Resources/BufferGPU.hpp>
+#include <Utils/CastHelper.hpp>
+#include <VulkanContext.hpp>
+
+namespace
+{
+/// passes keep fences of two last submits, so older executions are completed by the next submits
+constexpr size_t g_keptExecutionsCount = 2;
+
+RHI::vulkan::IInternalTexture & CastTexture(RHI::ITexture & texture)
+{
+  auto * result = dynamic_cast<RHI::vulkan::IInternalTexture *>(&texture);
+  if (!result)
+    throw std::invalid_argument("Failed to cast ITexture to IInternalTexture");
+  return *result;
+}
+} // namespace
+
+namespace RHI::vulkan
+{
+RenderGraph::RenderGraph(Context & ctx)
+  : OwnedBy<Context>(ctx)
+{
+}
+
+uint32_t RenderGraph::AddComputePass(IComputePass & pass, RecordFunc && recordFunc)
+{
+  auto && node = m_passes.emplace_back();
+  node.pass = &utils::CastInterfaceClass2Internal<ComputePass>(pass);
+  node.recordFunc = std::move(recordFunc);
+  return static_cast<uint32_t>(m_passes.size() - 1);
+}
+
+void RenderGraph::ReadTexture(uint32_t passIndex, ITexture & texture)
+{
+  GetTextureUsage(passIndex, texture).read = true;
+}
+
+void RenderGraph::WriteTexture(uint32_t passIndex, ITexture & texture)
+{
+  GetTextureUsage(passIndex, texture).write = true;
+}
+
+void RenderGraph::ReadBuffer(uint32_t passIndex, const IBufferGPU & buffer)
+{
+  GetBufferUsage(passIndex, buffer).read = true;
+}
+
+void RenderGraph::WriteBuffer(uint32_t passIndex, const IBufferGPU & buffer)
+{
+  GetBufferUsage(passIndex, buffer).write = true;
+}
+
+void RenderGraph::MarkOutput(ITexture & texture)
+{
+  m_outputs.insert(&CastTexture(texture));
+}
+
+void RenderGraph::MarkOutput(const IBufferGPU & buffer)
+{
+  m_outputs.insert(&utils::CastInterfaceClass2Internal<BufferGPU>(buffer));
+}
+
+IAwaitable * RenderGraph::Execute()
+{
+  CullPasses();
+
+  details::ResourceAccessTracker tracker;
+  std::vector<IAwaitable *> tasks;
+  for (auto && node : m_passes)
+  {
+    if (node.culled)
+      continue;
+
+    // barriers are built while pass is recorded, so tracked layouts are changed only if
+    // they are really recorded
+    // they are flushed by pass together with transitions of its descriptors
+    auto recordBarriers = [this, &node, &tracker](details::CommandBuffer & commandBuffer)
+    {
+      auto && batch = commandBuffer.GetBarriers();
+      for (auto && usage : node.textures)
+        AddTextureBarrier(batch, tracker, usage);
+      for (auto && usage : node.buffers)
+        AddBufferBarrier(batch, tracker, usage);
+    };
+
+    if (!node.pass->BeginPass(recordBarriers))
+    {
+      GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                       "RenderGraph: compute pass can't be recorded, it's skipped");
+      continue;
+    }
+    if (node.recordFunc)
+      node.recordFunc(*node.pass);
+    node.pass->EndPass();
+    if (auto * task = node.pass->Submit())
+      tasks.push_back(task);
+  }
+
+  auto && executionTask = m_executionTasks.emplace_back();
+  executionTask.SetTasks(std::move(tasks));
+  while (m_executionTasks.size() > g_keptExecutionsCount)
+  {
+    m_executionTasks.front().Wait();
+    m_executionTasks.pop_front();
+  }
+  return &executionTask;
+}
+
+void RenderGraph::Reset()
+{
+  m_passes.clear();
+  m_outputs.clear();
+  m_culledPassesCount = 0;
+}
+
+RenderGraph::PassNode & RenderGraph::GetNode(uint32_t passIndex)
+{
+  if (passIndex >= m_passes.size())
+    throw std::invalid_argument("RenderGraph has no pass with such index");
+  return m_passes[passIndex];
+}
+
+RenderGraph::TextureUsage & RenderGraph::GetTextureUsage(uint32_t passIndex, ITexture & texture)
+{
+  auto && textures = GetNode(passIndex).textures;
+  auto * internalTexture = &CastTexture(texture);
+  auto it = std::find_if(textures.begin(), textures.end(), [internalTexture](auto && usage)
+                         { return usage.texture == internalTexture; });
+  return it != textures.end() ? *it : textures.emplace_back(TextureUsage{internalTexture});
+}
+
+RenderGraph::BufferUsage & RenderGraph::GetBufferUsage(uint32_t passIndex,
+                                                       const IBufferGPU & buffer)
+{
+  auto && buffers = GetNode(passIndex).buffers;
+  auto * internalBuffer = &utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  auto it = std::find_if(buffers.begin(), buffers.end(), [internalBuffer](auto && usage)
+                         { return usage.buffer == internalBuffer; });
+  return it != buffers.end() ? *it : buffers.emplace_back(BufferUsage{internalBuffer});
+}
+
+void RenderGraph::CullPasses()
+{
+  m_culledPassesCount = 0;
+  if (m_outputs.empty())
+  {
+    for (auto && node : m_passes)
+      node.culled = false;
+    return;
+  }
+
+  // go from the last pass to the first one and collect resources needed by outputs
+  std::unordered_set<const void *> required = m_outputs;
+  for (auto it = m_passes.rbegin(); it != m_passes.rend(); ++it)
+  {
+    auto && node = *it;
+    const bool contributes =
+      std::any_of(node.textures.begin(), node.textures.end(),
+                  [&required](auto && usage)
+                  { return usage.write && required.contains(usage.texture); }) ||
+      std::any_of(node.buffers.begin(), node.buffers.end(),
+                  [&required](auto && usage)
+                  { return usage.write && required.contains(usage.buffer); });
+    node.culled = !contributes;
+    if (node.culled)
+    {
+      ++m_culledPassesCount;
+      continue;
+    }
+
+    for (auto && usage : node.textures)
+      if (usage.read)
+        required.insert(usage.texture);
+    for (auto && usage : node.buffers)
+      if (usage.read)
+        required.insert(usage.buffer);
+  }
+}
+
+void RenderGraph::AddTextureBarrier(details::BarrierBatch & batch,
+                                    details::ResourceAccessTracker & tracker,
+                                    const TextureUsage & usage) const
+{
+  const VkImageLayout oldLayout = usage.texture->GetLayout();
+  const VkImageLayout newLayout =
+    usage.write ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+  const auto dependency =
+    tracker.Access(usage.texture, usage.read, usage.write, oldLayout != newLayout);
+  if (!dependency)
+    return;
+
+  if (oldLayout != newLayout)
+  {
+    // subresources could be in different layouts, so texture makes barrier for each of them
+    usage.texture->TransferLayout(batch, newLayout, dependency->dstStages);
+  }
+  else
+  {
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = dependency->srcStages;
+    barrier.srcAccessMask = dependency->srcAccess;
+    barrier.dstStageMask = dependency->dstStages;
+    barrier.dstAccessMask = dependency->dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = usage.texture->GetHandle();
+    barrier.subresourceRange.aspectMask = usage.texture->GetAspect();
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    batch.AddImageBarrier(barrier);
+  }
+}
+
+void RenderGraph::AddBufferBarrier(details::BarrierBatch & batch,
+                                   details::ResourceAccessTracker & tracker,
+                                   const BufferUsage & usage) const
+{
+  const auto dependency = tracker.Access(usage.buffer, usage.read, usage.write);
+  if (!dependency)
+    return;
+
+  VkBufferMemoryBarrier2 barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+  barrier.srcStageMask = dependency->srcStages;
+  barrier.srcAccessMask = dependency->srcAccess;
+  barrier.dstStageMask = dependency->dstStages;
+  barrier.dstAccessMask = dependency->dstAccess;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.buffer = usage.buffer->GetHandle();
+  barrier.offset = 0;
+  barrier.size = VK_WHOLE_SIZE;
+  batch.AddBufferBarrier(barrier);
+}
+
+} // namespace RHI::vulkan
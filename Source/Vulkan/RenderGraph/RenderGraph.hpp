@@ -0,0 +1,93 @@
+#pragma once
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+#include <CommandsExecution/BarrierBatch.hpp>
+#include <CommandsExecution/CompositeAsyncTask.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RenderGraph/ResourceAccessTracker.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+struct ComputePass;
+struct BufferGPU;
+struct IInternalTexture;
+} // namespace RHI::vulkan
+
+namespace RHI::vulkan
+{
+//TODO: add graphics and transfer nodes to replace layout transitions of RenderPass::Draw and
+//      Transferer, and alias memory of transient resources. It's tracked as separate work
+/// @brief Executes compute passes in compute queue. Barriers are built from declared usage of
+/// resources and recorded as one batch at the beginning of each pass.
+/// Graphics and transfer nodes and aliasing of transient resources aren't supported
+struct RenderGraph : public IRenderGraph,
+                     public OwnedBy<Context>
+{
+  explicit RenderGraph(Context & ctx);
+  virtual ~RenderGraph() override = default;
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+  RESTRICTED_COPY(RenderGraph);
+
+public: // IRenderGraph interface
+  virtual uint32_t AddComputePass(IComputePass & pass, RecordFunc && recordFunc) override;
+  virtual void ReadTexture(uint32_t passIndex, ITexture & texture) override;
+  virtual void WriteTexture(uint32_t passIndex, ITexture & texture) override;
+  virtual void ReadBuffer(uint32_t passIndex, const IBufferGPU & buffer) override;
+  virtual void WriteBuffer(uint32_t passIndex, const IBufferGPU & buffer) override;
+  virtual void MarkOutput(ITexture & texture) override;
+  virtual void MarkOutput(const IBufferGPU & buffer) override;
+  virtual IAwaitable * Execute() override;
+  virtual void Reset() override;
+
+public: // public internal API
+  /// @brief count of passes skipped by last Execute because they don't contribute to outputs
+  size_t GetCulledPassesCount() const noexcept { return m_culledPassesCount; }
+
+private:
+  struct TextureUsage
+  {
+    IInternalTexture * texture = nullptr;
+    bool read = false;
+    bool write = false;
+  };
+
+  struct BufferUsage
+  {
+    const BufferGPU * buffer = nullptr;
+    bool read = false;
+    bool write = false;
+  };
+
+  struct PassNode
+  {
+    ComputePass * pass = nullptr;
+    RecordFunc recordFunc;
+    std::vector<TextureUsage> textures;
+    std::vector<BufferUsage> buffers;
+    bool culled = false;
+  };
+
+private:
+  PassNode & GetNode(uint32_t passIndex);
+  TextureUsage & GetTextureUsage(uint32_t passIndex, ITexture & texture);
+  BufferUsage & GetBufferUsage(uint32_t passIndex, const IBufferGPU & buffer);
+  /// @brief marks passes which results aren't used by outputs
+  void CullPasses();
+  void AddTextureBarrier(details::BarrierBatch & batch, details::ResourceAccessTracker & tracker,
+                         const TextureUsage & usage) const;
+  void AddBufferBarrier(details::BarrierBatch & batch, details::ResourceAccessTracker & tracker,
+                        const BufferUsage & usage) const;
+
+private:
+  std::vector<PassNode> m_passes;
+  std::unordered_set<const void *> m_outputs; ///< internal textures and buffers
+  std::deque<CompositeAsyncTask> m_executionTasks; ///< tasks of last executions
+  size_t m_culledPassesCount = 0;
+};
+
+} // namespace RHI::vulkan
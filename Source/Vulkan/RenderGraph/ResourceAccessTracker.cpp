@@ -0,0 +1,50 @@
+#include "ResourceAccessTracker.hpp"
+
+namespace
+{
+/// all passes of graph are compute passes
+constexpr VkPipelineStageFlags2 g_passStages = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+constexpr VkAccessFlags2 MakeAccessFlags(bool read, bool write) noexcept
+{
+  return (read ? VK_ACCESS_2_SHADER_READ_BIT : VK_ACCESS_2_NONE) |
+         (write ? VK_ACCESS_2_SHADER_WRITE_BIT : VK_ACCESS_2_NONE);
+}
+} // namespace
+
+namespace RHI::vulkan::details
+{
+
+std::optional<ResourceAccessTracker::Dependency> ResourceAccessTracker::Access(
+  const void * resource, bool read, bool write, bool layoutChanged)
+{
+  auto [it, firstUsage] = m_states.try_emplace(resource);
+  AccessState & state = it->second;
+  if (firstUsage)
+  {
+    // resource could be written by anybody before graph (e.g. by the last pass of previous Execute)
+    state.stages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    state.writeAccess = VK_ACCESS_2_MEMORY_WRITE_BIT;
+  }
+
+  // read after read in the same layout doesn't need synchronization. The first usage always
+  // has hazard with conservative state above
+  const bool hazard = state.writeAccess != VK_ACCESS_2_NONE || write;
+  std::optional<Dependency> result;
+  if (hazard || layoutChanged)
+  {
+    result.emplace();
+    result->srcStages = state.stages;
+    result->srcAccess = state.writeAccess;
+    result->dstStages = g_passStages;
+    result->dstAccess = MakeAccessFlags(read, write);
+    state.stages = VK_PIPELINE_STAGE_2_NONE;
+  }
+
+  // readers are accumulated until next write
+  state.stages |= g_passStages;
+  state.writeAccess = write ? VK_ACCESS_2_SHADER_WRITE_BIT : VK_ACCESS_2_NONE;
+  return result;
+}
+
+} // namespace RHI::vulkan::details
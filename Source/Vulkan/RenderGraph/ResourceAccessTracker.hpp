@@ -0,0 +1,39 @@
+#pragma once
+#include <optional>
+#include <unordered_map>
+
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan::details
+{
+
+/// @brief tracks the last accesses of resources by compute passes and decides where barriers are
+/// needed. Resources are identified by their addresses
+struct ResourceAccessTracker final
+{
+  /// @brief synchronization which must be recorded before access
+  struct Dependency
+  {
+    VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 srcAccess = VK_ACCESS_2_NONE;
+    VkPipelineStageFlags2 dstStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 dstAccess = VK_ACCESS_2_NONE;
+  };
+
+  /// @brief registers access of pass to resource
+  /// @param layoutChanged - resource is image which layout is transfered before access
+  /// @return dependency of access or nullopt if it doesn't need barrier
+  std::optional<Dependency> Access(const void * resource, bool read, bool write,
+                                   bool layoutChanged = false);
+
+private:
+  struct AccessState
+  {
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE; ///< NONE if resource was only read
+  };
+
+  std::unordered_map<const void *, AccessState> m_states;
+};
+
+} // namespace RHI::vulkan::details
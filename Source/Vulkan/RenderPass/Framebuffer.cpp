@@ -14,6 +14,24 @@ bool operator==(const VkExtent3D & e1, const VkExtent3D & e2)
   return std::memcmp(&e1, &e2, sizeof(VkExtent3D)) == 0;
 }
 
+/// @brief applies user's policy to description. Discarded content of attachment can't be stored
+void ApplyAttachmentOps(VkAttachmentDescription & description, const RHI::AttachmentOps & ops)
+{
+  using RHI::vulkan::utils::CastInterfaceEnum2Vulkan;
+  description.loadOp = CastInterfaceEnum2Vulkan<VkAttachmentLoadOp>(ops.loadOp);
+  if (description.storeOp != VK_ATTACHMENT_STORE_OP_DONT_CARE)
+    description.storeOp = CastInterfaceEnum2Vulkan<VkAttachmentStoreOp>(ops.storeOp);
+  if (description.stencilLoadOp != VK_ATTACHMENT_LOAD_OP_DONT_CARE)
+    description.stencilLoadOp = CastInterfaceEnum2Vulkan<VkAttachmentLoadOp>(ops.stencilLoadOp);
+  if (description.stencilStoreOp != VK_ATTACHMENT_STORE_OP_DONT_CARE)
+    description.stencilStoreOp = CastInterfaceEnum2Vulkan<VkAttachmentStoreOp>(ops.stencilStoreOp);
+
+  // loaded content is kept in layout of previous rendering
+  if (description.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD ||
+      description.stencilLoadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+    description.initialLayout = description.finalLayout;
+}
+
 } // namespace
 
 namespace RHI::vulkan
@@ -27,6 +45,9 @@ Framebuffer::Framebuffer(Context & ctx)
 
 Framebuffer::~Framebuffer()
 {
+  // dropped frame doesn't keep per-frame resources of other framebuffers
+  if (m_frameStarted)
+    GetContext().OnFramesEnded(1);
 }
 
 size_t Framebuffer::GetImagesCount() const noexcept
@@ -44,12 +65,14 @@ void Framebuffer::Invalidate()
 
     std::vector<VkAttachmentDescription> newAttachmentsDescription;
     newAttachmentsDescription.reserve(m_attachments.size());
-    for (auto * attachment : m_attachments)
+    for (size_t i = 0; i < m_attachments.size(); ++i)
     {
-      if (attachment)
+      if (auto * attachment = m_attachments[i])
       {
         attachment->Invalidate();
-        newAttachmentsDescription.push_back(attachment->BuildDescription());
+        auto && description =
+          newAttachmentsDescription.emplace_back(attachment->BuildDescription());
+        ApplyAttachmentOps(description, m_attachmentsOps[i]);
       }
     }
 
@@ -83,16 +106,18 @@ void Framebuffer::Invalidate()
 
       while (m_targets.size() < buffersCount)
         m_targets.emplace_back(GetContext());
+      m_targetsLastUsage.resize(m_targets.size(), 0);
     }
 
     // build RenderTargets
     for (auto && target : m_targets)
-    {
       target.SetExtent(extent);
-      target.BindRenderPass(m_renderPass.GetHandle());
-    }
     targetsChanged = false;
   }
+
+  // render pass can be rebuilt or replaced with dynamic rendering after subpasses are changed
+  for (auto && target : m_targets)
+    target.BindRenderPass(m_renderPass.GetHandle());
 }
 
 void Framebuffer::ForEachAttachment(AttachmentProcessFunc && func)
@@ -151,23 +176,81 @@ IRenderTarget * Framebuffer::BeginFrame()
   }
 
   m_imagesAvailabilitySemaphores = std::move(semaphores);
-  m_activeTarget = (m_activeTarget + 1) % m_targets.size();
+  m_activeTarget = SelectRenderTarget(renderingImages);
+  if (!m_frameStarted.exchange(true))
+    GetContext().OnFrameBegun();
 
   m_targets[m_activeTarget].SetAttachments(std::move(renderingImages));
-  m_targets[m_activeTarget].Invalidate(); // rebuilds VkFramebuffer if need it
+  // rebuilds VkFramebuffer if need it
+  UpdateRebuildsStatistics(m_targets[m_activeTarget].Invalidate());
   return &m_targets[m_activeTarget];
 }
 
+uint32_t Framebuffer::SelectRenderTarget(const std::vector<VkImageView> & views) noexcept
+{
+  assert(!m_targets.empty() && m_targets.size() == m_targetsLastUsage.size());
+  ++m_frameIndex;
+  // attachments are acquired in their own order (e.g. swapchain images), so target is chosen
+  // by image views to reuse its VkFramebuffer
+  auto it = std::find_if(m_targets.begin(), m_targets.end(), [&views](const RenderTarget & target)
+                         { return target.GetImageViews() == views; });
+  const uint32_t idx =
+    it != m_targets.end()
+      ? static_cast<uint32_t>(std::distance(m_targets.begin(), it))
+      : static_cast<uint32_t>(std::distance(
+          m_targetsLastUsage.begin(),
+          std::min_element(m_targetsLastUsage.begin(), m_targetsLastUsage.end())));
+  m_targetsLastUsage[idx] = m_frameIndex;
+  return idx;
+}
+
+void Framebuffer::UpdateRebuildsStatistics(bool rebuilt) noexcept
+{
+  if (rebuilt)
+    ++m_rebuildsCounter;
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_rebuildsMeasureStart < std::chrono::seconds(1))
+    return;
+  m_rebuildsPerSecond = m_rebuildsCounter;
+  m_rebuildsCounter = 0;
+  m_rebuildsMeasureStart = now;
+  if (m_rebuildsPerSecond > 0)
+    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG,
+                     std::format("VkFramebuffer rebuilds per second: {}",
+                                 m_rebuildsPerSecond.load()));
+}
+
 IAwaitable * Framebuffer::EndFrame()
 {
-  AsyncTask * task =
-    m_renderPass.Draw(m_targets[m_activeTarget], std::move(m_imagesAvailabilitySemaphores));
+  details::SubmitBatch batch;
+  AsyncTask * task = SubmitFrame(batch, 0);
+  if (!task)
+    return nullptr;
+  batch.Flush(GetContext());
+  PresentFrame(*task);
+  GetContext().OnFramesEnded(1);
+  return task;
+}
+
+AsyncTask * Framebuffer::SubmitFrame(details::SubmitBatch & batch, uint32_t queueIndex,
+                                     details::CommandBuffer * sharedTransitions /* = nullptr*/,
+                                     VkSemaphore transitionsSemaphore /* = VK_NULL_HANDLE*/)
+{
+  if (!m_frameStarted.exchange(false))
+    return nullptr;
+  return m_renderPass.Draw(batch, queueIndex, m_targets[m_activeTarget],
+                           std::move(m_imagesAvailabilitySemaphores), sharedTransitions,
+                           transitionsSemaphore);
+}
+
+void Framebuffer::PresentFrame(const AsyncTask & task)
+{
+  // present waits for semaphore, so its signal must be submitted before
   for (auto && attachment : m_attachments)
   {
     if (attachment)
-      attachment->FinalRendering(task->GetSemaphore());
+      attachment->FinalRendering(task.GetSemaphore());
   }
-  return task;
 }
 
 ISubpass * Framebuffer::CreateSubpass()
@@ -175,17 +258,30 @@ ISubpass * Framebuffer::CreateSubpass()
   return m_renderPass.CreateSubpass();
 }
 
-void Framebuffer::AddAttachment(uint32_t binding, IAttachment * attachment)
+void Framebuffer::AddAttachment(uint32_t binding, IAttachment * attachment,
+                                const AttachmentOps & ops /* = {}*/)
 {
   while (m_attachments.size() < binding + 1)
   {
     m_attachments.push_back(nullptr);
+    m_attachmentsOps.emplace_back();
   }
 
   if (IInternalAttachment * ptr = dynamic_cast<IInternalAttachment *>(attachment))
   {
+    // transient content isn't stored, so there is nothing to load in next frame
+    const VkAttachmentDescription description = ptr->BuildDescription();
+    const bool loadsContent = ops.loadOp == AttachmentLoadOp::Load &&
+                              description.storeOp == VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    const bool loadsStencil = ops.stencilLoadOp == AttachmentLoadOp::Load &&
+                              description.stencilLoadOp != VK_ATTACHMENT_LOAD_OP_DONT_CARE &&
+                              description.stencilStoreOp == VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    if (loadsContent || loadsStencil)
+      throw std::invalid_argument("Transient attachment can't be loaded");
+
     //ptr->SetBuffering(m_framesCount);
     m_attachments[binding] = ptr;
+    m_attachmentsOps[binding] = ops;
     m_attachmentsChanged = true;
   }
   else
@@ -197,6 +293,7 @@ void Framebuffer::AddAttachment(uint32_t binding, IAttachment * attachment)
 void Framebuffer::ClearAttachments() noexcept
 {
   m_attachments.clear();
+  m_attachmentsOps.clear();
   m_attachmentsChanged = true;
 }
 
@@ -205,7 +302,13 @@ void Framebuffer::Resize(uint32_t width, uint32_t height)
   for (auto * attachment : m_attachments)
     if (attachment)
       attachment->Resize(VkExtent2D(width, height));
-  m_renderPass.ForEachSubpass([](Subpass & sp) { sp.SetDirtyCacheCommands(); });
+  // subpasses with own viewport and scissor must be recorded again with new size
+  m_renderPass.ForEachSubpass(
+    [](Subpass & sp)
+    {
+      if (!sp.UsesInheritedViewport())
+        sp.SetDirtyCacheCommands();
+    });
   m_attachmentsChanged = true;
 }
 
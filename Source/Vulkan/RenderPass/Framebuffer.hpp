@@ -1,6 +1,7 @@
 #pragma once
 
 #include <bitset>
+#include <chrono>
 #include <vector>
 
 #include <Private/OwnedBy.hpp>
@@ -32,14 +33,29 @@ public: // IFramebuffer interface
   /// @brief adds attachment to all frames
   /// @param binding - index of binding
   /// @param args - arguments for image creation
-  virtual void AddAttachment(uint32_t binding, IAttachment * attachment) override;
+  /// @param ops - load/store policy of attachment
+  virtual void AddAttachment(uint32_t binding, IAttachment * attachment,
+                             const AttachmentOps & ops = {}) override;
   /// @brief removes all images from all frames
   virtual void ClearAttachments() noexcept override;
 
   virtual void Resize(uint32_t width, uint32_t height) override;
   virtual RHI::TexelIndex GetExtent() const override;
+  virtual uint32_t GetFramebufferRebuildsPerSecond() const noexcept override
+  {
+    return m_rebuildsPerSecond;
+  }
 
 public: // RHI-only API
+  /// @brief records frame and adds its submit into batch. Returns nullptr if frame isn't begun
+  /// @param sharedTransitions - see RenderPass::Draw
+  AsyncTask * SubmitFrame(details::SubmitBatch & batch, uint32_t queueIndex,
+                          details::CommandBuffer * sharedTransitions = nullptr,
+                          VkSemaphore transitionsSemaphore = VK_NULL_HANDLE);
+  bool IsFrameStarted() const noexcept { return m_frameStarted; }
+  /// @brief gives rendered images to attachments (e.g. presents them). Call it after batch with
+  /// frame's submit is flushed
+  void PresentFrame(const AsyncTask & task);
   size_t GetImagesCount() const noexcept;
   void Invalidate();
 
@@ -48,18 +64,31 @@ public: // RHI-only API
   IInternalAttachment * GetAttachment(uint32_t idx) const;
   RHI::SamplesCount CalcSamplesCount() const noexcept;
 
+private:
+  /// @brief finds render target with the same image views or the least recently used one
+  uint32_t SelectRenderTarget(const std::vector<VkImageView> & views) noexcept;
+  void UpdateRebuildsStatistics(bool rebuilt) noexcept;
+
 protected:
+  /// render targets are LRU cache of VkFramebuffers keyed by image views
   std::vector<RenderTarget> m_targets;
+  std::vector<uint64_t> m_targetsLastUsage; ///< number of frame when target was used
+  uint64_t m_frameIndex = 0;
   uint32_t m_activeTarget = -1;
   RenderPass m_renderPass;
 
   std::vector<IInternalAttachment *> m_attachments; //sort by count of buffers
+  std::vector<AttachmentOps> m_attachmentsOps;      ///< the same size as m_attachments
   bool m_attachmentsChanged = false;
   std::vector<VkAttachmentDescription> m_attachmentDescriptions;
   std::vector<VkSemaphore> m_imagesAvailabilitySemaphores;
 
   uint32_t m_framesCount = 0;
 
+  uint32_t m_rebuildsCounter = 0;
+  std::atomic<uint32_t> m_rebuildsPerSecond = 0; ///< read by user thread
+  std::chrono::steady_clock::time_point m_rebuildsMeasureStart = std::chrono::steady_clock::now();
+
   std::atomic_bool m_frameStarted = false;
 };
 
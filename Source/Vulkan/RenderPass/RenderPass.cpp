@@ -1,11 +1,55 @@
 #include "RenderPass.hpp"
 
+#include <algorithm>
+
 #include <CommandsExecution/Submitter.hpp>
 #include <RenderPass/Framebuffer.hpp>
 #include <RenderPass/RenderTarget.hpp>
 #include <RenderPass/Subpass.hpp>
 #include <VulkanContext.hpp>
 
+namespace
+{
+/// @brief averaging is supported only for float and normalized color formats
+constexpr VkResolveModeFlagBits SelectResolveMode(VkFormat format) noexcept
+{
+  switch (format)
+  {
+    case VK_FORMAT_R8_UINT:
+    case VK_FORMAT_R8_SINT:
+    case VK_FORMAT_R8G8_UINT:
+    case VK_FORMAT_R8G8_SINT:
+    case VK_FORMAT_R8G8B8_UINT:
+    case VK_FORMAT_R8G8B8_SINT:
+    case VK_FORMAT_R8G8B8A8_UINT:
+    case VK_FORMAT_R8G8B8A8_SINT:
+    case VK_FORMAT_B8G8R8A8_UINT:
+    case VK_FORMAT_B8G8R8A8_SINT:
+    case VK_FORMAT_R16_UINT:
+    case VK_FORMAT_R16_SINT:
+    case VK_FORMAT_R16G16_UINT:
+    case VK_FORMAT_R16G16_SINT:
+    case VK_FORMAT_R16G16B16A16_UINT:
+    case VK_FORMAT_R16G16B16A16_SINT:
+    case VK_FORMAT_R32_UINT:
+    case VK_FORMAT_R32_SINT:
+    case VK_FORMAT_R32G32_UINT:
+    case VK_FORMAT_R32G32_SINT:
+    case VK_FORMAT_R32G32B32A32_UINT:
+    case VK_FORMAT_R32G32B32A32_SINT:
+    case VK_FORMAT_D16_UNORM:
+    case VK_FORMAT_D32_SFLOAT:
+    case VK_FORMAT_S8_UINT:
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+      return VK_RESOLVE_MODE_SAMPLE_ZERO_BIT;
+    default:
+      return VK_RESOLVE_MODE_AVERAGE_BIT;
+  }
+}
+} // namespace
+
 namespace RHI::vulkan
 {
 
@@ -45,24 +89,44 @@ void RenderPass::DeleteSubpass(ISubpass * subpass)
     m_invalidRenderPass = true;
 }
 
-AsyncTask * RenderPass::Draw(RenderTarget & renderTarget,
-                             std::vector<VkSemaphore> && waitSemaphores)
+AsyncTask * RenderPass::Draw(details::SubmitBatch & batch, uint32_t queueIndex,
+                             RenderTarget & renderTarget,
+                             std::vector<VkSemaphore> && waitSemaphores,
+                             details::CommandBuffer * sharedTransitions /* = nullptr*/,
+                             VkSemaphore transitionsSemaphore /* = VK_NULL_HANDLE*/)
 {
-  assert(m_renderPass);
+  assert(m_renderPass || m_dynamicRendering);
   assert(renderTarget.GetAttachmentsCount() == m_cachedAttachments.size());
-  VkFramebuffer buf = renderTarget.GetHandle();
-  VkExtent3D extent = renderTarget.GetVkExtent();
-  auto && clearValues = renderTarget.GetClearValues();
 
   m_submitter.WaitForSubmitCompleted();
   m_submitter.BeginWriting();
 
-  // here transfer layouts  for subpasses
+  // layouts of subpasses' images are transfered with the same barrier as attachments
   for (auto && subpass : m_subpasses)
   {
-    subpass.TransitLayoutForUsedImages(m_submitter);
+    subpass.TransitLayoutForUsedImages(sharedTransitions ? *sharedTransitions : m_submitter);
   }
 
+  if (m_dynamicRendering)
+    RecordDynamicRendering(renderTarget);
+  else
+    RecordRenderPass(renderTarget);
+
+  m_submitter.EndWriting();
+  m_submitter.SetQueueIndex(queueIndex);
+  std::vector<details::SemaphoreWait> extraWaits;
+  if (transitionsSemaphore)
+    extraWaits.push_back({transitionsSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT});
+  auto res = m_submitter.Submit(batch, false /*waitPrevSubmitOnGPU*/, std::move(waitSemaphores),
+                                std::move(extraWaits));
+  return res;
+}
+
+void RenderPass::RecordRenderPass(RenderTarget & renderTarget)
+{
+  VkFramebuffer buf = renderTarget.GetHandle();
+  VkExtent3D extent = renderTarget.GetVkExtent();
+  auto && clearValues = renderTarget.GetClearValues();
 
   VkRenderPassBeginInfo renderPassInfo{};
   renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -73,28 +137,37 @@ AsyncTask * RenderPass::Draw(RenderTarget & renderTarget,
   renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
   renderPassInfo.pClearValues = clearValues.data();
 
-  m_submitter.PushCommand(vkCmdBeginRenderPass, &renderPassInfo,
-                          VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
-
+  // loaded attachments must be in initial layout before render pass begins
   GetFramebuffer().ForEachAttachment(
-    [it = m_cachedAttachments.begin()](IInternalAttachment * att) mutable
+    [this, it = m_cachedAttachments.begin()](IInternalAttachment * att) mutable
     {
       if (att)
-        att->TransferLayout(it->initialLayout);
+        att->TransferLayout(m_submitter.GetBarriers(), it->initialLayout,
+                            VK_PIPELINE_STAGE_2_NONE);
       ++it;
     });
+  m_submitter.FlushBarriers();
+
+  // viewport and scissor are inherited by subpasses, so they stay valid after resize.
+  // Render pass with secondary command buffers allows only vkCmdExecuteCommands inside
+  if (GetContext().GetGpuConnection().GetFeatures().inheritedViewportScissor)
+  {
+    const VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width),
+                              static_cast<float>(extent.height), 0.0f, 1.0f};
+    const VkRect2D scissor{{0, 0}, {extent.width, extent.height}};
+    m_submitter.PushCommand(vkCmdSetViewport, 0u, 1u, &viewport);
+    m_submitter.PushCommand(vkCmdSetScissor, 0u, 1u, &scissor);
+  }
+
+  m_submitter.PushCommand(vkCmdBeginRenderPass, &renderPassInfo,
+                          VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
   // execute commands for subpasses
   {
     std::vector<VkCommandBuffer> subpassBuffers;
     subpassBuffers.reserve(m_subpasses.size());
     for (auto && subpass : m_subpasses)
-    {
-      if (subpass.ShouldSwapCommandBuffers())
-        subpass.SwapCommandBuffers();
-      if (subpass.IsEnabled())
-        subpassBuffers.push_back(subpass.GetCommandBufferForExecution().GetHandle());
-    }
+      CollectSubpassCommands(subpass, subpassBuffers);
     if (!subpassBuffers.empty())
       m_submitter.AddCommands(subpassBuffers);
   }
@@ -109,10 +182,160 @@ AsyncTask * RenderPass::Draw(RenderTarget & renderTarget,
         att->TransferLayout(it->finalLayout);
       ++it;
     });
+}
 
-  m_submitter.EndWriting();
-  auto res = m_submitter.Submit(false /*waitPrevSubmitOnGPU*/, std::move(waitSemaphores));
-  return res;
+void RenderPass::RecordDynamicRendering(RenderTarget & renderTarget)
+{
+  const VkExtent3D extent = renderTarget.GetVkExtent();
+  auto && views = renderTarget.GetImageViews();
+  auto && clearValues = renderTarget.GetClearValues();
+  auto && framebuffer = GetFramebuffer();
+
+  // load and store operations of VkRenderPass are applied on first and last use of attachment
+  std::vector<uint32_t> lastUsage(m_cachedAttachments.size(), 0);
+  std::vector<bool> isLoaded(m_cachedAttachments.size(), false);
+  {
+    uint32_t subpassIdx = 0;
+    for (auto && subpass : m_subpasses)
+    {
+      subpass.GetLayout().ForEachAttachment([&lastUsage, subpassIdx](uint32_t idx)
+                                            { lastUsage[idx] = subpassIdx; });
+      ++subpassIdx;
+    }
+  }
+
+  // viewport and scissor are inherited by subpasses, so they stay valid after resize
+  if (GetContext().GetGpuConnection().GetFeatures().inheritedViewportScissor)
+  {
+    const VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width),
+                              static_cast<float>(extent.height), 0.0f, 1.0f};
+    const VkRect2D scissor{{0, 0}, {extent.width, extent.height}};
+    m_submitter.PushCommand(vkCmdSetViewport, 0u, 1u, &viewport);
+    m_submitter.PushCommand(vkCmdSetScissor, 0u, 1u, &scissor);
+  }
+
+  std::vector<VkRenderingAttachmentInfo> colorAttachments;
+  std::vector<VkCommandBuffer> subpassBuffers;
+  uint32_t subpassIdx = 0;
+  for (auto && subpass : m_subpasses)
+  {
+    auto && layout = subpass.GetLayout();
+    if (subpassIdx > 0)
+    {
+      // previous subpass has written attachments that can be used by this one
+      VkMemoryBarrier2 barrier{};
+      barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+      barrier.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+                             VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+      barrier.srcAccessMask =
+        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+      barrier.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+                             VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
+      barrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+                              VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                              VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                              VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+      m_submitter.GetBarriers().AddMemoryBarrier(barrier);
+    }
+
+    auto makeAttachmentInfo = [&](const VkAttachmentReference & ref, VkAttachmentLoadOp loadOp,
+                                  VkAttachmentStoreOp storeOp)
+    {
+      framebuffer.GetAttachment(ref.attachment)
+        ->TransferLayout(m_submitter.GetBarriers(), ref.layout, VK_PIPELINE_STAGE_2_NONE);
+      VkRenderingAttachmentInfo info{};
+      info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+      info.imageView = views[ref.attachment];
+      info.imageLayout = ref.layout;
+      info.loadOp = isLoaded[ref.attachment] ? VK_ATTACHMENT_LOAD_OP_LOAD : loadOp;
+      info.storeOp =
+        lastUsage[ref.attachment] == subpassIdx ? storeOp : VK_ATTACHMENT_STORE_OP_STORE;
+      info.clearValue = clearValues[ref.attachment];
+      return info;
+    };
+
+    colorAttachments.clear();
+    auto && colorRefs = layout.GetColorAttachments();
+    auto && resolveRefs = layout.GetResolveAttachments();
+    for (size_t i = 0; i < colorRefs.size(); ++i)
+    {
+      auto && description = m_cachedAttachments[colorRefs[i].attachment];
+      auto && info =
+        colorAttachments.emplace_back(makeAttachmentInfo(colorRefs[i], description.loadOp,
+                                                         description.storeOp));
+      if (i < resolveRefs.size() && resolveRefs[i].attachment != VK_ATTACHMENT_UNUSED)
+      {
+        framebuffer.GetAttachment(resolveRefs[i].attachment)
+          ->TransferLayout(m_submitter.GetBarriers(), resolveRefs[i].layout,
+                           VK_PIPELINE_STAGE_2_NONE);
+        info.resolveMode = SelectResolveMode(description.format);
+        info.resolveImageView = views[resolveRefs[i].attachment];
+        info.resolveImageLayout = resolveRefs[i].layout;
+        isLoaded[resolveRefs[i].attachment] = true; // resolved content must be kept
+      }
+    }
+
+    VkRenderingAttachmentInfo depthAttachment{};
+    VkRenderingAttachmentInfo stencilAttachment{};
+    if (layout.UseDepthStencil())
+    {
+      auto && ref = layout.GetDepthStencilAttachment();
+      auto && description = m_cachedAttachments[ref.attachment];
+      depthAttachment = makeAttachmentInfo(ref, description.loadOp, description.storeOp);
+      stencilAttachment =
+        makeAttachmentInfo(ref, description.stencilLoadOp, description.stencilStoreOp);
+    }
+
+    VkRenderingInfo renderingInfo{};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+    renderingInfo.renderArea.offset = {0, 0};
+    renderingInfo.renderArea.extent = {extent.width, extent.height};
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size());
+    renderingInfo.pColorAttachments = colorAttachments.data();
+    renderingInfo.pDepthAttachment = layout.UseDepthStencil() ? &depthAttachment : nullptr;
+    renderingInfo.pStencilAttachment = layout.UseStencil() ? &stencilAttachment : nullptr;
+
+    layout.ForEachAttachment([&isLoaded](uint32_t idx) { isLoaded[idx] = true; });
+
+    // all transitions of the subpass are recorded with one barrier
+    m_submitter.FlushBarriers();
+    // disabled subpass still begins rendering to clear and store its attachments
+    m_submitter.PushCommand(vkCmdBeginRendering, &renderingInfo);
+    subpassBuffers.clear();
+    CollectSubpassCommands(subpass, subpassBuffers);
+    if (!subpassBuffers.empty())
+      m_submitter.AddCommands(subpassBuffers);
+    m_submitter.PushCommand(vkCmdEndRendering);
+    ++subpassIdx;
+  }
+
+  // there is no VkRenderPass to transit attachments into final layouts
+  for (uint32_t i = 0; i < m_cachedAttachments.size(); ++i)
+  {
+    if (auto * attachment = framebuffer.GetAttachment(i))
+      attachment->TransferLayout(m_submitter.GetBarriers(), m_cachedAttachments[i].finalLayout,
+                                 VK_PIPELINE_STAGE_2_NONE);
+  }
+  m_submitter.FlushBarriers();
+}
+
+void RenderPass::CollectSubpassCommands(Subpass & subpass, std::vector<VkCommandBuffer> & buffers)
+{
+  if (subpass.ShouldSwapCommandBuffers())
+    subpass.SwapCommandBuffers();
+  if (subpass.IsEnabled())
+    subpass.CollectCommandBuffersForExecution(buffers);
+}
+
+bool RenderPass::CanUseDynamicRendering() const noexcept
+{
+  if (!GetContext().GetGpuConnection().GetFeatures().dynamicRendering)
+    return false;
+  // input attachments are read from the same pixel, it's impossible without VkRenderPass
+  return std::none_of(m_subpasses.begin(), m_subpasses.end(), [](const Subpass & subpass)
+                      { return subpass.GetLayout().HasInputAttachments(); });
 }
 
 void RenderPass::SetAttachments(const std::vector<VkAttachmentDescription> & attachments) noexcept
@@ -136,7 +359,31 @@ void RenderPass::ForEachSubpass(std::function<void(Subpass &)> && func)
 
 void RenderPass::Invalidate()
 {
-  if (m_invalidRenderPass || !m_renderPass)
+  const bool shouldRebuild = m_invalidRenderPass || (!m_renderPass && !m_dynamicRendering);
+  if (shouldRebuild)
+  {
+    const bool dynamicRendering = CanUseDynamicRendering();
+    bool formatsChanged = false;
+    for (auto && subpass : m_subpasses)
+      formatsChanged |= subpass.GetLayout().SetAttachmentFormats(m_cachedAttachments);
+    // pipelines are built either for VkRenderPass or for attachment formats
+    if (dynamicRendering != m_dynamicRendering || (dynamicRendering && formatsChanged))
+    {
+      for (auto && subpass : m_subpasses)
+        subpass.SetInvalid();
+    }
+    m_dynamicRendering = dynamicRendering;
+  }
+
+  if (shouldRebuild && m_dynamicRendering)
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "use dynamic rendering for RenderPass");
+    GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_renderPass, nullptr);
+    m_renderPass = VK_NULL_HANDLE;
+    m_invalidRenderPass = false;
+    UpdateRenderPassValidFlag();
+  }
+  else if (shouldRebuild)
   {
     m_builder.Reset();
     for (auto && attachment : m_cachedAttachments)
@@ -170,7 +417,7 @@ void RenderPass::WaitForRenderPassIsValid() const noexcept
 
 void RenderPass::UpdateRenderPassValidFlag() noexcept
 {
-  m_isReadyForRendering = m_renderPass; // m_renderPass != VK_NULL_HANDLE
+  m_isReadyForRendering = m_dynamicRendering || m_renderPass; // m_renderPass != VK_NULL_HANDLE
   std::atomic_notify_all(&m_isReadyForRendering);
 }
 
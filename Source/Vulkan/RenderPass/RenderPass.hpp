@@ -34,8 +34,14 @@ public: // IFramebuffer Interface
   ISubpass * CreateSubpass();
   void DeleteSubpass(ISubpass * subpass);
 
-  AsyncTask * Draw(RenderTarget & renderTarget,
-                   std::vector<VkSemaphore> && imageAvailiableSemaphore);
+  /// @brief records frame and adds its submit into batch
+  /// @param queueIndex - index of graphics queue which executes the frame
+  /// @param sharedTransitions - records transitions of images used by subpasses instead of frame
+  /// @param transitionsSemaphore - signaled when shared transitions are executed on other queue
+  AsyncTask * Draw(details::SubmitBatch & batch, uint32_t queueIndex, RenderTarget & renderTarget,
+                   std::vector<VkSemaphore> && imageAvailiableSemaphore,
+                   details::CommandBuffer * sharedTransitions = nullptr,
+                   VkSemaphore transitionsSemaphore = VK_NULL_HANDLE);
   void SetAttachments(const std::vector<VkAttachmentDescription> & attachments) noexcept;
   const VkAttachmentDescription & GetAttachmentDescription(uint32_t idx) const & noexcept;
   void ForEachSubpass(std::function<void(Subpass &)> && func);
@@ -46,16 +52,29 @@ public: // IInvalidable Interface
 
 public:
   VkRenderPass GetHandle() const noexcept { return m_renderPass; }
+  /// @brief subpasses are recorded as separate vkCmdBeginRendering scopes without VkRenderPass
+  bool UsesDynamicRendering() const noexcept { return m_dynamicRendering; }
   void WaitForRenderPassIsValid() const noexcept;
   void UpdateRenderPassValidFlag() noexcept;
   void WaitForRenderingIsDone() noexcept;
 
+private:
+  /// @brief records subpasses inside of VkRenderPass
+  void RecordRenderPass(RenderTarget & renderTarget);
+  /// @brief records every subpass as separate rendering scope (VK_KHR_dynamic_rendering)
+  void RecordDynamicRendering(RenderTarget & renderTarget);
+  /// @brief swaps command buffers of subpass and collects them if it's enabled
+  void CollectSubpassCommands(Subpass & subpass, std::vector<VkCommandBuffer> & buffers);
+  /// @brief checks if dynamic rendering can replace VkRenderPass for current subpasses
+  bool CanUseDynamicRendering() const noexcept;
+
 private:
   std::vector<VkAttachmentDescription> m_cachedAttachments;
 
   /// There is a lot of thread-readers, so it's must be synchronized access
   VkRenderPass m_renderPass = VK_NULL_HANDLE;
   bool m_invalidRenderPass = false;
+  bool m_dynamicRendering = false;
   utils::RenderPassBuilder m_builder;
 
   /// Flag to notify that subpasses can begin pass
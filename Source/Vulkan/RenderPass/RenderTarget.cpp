@@ -64,9 +64,16 @@ TexelIndex RenderTarget::GetExtent() const noexcept
   return {m_extent.width, m_extent.height, m_extent.depth};
 }
 
-void RenderTarget::Invalidate()
+bool RenderTarget::Invalidate()
 {
-  assert(m_boundRenderPass);
+  // dynamic rendering uses image views directly, so VkFramebuffer isn't needed
+  if (!m_boundRenderPass)
+  {
+    GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_framebuffer, nullptr);
+    m_framebuffer = VK_NULL_HANDLE;
+    return false;
+  }
+
   if (m_invalidFramebuffer || !m_framebuffer)
   {
     m_builder.Reset();
@@ -79,7 +86,9 @@ void RenderTarget::Invalidate()
     m_framebuffer = new_framebuffer;
     m_invalidFramebuffer = false;
     GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkFramebuffer has been rebuilt");
+    return true;
   }
+  return false;
 }
 
 void RenderTarget::BindRenderPass(const VkRenderPass & renderPass) noexcept
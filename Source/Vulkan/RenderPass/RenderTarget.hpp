@@ -33,11 +33,13 @@ public: // IRenderTarget interface
   virtual TexelIndex GetExtent() const noexcept override;
 
 public:
-  void Invalidate();
+  /// @brief rebuilds VkFramebuffer if need it. Returns true if it has been rebuilt
+  bool Invalidate();
   void BindRenderPass(const VkRenderPass & renderPass) noexcept;
   void SetExtent(const VkExtent3D & extent) noexcept;
 
   VkFramebuffer GetHandle() const noexcept { return m_framebuffer; }
+  const std::vector<VkImageView> & GetImageViews() const & noexcept { return m_attachedImages; }
   VkExtent3D GetVkExtent() const noexcept { return m_extent; }
   const std::vector<VkClearValue> & GetClearValues() const & noexcept;
 
@@ -2,8 +2,6 @@
 
 #include <CommandsExecution/CommandBuffer.hpp>
 #include <RenderPass/RenderPass.hpp>
-#include <Resources/BufferGPU.hpp>
-#include <Utils/CastHelper.hpp>
 #include <VulkanContext.hpp>
 
 namespace RHI::vulkan
@@ -12,8 +10,7 @@ Subpass::Subpass(Context & ctx, RenderPass & ownerPass, uint32_t subpassIndex, u
   : OwnedBy<Context>(ctx)
   , OwnedBy<RenderPass>(ownerPass)
   , m_pipeline(ctx, *this, subpassIndex)
-  , m_execBuffer(ctx, familyIndex, VK_COMMAND_BUFFER_LEVEL_SECONDARY)
-  , m_writeBuffer(ctx, familyIndex, VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+  , m_familyIndex(familyIndex)
   , m_execDescriptorBuffer(ctx, m_pipeline.GetDescriptorsLayout())
   , m_writeDescriptorBuffer(ctx, m_pipeline.GetDescriptorsLayout())
 {
@@ -26,28 +23,64 @@ Subpass::~Subpass()
 
 bool Subpass::BeginPass()
 {
+  return BeginParallelPass(1);
+}
+
+bool Subpass::BeginParallelPass(uint32_t recordersCount)
+{
+  if (recordersCount == 0)
+    throw std::invalid_argument("Subpass must have at least one recorder");
+
   GetRenderPass().WaitForRenderPassIsValid(); // wait for render pass is valid
-  assert(GetRenderPass().GetHandle());
+  const bool dynamicRendering = GetRenderPass().UsesDynamicRendering();
+  assert(dynamicRendering || GetRenderPass().GetHandle());
   if (!m_pipeline.WaitForPipelineIsValid()) // wait while Pipeline has been invalidated
     return false;
   assert(m_pipeline.GetPipelineHandle());
 
   m_write_lock.lock();
   m_cachedRenderPass = GetRenderPass().GetHandle();
-  m_writeBuffer.Reset();
-  m_writeBuffer.BeginWriting(m_cachedRenderPass, m_pipeline.GetSubpassIndex());
-  m_pipeline.BindToCommandBuffer(m_writeBuffer.GetHandle(), VK_PIPELINE_BIND_POINT_GRAPHICS);
-  m_writeDescriptorBuffer.BindToCommandBuffer(m_writeBuffer.GetHandle(),
-                                              m_pipeline.GetPipelineLayoutHandle(),
-                                              VK_PIPELINE_BIND_POINT_GRAPHICS);
+  // every recorder has own command pool, so they can be filled from different threads
+  while (m_writeRecorders.size() < recordersCount)
+    m_writeRecorders.emplace_back(GetContext(), m_pipeline, m_familyIndex);
+  m_writeRecordersCount = recordersCount;
+  const auto renderingInfo = m_layout.BuildInheritanceRenderingInfo();
+  for (uint32_t i = 0; i < recordersCount; ++i)
+    m_writeRecorders[i].BeginWriting(m_cachedRenderPass, UsesInheritedViewport(),
+                                     m_writeDescriptorBuffer,
+                                     dynamicRendering ? &renderingInfo : nullptr);
+  m_passActive = true;
   return true;
 }
 
+ISubpassCommands & Subpass::GetRecorder(uint32_t index) &
+{
+  if (!m_passActive)
+    throw std::runtime_error("Subpass recorders are available only between BeginPass and EndPass");
+  if (index >= m_writeRecordersCount)
+    throw std::invalid_argument("Subpass recorder index is out of range");
+  return m_writeRecorders[index];
+}
+
 void Subpass::EndPass()
 {
-  m_writeBuffer.EndWriting();
+  if (!m_passActive)
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                     "Subpass::EndPass is called without BeginPass");
+    return;
+  }
+  m_passActive = false;
+  bool explicitViewportRequested = false;
+  for (uint32_t i = 0; i < m_writeRecordersCount; ++i)
+  {
+    m_writeRecorders[i].EndWriting();
+    explicitViewportRequested |= m_writeRecorders[i].IsExplicitViewportRequested();
+  }
   m_cachedRenderPass = VK_NULL_HANDLE;
-  m_dirtyCommands = false;
+  // viewport or scissor were dropped, so commands are recorded again with explicit state
+  m_explicitViewport = m_explicitViewport || explicitViewportRequested;
+  m_dirtyCommands = explicitViewportRequested;
   m_write_lock.unlock();
   m_shouldSwapBuffer = true;
 }
@@ -64,7 +97,14 @@ void Subpass::SetEnabled(bool enabled) noexcept
 
 bool Subpass::IsEnabled() const noexcept
 {
-  return m_enabled && !m_execBuffer.IsEmpty();
+  if (!m_enabled)
+    return false;
+  for (uint32_t i = 0; i < m_execRecordersCount; ++i)
+  {
+    if (!m_execRecorders[i].GetCommandBuffer().IsEmpty())
+      return true;
+  }
+  return false;
 }
 
 bool Subpass::ShouldBeInvalidated() const noexcept
@@ -72,55 +112,160 @@ bool Subpass::ShouldBeInvalidated() const noexcept
   return m_dirtyCommands;
 }
 
+size_t Subpass::GetElidedCommandsCount() const noexcept
+{
+  size_t result = 0;
+  for (uint32_t i = 0; i < m_execRecordersCount; ++i)
+    result += m_execRecorders[i].GetCommandBuffer().GetStateCache().GetElidedCommandsCount();
+  return result;
+}
+
 void Subpass::DrawVertices(std::uint32_t vertexCount, std::uint32_t instanceCount,
                            std::uint32_t firstVertex, std::uint32_t firstInstance)
 {
-  m_writeBuffer.PushCommand(vkCmdDraw, vertexCount, instanceCount, firstVertex, firstInstance);
+  if (auto * recorder = GetMainRecorder())
+    recorder->DrawVertices(vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
 void Subpass::DrawIndexedVertices(std::uint32_t indexCount, std::uint32_t instanceCount,
                                   std::uint32_t firstIndex, int32_t vertexOffset,
                                   std::uint32_t firstInstance)
 {
-  m_writeBuffer.PushCommand(vkCmdDrawIndexed, indexCount, instanceCount, firstIndex, vertexOffset,
-                            firstInstance);
+  if (auto * recorder = GetMainRecorder())
+    recorder->DrawIndexedVertices(indexCount, instanceCount, firstIndex, vertexOffset,
+                                  firstInstance);
+}
+
+void Subpass::DrawIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                           uint32_t stride)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->DrawIndirect(buffer, offset, drawCount, stride);
+}
+
+void Subpass::DrawIndexedIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                                  uint32_t stride)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->DrawIndexedIndirect(buffer, offset, drawCount, stride);
+}
+
+void Subpass::DrawIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                const IBufferGPU & countBuffer, uint32_t countOffset,
+                                uint32_t maxDrawCount, uint32_t stride)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->DrawIndirectCount(buffer, offset, countBuffer, countOffset, maxDrawCount,
+                                stride);
+}
+
+void Subpass::DrawIndexedIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                       const IBufferGPU & countBuffer, uint32_t countOffset,
+                                       uint32_t maxDrawCount, uint32_t stride)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->DrawIndexedIndirectCount(buffer, offset, countBuffer, countOffset,
+                                       maxDrawCount, stride);
 }
 
 void Subpass::SetViewport(float width, float height)
 {
-  VkViewport vp{0.0f, 0.0f, width, height, 0.0f, 1.0f};
-  m_writeBuffer.PushCommand(vkCmdSetViewport, 0, 1, &vp);
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetViewport(width, height);
 }
 
 void Subpass::SetScissor(int32_t x, int32_t y, std::uint32_t width, std::uint32_t height)
 {
-  VkRect2D scissor{};
-  scissor.extent = {width, height};
-  scissor.offset = {x, y};
-  m_writeBuffer.PushCommand(vkCmdSetScissor, 0, 1, &scissor);
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetScissor(x, y, width, height);
 }
 
 void Subpass::BindVertexBuffer(std::uint32_t binding, const IBufferGPU & buffer,
                                std::uint32_t offset)
 {
-  VkDeviceSize vkOffset = offset;
-  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
-  VkBuffer buf = vkBuffer.GetHandle();
-  m_writeBuffer.PushCommand(vkCmdBindVertexBuffers, 0, 1, &buf, &vkOffset);
+  if (auto * recorder = GetMainRecorder())
+    recorder->BindVertexBuffer(binding, buffer, offset);
+}
+
+void Subpass::BindVertexBuffers(std::uint32_t firstBinding,
+                                std::span<const VertexBufferBinding> buffers)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->BindVertexBuffers(firstBinding, buffers);
 }
 
 void Subpass::BindIndexBuffer(const IBufferGPU & buffer, IndexType type, std::uint32_t offset)
 {
-  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
-  m_writeBuffer.PushCommand(vkCmdBindIndexBuffer, vkBuffer.GetHandle(), VkDeviceSize{offset},
-                            utils::CastInterfaceEnum2Vulkan<VkIndexType>(type));
+  if (auto * recorder = GetMainRecorder())
+    recorder->BindIndexBuffer(buffer, type, offset);
 }
 
 void Subpass::PushConstant(const void * data, size_t size)
 {
-  m_writeBuffer.PushCommand(vkCmdPushConstants, m_pipeline.GetPipelineLayoutHandle(),
-                            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                            static_cast<uint32_t>(size), data);
+  if (auto * recorder = GetMainRecorder())
+    recorder->PushConstant(data, size);
+}
+
+void Subpass::PushConstant(ShaderType shaderStage, uint32_t offset, const void * data,
+                           size_t size)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->PushConstant(shaderStage, offset, data, size);
+}
+
+void Subpass::BindUniformOffsets(uint32_t set, const uint32_t * offsets, uint32_t count)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->BindUniformOffsets(set, offsets, count);
+}
+
+void Subpass::SetDepthTestEnabled(bool enabled)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetDepthTestEnabled(enabled);
+}
+
+void Subpass::SetDepthWriteEnabled(bool enabled)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetDepthWriteEnabled(enabled);
+}
+
+void Subpass::SetDepthCompareOp(CompareOperation op)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetDepthCompareOp(op);
+}
+
+void Subpass::SetCullingMode(CullingMode mode)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetCullingMode(mode);
+}
+
+void Subpass::SetFrontFace(FrontFace face)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetFrontFace(face);
+}
+
+void Subpass::SetMeshTopology(MeshTopology topology)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetMeshTopology(topology);
+}
+
+void Subpass::SetStencilTestEnabled(bool enabled)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetStencilTestEnabled(enabled);
+}
+
+void Subpass::SetStencilOp(StencilFace face, StencilOperation failOp, StencilOperation passOp,
+                           StencilOperation depthFailOp, CompareOperation compareOp)
+{
+  if (auto * recorder = GetMainRecorder())
+    recorder->SetStencilOp(face, failOp, passOp, depthFailOp, compareOp);
 }
 
 bool Subpass::ShouldSwapCommandBuffers() const noexcept
@@ -132,7 +277,8 @@ void Subpass::SwapCommandBuffers() noexcept
 {
   {
     std::lock_guard lk{m_write_lock};
-    std::swap(m_execBuffer, m_writeBuffer);
+    std::swap(m_execRecorders, m_writeRecorders);
+    std::swap(m_execRecordersCount, m_writeRecordersCount);
     std::swap(m_execDescriptorBuffer, m_writeDescriptorBuffer);
   }
   m_shouldSwapBuffer = false;
@@ -143,19 +289,36 @@ void Subpass::SetDirtyCacheCommands() noexcept
   m_dirtyCommands = true;
 }
 
+bool Subpass::UsesInheritedViewport() const noexcept
+{
+  return GetContext().GetGpuConnection().GetFeatures().inheritedViewportScissor &&
+         !m_explicitViewport;
+}
+
 void Subpass::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer)
 {
   m_pipeline.TransitLayoutForUsedImages(commandBuffer);
 }
 
-const details::CommandBuffer & Subpass::GetCommandBufferForExecution() const & noexcept
+void Subpass::CollectCommandBuffersForExecution(std::vector<VkCommandBuffer> & buffers) const
 {
-  return m_execBuffer;
+  for (uint32_t i = 0; i < m_execRecordersCount; ++i)
+  {
+    auto && buffer = m_execRecorders[i].GetCommandBuffer();
+    if (!buffer.IsEmpty())
+      buffers.push_back(buffer.GetHandle());
+  }
 }
 
-details::CommandBuffer & Subpass::GetCommandBufferForWriting() & noexcept
+SubpassRecorder * Subpass::GetMainRecorder() & noexcept
 {
-  return m_writeBuffer;
+  if (!m_passActive)
+  {
+    GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                     "Subpass command is called outside of BeginPass/EndPass, it's ignored");
+    return nullptr;
+  }
+  return &m_writeRecorders.front();
 }
 
 const SubpassLayout & Subpass::GetLayout() const & noexcept
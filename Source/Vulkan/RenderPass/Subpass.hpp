@@ -1,5 +1,6 @@
 #pragma once
 #include <atomic>
+#include <deque>
 #include <mutex>
 
 #include <CommandsExecution/CommandBuffer.hpp>
@@ -7,6 +8,7 @@
 #include <Private/OwnedBy.hpp>
 #include <RenderPass/SubpassConfiguration.hpp>
 #include <RenderPass/SubpassLayout.hpp>
+#include <RenderPass/SubpassRecorder.hpp>
 #include <RHI.hpp>
 #include <vulkan/vulkan.hpp>
 
@@ -19,6 +21,7 @@ struct RenderPass;
 namespace RHI::vulkan
 {
 struct Subpass : public ISubpass,
+                 public IDescriptorsOwner,
                  public OwnedBy<Context>,
                  public OwnedBy<RenderPass>
 {
@@ -31,13 +34,16 @@ struct Subpass : public ISubpass,
 
 public: // ISubpass Interface
   virtual bool BeginPass() override;
+  virtual bool BeginParallelPass(uint32_t recordersCount) override;
+  virtual ISubpassCommands & GetRecorder(uint32_t index) & override;
   virtual void EndPass() override;
   virtual ISubpassConfiguration & GetConfiguration() & noexcept override;
   virtual void SetEnabled(bool enabled) noexcept override;
   virtual bool IsEnabled() const noexcept override;
   virtual bool ShouldBeInvalidated() const noexcept override;
+  virtual size_t GetElidedCommandsCount() const noexcept override;
 
-public: // Commands
+public: // Commands (recorded to the first recorder)
   /// @brief draw vertices command (analog glDrawArrays)
   void DrawVertices(std::uint32_t vertexCount, std::uint32_t instanceCount,
                     std::uint32_t firstVertex = 0, std::uint32_t firstInstance = 0) override;
@@ -47,25 +53,58 @@ public: // Commands
                            std::uint32_t firstIndex = 0, int32_t vertexOffset = 0,
                            std::uint32_t firstInstance = 0) override;
 
-  /// @brief Set viewport command
+  void DrawIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                    uint32_t stride = sizeof(DrawIndirectArgs)) override;
+  void DrawIndexedIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                           uint32_t stride = sizeof(DrawIndexedIndirectArgs)) override;
+  void DrawIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                         const IBufferGPU & countBuffer, uint32_t countOffset,
+                         uint32_t maxDrawCount,
+                         uint32_t stride = sizeof(DrawIndirectArgs)) override;
+  void DrawIndexedIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                const IBufferGPU & countBuffer, uint32_t countOffset,
+                                uint32_t maxDrawCount,
+                                uint32_t stride = sizeof(DrawIndexedIndirectArgs)) override;
+
+  /// @brief Set viewport command. Ignored if viewport is inherited from render target
   void SetViewport(float width, float height) override;
 
-  /// @brief Set scissor command
+  /// @brief Set scissor command. Ignored if scissor is inherited from render target
   void SetScissor(int32_t x, int32_t y, std::uint32_t width, std::uint32_t height) override;
 
   /// @brief binds buffer as input attribute data
   void BindVertexBuffer(std::uint32_t binding, const IBufferGPU & buffer,
                         std::uint32_t offset = 0) override;
 
+  /// @brief binds several buffers to consecutive bindings in one command
+  void BindVertexBuffers(std::uint32_t firstBinding,
+                         std::span<const VertexBufferBinding> buffers) override;
+
   /// @brief binds buffer as index buffer
   void BindIndexBuffer(const IBufferGPU & buffer, IndexType type,
                        std::uint32_t offset = 0) override;
 
+  using ISubpass::PushConstant;
   void PushConstant(const void * data, size_t size) override;
+  void PushConstant(ShaderType shaderStage, uint32_t offset, const void * data,
+                    size_t size) override;
+
+  void BindUniformOffsets(uint32_t set, const uint32_t * offsets, uint32_t count) override;
+
+public: // Dynamic states
+  void SetDepthTestEnabled(bool enabled) override;
+  void SetDepthWriteEnabled(bool enabled) override;
+  void SetDepthCompareOp(CompareOperation op) override;
+  void SetCullingMode(CullingMode mode) override;
+  void SetFrontFace(FrontFace face) override;
+  void SetMeshTopology(MeshTopology topology) override;
+  void SetStencilTestEnabled(bool enabled) override;
+  void SetStencilOp(StencilFace face, StencilOperation failOp, StencilOperation passOp,
+                    StencilOperation depthFailOp, CompareOperation compareOp) override;
 
 public:
-  const details::CommandBuffer & GetCommandBufferForExecution() const & noexcept;
-  details::CommandBuffer & GetCommandBufferForWriting() & noexcept;
+  /// @brief appends not empty buffers of recorders in order of execution
+  void CollectCommandBuffersForExecution(std::vector<VkCommandBuffer> & buffers) const;
   const SubpassLayout & GetLayout() const & noexcept;
   SubpassLayout & GetLayout() & noexcept;
 
@@ -75,26 +114,58 @@ public:
   bool ShouldSwapCommandBuffers() const noexcept;
   void SwapCommandBuffers() noexcept;
   void SetDirtyCacheCommands() noexcept;
+  /// @brief viewport and scissor are taken from render target, so resize doesn't dirty commands.
+  /// It's used only by subpasses which never set viewport or scissor
+  bool UsesInheritedViewport() const noexcept;
+  /// @brief appends transitions of used images into barriers of command buffer
   void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer);
 
+public: // IDescriptorsOwner interface
+  virtual void OnDescriptorChanged(const BufferUniform & descriptor) noexcept override
+  {
+    ScheduleDescriptorUpdate(descriptor);
+  }
+  virtual void OnDescriptorChanged(const SamplerUniform & descriptor) noexcept override
+  {
+    ScheduleDescriptorUpdate(descriptor);
+  }
+  virtual void OnDescriptorChanged(const SamplerArrayUniform & descriptor) noexcept override
+  {
+    ScheduleDescriptorUpdate(descriptor);
+  }
+  virtual void OnDescriptorChanged(const StorageImageUniform & descriptor) noexcept override
+  {
+    ScheduleDescriptorUpdate(descriptor);
+  }
+
+private:
   template<typename DescriptorT>
-  void OnDescriptorChanged(const DescriptorT & descriptor) noexcept
+  void ScheduleDescriptorUpdate(const DescriptorT & descriptor) noexcept
   {
     m_execDescriptorBuffer.UpdateDescriptor(descriptor);
     m_writeDescriptorBuffer.UpdateDescriptor(descriptor);
     SetDirtyCacheCommands();
   }
 
+private:
+  /// @brief Returns recorder of current pass or nullptr if pass is not begun
+  SubpassRecorder * GetMainRecorder() & noexcept;
+
 private:
   SubpassConfiguration m_pipeline;
   std::atomic_bool m_enabled = true;
   VkRenderPass m_cachedRenderPass = VK_NULL_HANDLE;
 
-  details::CommandBuffer m_execBuffer;
-  details::CommandBuffer m_writeBuffer;
+  uint32_t m_familyIndex;
+  std::deque<SubpassRecorder> m_execRecorders;
+  std::deque<SubpassRecorder> m_writeRecorders;
+  uint32_t m_execRecordersCount = 0;
+  uint32_t m_writeRecordersCount = 0;
   mutable std::mutex m_write_lock;
+  std::atomic_bool m_passActive = false; ///< commands are recorded between BeginPass and EndPass
   std::atomic_bool m_dirtyCommands = true; ///< flag to refill m_writingBuffer
   std::atomic_bool m_shouldSwapBuffer = false;
+  std::atomic_bool m_explicitViewport = false; ///< subpass sets its own viewport or scissor
   DescriptorBuffer m_execDescriptorBuffer;
   DescriptorBuffer m_writeDescriptorBuffer;
 
@@ -12,14 +12,16 @@ SubpassConfiguration::SubpassConfiguration(Context & ctx, Subpass & owner, uint3
   : OwnedBy<Context>(ctx)
   , OwnedBy<Subpass>(owner)
   , m_subpassIndex(subpassIndex)
-  , m_descriptorsLayout(ctx, *this)
+  , m_descriptorsLayout(ctx, owner)
 {
+  m_pipelineBuilder.SetExtendedDynamicStateEnabled(
+    ctx.GetGpuConnection().GetFeatures().extendedDynamicState);
 }
 
 SubpassConfiguration::~SubpassConfiguration()
 {
   GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pipeline, nullptr);
-  GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pipelineLayout, nullptr);
+  GetContext().GetLayoutCache().ReleasePipelineLayout(m_pipelineLayout);
 }
 
 void SubpassConfiguration::AttachShader(ShaderType type, const SpirV & spirv)
@@ -68,7 +70,8 @@ IBufferUniformDescriptor * SubpassConfiguration::DeclareUniform(LayoutIndex inde
                                                                 ShaderType shaderStage)
 {
   IBufferUniformDescriptor * result = nullptr;
-  m_descriptorsLayout.DeclareBufferUniformsArray(index, shaderStage, 1, &result);
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                                 shaderStage, 1, &result);
   return result;
 }
 
@@ -84,7 +87,8 @@ void SubpassConfiguration::DeclareUniformsArray(LayoutIndex index, ShaderType sh
                                                 uint32_t size,
                                                 IBufferUniformDescriptor * outArray[])
 {
-  m_descriptorsLayout.DeclareBufferUniformsArray(index, shaderStage, size, outArray);
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                                 shaderStage, size, outArray);
 }
 
 void SubpassConfiguration::DeclareSamplersArray(LayoutIndex index, ShaderType shaderStage,
@@ -94,67 +98,130 @@ void SubpassConfiguration::DeclareSamplersArray(LayoutIndex index, ShaderType sh
   m_descriptorsLayout.DeclareSamplerUniformsArray(index, shaderStage, size, outArray);
 }
 
+IBufferUniformDescriptor * SubpassConfiguration::DeclareStorageBuffer(LayoutIndex index,
+                                                                      ShaderType shaderStage)
+{
+  IBufferUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                 shaderStage, 1, &result);
+  return result;
+}
+
+IStorageImageDescriptor * SubpassConfiguration::DeclareStorageImage(LayoutIndex index,
+                                                                    ShaderType shaderStage)
+{
+  IStorageImageDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareStorageImagesArray(index, shaderStage, 1, &result);
+  return result;
+}
+
+IBufferUniformDescriptor * SubpassConfiguration::DeclareDynamicUniform(LayoutIndex index,
+                                                                       ShaderType shaderStage,
+                                                                       uint32_t blockSize)
+{
+  IBufferUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                                 shaderStage, 1, &result, blockSize);
+  return result;
+}
+
+IBufferUniformDescriptor * SubpassConfiguration::DeclareDynamicStorageBuffer(LayoutIndex index,
+                                                                             ShaderType shaderStage,
+                                                                             uint32_t blockSize)
+{
+  IBufferUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareBufferUniformsArray(index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+                                                 shaderStage, 1, &result, blockSize);
+  return result;
+}
+
+ISamplerUniformDescriptor * SubpassConfiguration::DeclareImmutableSampler(LayoutIndex index,
+                                                                          ShaderType shaderStage)
+{
+  ISamplerUniformDescriptor * result = nullptr;
+  m_descriptorsLayout.DeclareSamplerUniformsArray(index, shaderStage, 1, &result, true);
+  return result;
+}
+
+void SubpassConfiguration::UseBindlessTextures(uint32_t set)
+{
+  m_descriptorsLayout.UseBindlessTable(set);
+  m_invalidPipelineLayout = true;
+}
 
-void SubpassConfiguration::DefinePushConstant(uint32_t size, ShaderType shaderStage)
+void SubpassConfiguration::DefinePushConstant(uint32_t size, ShaderType shaderStage,
+                                              uint32_t offset)
 {
   VkPushConstantRange newPushConstantRange{};
-  newPushConstantRange.offset = 0;
+  newPushConstantRange.offset = offset;
   newPushConstantRange.size = size;
   newPushConstantRange.stageFlags =
     utils::CastInterfaceEnum2Vulkan<VkShaderStageFlagBits>(shaderStage);
-  m_pushConstantRange.emplace(newPushConstantRange);
+  utils::DefinePushConstantRange(
+    m_pushConstantRanges, newPushConstantRange,
+    GetContext().GetGpuConnection().GetGpuProperties().limits.maxPushConstantsSize);
   m_invalidPipelineLayout = true;
 }
 
 void SubpassConfiguration::SetMeshTopology(MeshTopology topology) noexcept
 {
   m_pipelineBuilder.SetMeshTopology(topology);
-  m_invalidPipeline = true;
-  m_invalidPipeline.notify_one();
+  OnPipelineStateChanged();
 }
 
 void SubpassConfiguration::EnableDepthTest(bool enabled) noexcept
 {
   m_pipelineBuilder.SetDepthTestEnabled(enabled);
-  m_invalidPipeline = true;
-  m_invalidPipeline.notify_one();
-  GetSubpass().SetInvalid();
+  OnPipelineStateChanged();
 }
 
 void SubpassConfiguration::SetDepthFunc(CompareOperation op) noexcept
 {
   m_pipelineBuilder.SetDepthTestCompareOperator(op);
-  m_invalidPipeline = true;
-  m_invalidPipeline.notify_one();
+  OnPipelineStateChanged();
 }
 
 void SubpassConfiguration::Invalidate()
 {
-  m_descriptorsLayout.Invalidate();
+  // pipeline layout refers to set layouts, so it's rebuilt with them
+  if (m_descriptorsLayout.Invalidate())
+    m_invalidPipelineLayout = true;
 
   if (m_invalidPipelineLayout || !m_pipelineLayout)
   {
-    auto && layoutHandles = m_descriptorsLayout.GetHandles();
-    auto new_layout = m_pipelineLayoutBuilder.Make(GetContext().GetGpuConnection().GetDevice(),
-                                                   layoutHandles.data(),
-                                                   static_cast<uint32_t>(layoutHandles.size()),
-                                                   m_pushConstantRange.has_value()
-                                                     ? &m_pushConstantRange.value()
-                                                     : nullptr);
-    GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pipelineLayout, nullptr);
+    m_pipelineLayoutBuilder.Reset();
+    m_pipelineLayoutBuilder.SetDescriptorSetLayouts(m_descriptorsLayout.GetHandles());
+    for (auto && range : m_pushConstantRanges)
+      m_pipelineLayoutBuilder.AddPushConstantRange(range);
+    // identical pipeline layouts are shared, so pipeline is rebuilt only if layout is changed
+    auto && layoutCache = GetContext().GetLayoutCache();
+    auto new_layout = layoutCache.AcquirePipelineLayout(m_pipelineLayoutBuilder);
+    layoutCache.ReleasePipelineLayout(m_pipelineLayout);
+    if (new_layout != m_pipelineLayout)
+      m_invalidPipeline = true;
     m_pipelineLayout = new_layout;
     m_invalidPipelineLayout = false;
-    m_invalidPipeline = true;
-    GetContext().Log(RHI::LogMessageStatus::LOG_DEBUG, "VkPipelineLayout has been rebuilt");
   }
 
   if (m_invalidPipeline || !m_pipeline)
   {
     m_pipelineBuilder.SetSamplesCount(
       GetSubpass().GetRenderPass().GetFramebuffer().CalcSamplesCount());
-    auto new_pipeline = m_pipelineBuilder.Make(GetContext().GetGpuConnection().GetDevice(),
-                                               GetSubpass().GetRenderPass().GetHandle(),
-                                               m_subpassIndex, m_pipelineLayout);
+    auto && renderPass = GetSubpass().GetRenderPass();
+    VkPipeline new_pipeline = VK_NULL_HANDLE;
+    if (renderPass.UsesDynamicRendering())
+    {
+      // pipeline is compatible with any rendering scope which has the same attachment formats
+      const auto renderingInfo = GetSubpass().GetLayout().BuildRenderingCreateInfo();
+      new_pipeline = m_pipelineBuilder.Make(GetContext().GetGpuConnection().GetDevice(),
+                                            VK_NULL_HANDLE, 0, m_pipelineLayout, &renderingInfo);
+    }
+    else
+    {
+      new_pipeline = m_pipelineBuilder.Make(GetContext().GetGpuConnection().GetDevice(),
+                                            renderPass.GetHandle(), m_subpassIndex,
+                                            m_pipelineLayout);
+    }
     GetContext().GetGarbageCollector().PushVkObjectToDestroy(m_pipeline, nullptr);
     m_pipeline = new_pipeline;
     m_invalidPipeline = false;
@@ -194,11 +261,38 @@ void SubpassConfiguration::BindToCommandBuffer(const VkCommandBuffer & buffer,
 {
   assert(!!m_pipeline);
   vkCmdBindPipeline(buffer, bindPoint, m_pipeline);
+  if (m_pipelineBuilder.IsExtendedDynamicStateEnabled())
+    m_pipelineBuilder.RecordDynamicStates(buffer);
 }
 
 void SubpassConfiguration::TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer)
 {
-  m_descriptorsLayout.TransitLayoutForUsedImages(commandBuffer);
+  // stages of disabled features are invalid in barriers
+  auto && features = GetContext().GetGpuConnection().GetFeatures();
+  VkPipelineStageFlags2 stages =
+    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+  if (features.tessellationShader)
+    stages |= VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT |
+              VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT;
+  if (features.geometryShader)
+    stages |= VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT;
+  m_descriptorsLayout.TransitLayoutForUsedImages(commandBuffer, stages);
+}
+
+void SubpassConfiguration::OnPipelineStateChanged() noexcept
+{
+  if (m_pipelineBuilder.IsExtendedDynamicStateEnabled())
+  {
+    // state is set in command buffer, so only commands must be rewritten
+    GetSubpass().SetDirtyCacheCommands();
+  }
+  else
+  {
+    m_invalidPipeline = true;
+    m_invalidPipeline.notify_one();
+    // recorded commands refer to old pipeline
+    GetSubpass().SetInvalid();
+  }
 }
 
 } // namespace RHI::vulkan
@@ -33,7 +33,8 @@ public: // ISubpassConfiguration interface
   virtual void AddInputBinding(uint32_t slot, uint32_t stride, InputBindingType type) override;
   virtual void AddInputAttribute(uint32_t binding, uint32_t location, uint32_t offset,
                                  uint32_t elemsCount, InputAttributeElementType elemsType) override;
-  virtual void DefinePushConstant(uint32_t size, ShaderType shaderStage) override;
+  virtual void DefinePushConstant(uint32_t size, ShaderType shaderStage,
+                                  uint32_t offset = 0) override;
   virtual IBufferUniformDescriptor * DeclareUniform(LayoutIndex index,
                                                     ShaderType shaderStage) override;
   virtual ISamplerUniformDescriptor * DeclareSampler(LayoutIndex index,
@@ -44,6 +45,19 @@ public: // ISubpassConfiguration interface
   /// Sampler2D / Sampler2DArray uniform
   virtual void DeclareSamplersArray(LayoutIndex index, ShaderType shaderStage, uint32_t size,
                                     ISamplerUniformDescriptor * outArray[]) override;
+  virtual IBufferUniformDescriptor * DeclareStorageBuffer(LayoutIndex index,
+                                                          ShaderType shaderStage) override;
+  virtual IStorageImageDescriptor * DeclareStorageImage(LayoutIndex index,
+                                                        ShaderType shaderStage) override;
+  virtual IBufferUniformDescriptor * DeclareDynamicUniform(LayoutIndex index,
+                                                           ShaderType shaderStage,
+                                                           uint32_t blockSize) override;
+  virtual IBufferUniformDescriptor * DeclareDynamicStorageBuffer(LayoutIndex index,
+                                                                 ShaderType shaderStage,
+                                                                 uint32_t blockSize) override;
+  virtual ISamplerUniformDescriptor * DeclareImmutableSampler(LayoutIndex index,
+                                                              ShaderType shaderStage) override;
+  virtual void UseBindlessTextures(uint32_t set) override;
 
   virtual uint32_t GetSubpassIndex() const noexcept override { return m_subpassIndex; }
   virtual void SetMeshTopology(MeshTopology topology) noexcept override;
@@ -60,13 +74,21 @@ public: // public internal API
   VkPipeline GetPipelineHandle() const noexcept { return m_pipeline; }
   VkPipelineLayout GetPipelineLayoutHandle() const noexcept { return m_pipelineLayout; }
   const DescriptorBufferLayout & GetDescriptorsLayout() const & noexcept;
+  const std::vector<VkPushConstantRange> & GetPushConstantRanges() const & noexcept
+  {
+    return m_pushConstantRanges;
+  }
   void BindToCommandBuffer(const VkCommandBuffer & buffer, VkPipelineBindPoint bindPoint);
   void TransitLayoutForUsedImages(details::CommandBuffer & commandBuffer);
 
+private:
+  /// @brief applies changed state: rebuilds pipeline or rewrites commands if state is dynamic
+  void OnPipelineStateChanged() noexcept;
+
 private:
   uint32_t m_subpassIndex;
 
-  std::optional<VkPushConstantRange> m_pushConstantRange = std::nullopt;
+  std::vector<VkPushConstantRange> m_pushConstantRanges;
   DescriptorBufferLayout m_descriptorsLayout;
   VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
   VkPipeline m_pipeline = VK_NULL_HANDLE;
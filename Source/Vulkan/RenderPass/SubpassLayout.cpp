@@ -5,6 +5,23 @@ bool operator==(const VkAttachmentReference & ref1, const VkAttachmentReference
   return std::memcmp(&ref1, &ref2, sizeof(VkAttachmentReference)) == 0;
 }
 
+namespace
+{
+constexpr bool HasStencilComponent(VkFormat format) noexcept
+{
+  switch (format)
+  {
+    case VK_FORMAT_S8_UINT:
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
 namespace RHI::vulkan
 {
 SubpassLayout::SubpassLayout(VkPipelineBindPoint bindPoint)
@@ -90,4 +107,59 @@ void SubpassLayout::ForEachAttachment(std::function<void(uint32_t attachmentIdx)
     func(m_depthStencilAttachment.attachment);
 }
 
+bool SubpassLayout::SetAttachmentFormats(const std::vector<VkAttachmentDescription> & attachments)
+{
+  std::vector<VkFormat> colorFormats;
+  colorFormats.reserve(m_colorAttachments.size());
+  VkSampleCountFlagBits samplesCount = VK_SAMPLE_COUNT_1_BIT;
+  for (auto && ref : m_colorAttachments)
+  {
+    colorFormats.push_back(attachments.at(ref.attachment).format);
+    samplesCount = attachments[ref.attachment].samples;
+  }
+
+  VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+  VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+  if (UseDepthStencil())
+  {
+    auto && description = attachments.at(m_depthStencilAttachment.attachment);
+    depthFormat = description.format;
+    stencilFormat = HasStencilComponent(description.format) ? description.format
+                                                            : VK_FORMAT_UNDEFINED;
+    samplesCount = description.samples;
+  }
+
+  const bool changed = colorFormats != m_colorFormats || depthFormat != m_depthFormat ||
+                       stencilFormat != m_stencilFormat || samplesCount != m_samplesCount;
+  m_colorFormats = std::move(colorFormats);
+  m_depthFormat = depthFormat;
+  m_stencilFormat = stencilFormat;
+  m_samplesCount = samplesCount;
+  return changed;
+}
+
+VkPipelineRenderingCreateInfo SubpassLayout::BuildRenderingCreateInfo() const noexcept
+{
+  VkPipelineRenderingCreateInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+  info.colorAttachmentCount = static_cast<uint32_t>(m_colorFormats.size());
+  info.pColorAttachmentFormats = m_colorFormats.data();
+  info.depthAttachmentFormat = m_depthFormat;
+  info.stencilAttachmentFormat = m_stencilFormat;
+  return info;
+}
+
+VkCommandBufferInheritanceRenderingInfo SubpassLayout::BuildInheritanceRenderingInfo()
+  const noexcept
+{
+  VkCommandBufferInheritanceRenderingInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+  info.colorAttachmentCount = static_cast<uint32_t>(m_colorFormats.size());
+  info.pColorAttachmentFormats = m_colorFormats.data();
+  info.depthAttachmentFormat = m_depthFormat;
+  info.stencilAttachmentFormat = m_stencilFormat;
+  info.rasterizationSamples = m_samplesCount;
+  return info;
+}
+
 } // namespace RHI::vulkan
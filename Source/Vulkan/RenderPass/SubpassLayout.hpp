@@ -14,6 +14,28 @@ struct SubpassLayout final
   VkSubpassDescription BuildDescription() const noexcept;
   void ForEachAttachment(std::function<void(uint32_t attachmentIdx)> && func) const;
 
+  /// @brief input attachments can't be read without VkRenderPass
+  bool HasInputAttachments() const noexcept { return !m_inputAttachments.empty(); }
+  const std::vector<VkAttachmentReference> & GetColorAttachments() const & noexcept
+  {
+    return m_colorAttachments;
+  }
+  const std::vector<VkAttachmentReference> & GetResolveAttachments() const & noexcept
+  {
+    return m_resolveAttachments;
+  }
+  const VkAttachmentReference & GetDepthStencilAttachment() const & noexcept
+  {
+    return m_depthStencilAttachment;
+  }
+
+  // dynamic rendering
+  /// @brief caches formats of used attachments. Returns true if they have been changed
+  bool SetAttachmentFormats(const std::vector<VkAttachmentDescription> & attachments);
+  bool UseStencil() const noexcept { return m_stencilFormat != VK_FORMAT_UNDEFINED; }
+  VkPipelineRenderingCreateInfo BuildRenderingCreateInfo() const noexcept;
+  VkCommandBufferInheritanceRenderingInfo BuildInheritanceRenderingInfo() const noexcept;
+
 private:
   VkPipelineBindPoint m_bindPoint;
   std::vector<VkAttachmentReference> m_colorAttachments;
@@ -22,5 +44,10 @@ private:
   /// for MSAA. The same size as m_colorAttachments
   std::vector<VkAttachmentReference> m_resolveAttachments;
   VkAttachmentReference m_depthStencilAttachment{VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED};
+
+  std::vector<VkFormat> m_colorFormats;
+  VkFormat m_depthFormat = VK_FORMAT_UNDEFINED;
+  VkFormat m_stencilFormat = VK_FORMAT_UNDEFINED;
+  VkSampleCountFlagBits m_samplesCount = VK_SAMPLE_COUNT_1_BIT;
 };
 } // namespace RHI::vulkan
@@ -0,0 +1,316 @@
+#include "SubpassRecorder.hpp"
+
+#include <Descriptors/DescriptorsBuffer.hpp>
+#include <RenderPass/SubpassConfiguration.hpp>
+#include <Resources/BufferGPU.hpp>
+#include <Utils/CastHelper.hpp>
+#include <VulkanContext.hpp>
+
+namespace RHI::vulkan
+{
+SubpassRecorder::SubpassRecorder(Context & ctx, SubpassConfiguration & pipeline,
+                                 uint32_t familyIndex)
+  : OwnedBy<Context>(ctx)
+  , m_pipeline(&pipeline)
+  , m_buffer(ctx, familyIndex, VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+{
+}
+
+void SubpassRecorder::BeginWriting(
+  VkRenderPass renderPass, bool inheritViewportScissor, DescriptorBuffer & descriptors,
+  const VkCommandBufferInheritanceRenderingInfo * renderingInfo /* = nullptr*/)
+{
+  m_descriptors = &descriptors;
+  m_inheritedViewport = inheritViewportScissor;
+  m_explicitViewportRequested = false;
+  m_buffer.Reset();
+  // with dynamic rendering every subpass is a separate rendering scope, so its index is zero
+  m_buffer.BeginWriting(renderPass, renderingInfo ? 0 : m_pipeline->GetSubpassIndex(),
+                        VK_NULL_HANDLE, inheritViewportScissor, renderingInfo);
+  m_pipeline->BindToCommandBuffer(m_buffer.GetHandle(), VK_PIPELINE_BIND_POINT_GRAPHICS);
+  descriptors.BindToCommandBuffer(m_buffer.GetHandle(), m_pipeline->GetPipelineLayoutHandle(),
+                                  VK_PIPELINE_BIND_POINT_GRAPHICS);
+}
+
+void SubpassRecorder::EndWriting()
+{
+  m_buffer.EndWriting();
+  m_descriptors = nullptr;
+}
+
+template<typename VkCmdFunc, typename... Args>
+void SubpassRecorder::PushDynamicStateCommand(VkDynamicState state, uint64_t packedValue,
+                                              VkCmdFunc && func, Args &&... args)
+{
+  if (!CheckDynamicStateSupported())
+    return;
+  if (m_buffer.GetStateCache().UpdateDynamicState(state, packedValue))
+    m_buffer.PushCommand(std::forward<VkCmdFunc>(func), std::forward<Args>(args)...);
+}
+
+void SubpassRecorder::DrawVertices(std::uint32_t vertexCount, std::uint32_t instanceCount,
+                                   std::uint32_t firstVertex, std::uint32_t firstInstance)
+{
+  m_buffer.PushCommand(vkCmdDraw, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void SubpassRecorder::DrawIndexedVertices(std::uint32_t indexCount, std::uint32_t instanceCount,
+                                          std::uint32_t firstIndex, int32_t vertexOffset,
+                                          std::uint32_t firstInstance)
+{
+  m_buffer.PushCommand(vkCmdDrawIndexed, indexCount, instanceCount, firstIndex, vertexOffset,
+                       firstInstance);
+}
+
+template<typename DrawFuncT>
+void SubpassRecorder::PushDrawIndirect(DrawFuncT && func, VkBuffer buffer, uint32_t offset,
+                                       uint32_t drawCount, uint32_t stride)
+{
+  if (drawCount <= 1 || GetContext().GetGpuConnection().GetFeatures().multiDrawIndirect)
+  {
+    m_buffer.PushCommand(func, buffer, VkDeviceSize{offset}, drawCount, stride);
+    return;
+  }
+  for (uint32_t i = 0; i < drawCount; ++i)
+    m_buffer.PushCommand(func, buffer, VkDeviceSize{offset} + VkDeviceSize{i} * stride, 1u,
+                         stride);
+}
+
+void SubpassRecorder::DrawIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                                   uint32_t stride)
+{
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  PushDrawIndirect(vkCmdDrawIndirect, vkBuffer.GetHandle(), offset, drawCount, stride);
+}
+
+void SubpassRecorder::DrawIndexedIndirect(const IBufferGPU & buffer, uint32_t offset,
+                                          uint32_t drawCount, uint32_t stride)
+{
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  PushDrawIndirect(vkCmdDrawIndexedIndirect, vkBuffer.GetHandle(), offset, drawCount, stride);
+}
+
+void SubpassRecorder::DrawIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                        const IBufferGPU & countBuffer, uint32_t countOffset,
+                                        uint32_t maxDrawCount, uint32_t stride)
+{
+  if (!CheckDrawIndirectCountSupported())
+    return;
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  auto && vkCountBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(countBuffer);
+  m_buffer.PushCommand(vkCmdDrawIndirectCount, vkBuffer.GetHandle(), VkDeviceSize{offset},
+                       vkCountBuffer.GetHandle(), VkDeviceSize{countOffset}, maxDrawCount,
+                       stride);
+}
+
+void SubpassRecorder::DrawIndexedIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                               const IBufferGPU & countBuffer, uint32_t countOffset,
+                                               uint32_t maxDrawCount, uint32_t stride)
+{
+  if (!CheckDrawIndirectCountSupported())
+    return;
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  auto && vkCountBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(countBuffer);
+  m_buffer.PushCommand(vkCmdDrawIndexedIndirectCount, vkBuffer.GetHandle(),
+                       VkDeviceSize{offset}, vkCountBuffer.GetHandle(),
+                       VkDeviceSize{countOffset}, maxDrawCount, stride);
+}
+
+void SubpassRecorder::SetViewport(float width, float height)
+{
+  // command buffer with inherited viewport can't set it, so subpass is recorded again without it
+  if (m_inheritedViewport)
+  {
+    m_explicitViewportRequested = true;
+    return;
+  }
+  VkViewport vp{0.0f, 0.0f, width, height, 0.0f, 1.0f};
+  if (m_buffer.GetStateCache().UpdateViewport(vp))
+    m_buffer.PushCommand(vkCmdSetViewport, 0, 1, &vp);
+}
+
+void SubpassRecorder::SetScissor(int32_t x, int32_t y, std::uint32_t width, std::uint32_t height)
+{
+  if (m_inheritedViewport)
+  {
+    m_explicitViewportRequested = true;
+    return;
+  }
+  VkRect2D scissor{};
+  scissor.extent = {width, height};
+  scissor.offset = {x, y};
+  if (m_buffer.GetStateCache().UpdateScissor(scissor))
+    m_buffer.PushCommand(vkCmdSetScissor, 0, 1, &scissor);
+}
+
+void SubpassRecorder::BindVertexBuffer(std::uint32_t binding, const IBufferGPU & buffer,
+                                       std::uint32_t offset)
+{
+  VkDeviceSize vkOffset = offset;
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  VkBuffer buf = vkBuffer.GetHandle();
+  if (m_buffer.GetStateCache().UpdateVertexBuffers(binding, {&buf, 1}, {&vkOffset, 1}))
+    m_buffer.PushCommand(vkCmdBindVertexBuffers, binding, 1u, &buf, &vkOffset);
+}
+
+void SubpassRecorder::BindVertexBuffers(std::uint32_t firstBinding,
+                                        std::span<const VertexBufferBinding> buffers)
+{
+  if (buffers.empty())
+    return;
+  std::vector<VkBuffer> vkBuffers;
+  std::vector<VkDeviceSize> vkOffsets;
+  vkBuffers.reserve(buffers.size());
+  vkOffsets.reserve(buffers.size());
+  for (auto && [buffer, offset] : buffers)
+  {
+    if (!buffer)
+      throw std::invalid_argument("BindVertexBuffers - buffer is null");
+    vkBuffers.push_back(utils::CastInterfaceClass2Internal<BufferGPU>(*buffer).GetHandle());
+    vkOffsets.push_back(VkDeviceSize{offset});
+  }
+  if (!m_buffer.GetStateCache().UpdateVertexBuffers(firstBinding, vkBuffers, vkOffsets))
+    return;
+  m_buffer.PushCommand(vkCmdBindVertexBuffers, firstBinding,
+                       static_cast<uint32_t>(vkBuffers.size()), vkBuffers.data(),
+                       vkOffsets.data());
+}
+
+void SubpassRecorder::BindIndexBuffer(const IBufferGPU & buffer, IndexType type,
+                                      std::uint32_t offset)
+{
+  auto && vkBuffer = utils::CastInterfaceClass2Internal<BufferGPU>(buffer);
+  const VkIndexType vkType = utils::CastInterfaceEnum2Vulkan<VkIndexType>(type);
+  if (m_buffer.GetStateCache().UpdateIndexBuffer(vkBuffer.GetHandle(), offset, vkType))
+    m_buffer.PushCommand(vkCmdBindIndexBuffer, vkBuffer.GetHandle(), VkDeviceSize{offset}, vkType);
+}
+
+void SubpassRecorder::PushConstant(const void * data, size_t size)
+{
+  const auto vkSize = static_cast<uint32_t>(size);
+  const VkShaderStageFlags stages =
+    utils::GetPushConstantStages(m_pipeline->GetPushConstantRanges(), 0, vkSize);
+  if (!CheckPushConstant(stages, 0, vkSize))
+    return;
+  if (!m_buffer.GetStateCache().UpdatePushConstants(stages, 0, vkSize, data))
+    return;
+  m_buffer.PushCommand(vkCmdPushConstants, m_pipeline->GetPipelineLayoutHandle(), stages, 0u,
+                       vkSize, data);
+}
+
+void SubpassRecorder::PushConstant(ShaderType shaderStage, uint32_t offset, const void * data,
+                                   size_t size)
+{
+  const auto vkSize = static_cast<uint32_t>(size);
+  const VkShaderStageFlags stages =
+    utils::CastInterfaceEnum2Vulkan<VkShaderStageFlagBits>(shaderStage);
+  if (!CheckPushConstant(stages, offset, vkSize))
+    return;
+  if (!m_buffer.GetStateCache().UpdatePushConstants(stages, offset, vkSize, data))
+    return;
+  m_buffer.PushCommand(vkCmdPushConstants, m_pipeline->GetPipelineLayoutHandle(), stages,
+                       offset, vkSize, data);
+}
+
+void SubpassRecorder::BindUniformOffsets(uint32_t set, const uint32_t * offsets, uint32_t count)
+{
+  m_descriptors->BindDynamicOffsets(m_buffer, m_pipeline->GetPipelineLayoutHandle(),
+                                    VK_PIPELINE_BIND_POINT_GRAPHICS, set, {offsets, count});
+}
+
+void SubpassRecorder::SetDepthTestEnabled(bool enabled)
+{
+  const VkBool32 value = enabled ? VK_TRUE : VK_FALSE;
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, value, vkCmdSetDepthTestEnable,
+                          value);
+}
+
+void SubpassRecorder::SetDepthWriteEnabled(bool enabled)
+{
+  const VkBool32 value = enabled ? VK_TRUE : VK_FALSE;
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE, value, vkCmdSetDepthWriteEnable,
+                          value);
+}
+
+void SubpassRecorder::SetDepthCompareOp(CompareOperation op)
+{
+  const VkCompareOp value = utils::CastInterfaceEnum2Vulkan<VkCompareOp>(op);
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP, value, vkCmdSetDepthCompareOp,
+                          value);
+}
+
+void SubpassRecorder::SetCullingMode(CullingMode mode)
+{
+  const VkCullModeFlags value = utils::CastInterfaceEnum2Vulkan<VkCullModeFlags>(mode);
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_CULL_MODE, value, vkCmdSetCullMode, value);
+}
+
+void SubpassRecorder::SetFrontFace(FrontFace face)
+{
+  const VkFrontFace value = utils::CastInterfaceEnum2Vulkan<VkFrontFace>(face);
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_FRONT_FACE, value, vkCmdSetFrontFace, value);
+}
+
+void SubpassRecorder::SetMeshTopology(MeshTopology topology)
+{
+  const VkPrimitiveTopology value = utils::CastInterfaceEnum2Vulkan<VkPrimitiveTopology>(topology);
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY, value, vkCmdSetPrimitiveTopology,
+                          value);
+}
+
+void SubpassRecorder::SetStencilTestEnabled(bool enabled)
+{
+  const VkBool32 value = enabled ? VK_TRUE : VK_FALSE;
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE, value, vkCmdSetStencilTestEnable,
+                          value);
+}
+
+void SubpassRecorder::SetStencilOp(StencilFace face, StencilOperation failOp,
+                                   StencilOperation passOp, StencilOperation depthFailOp,
+                                   CompareOperation compareOp)
+{
+  const auto vkFace = utils::CastInterfaceEnum2Vulkan<VkStencilFaceFlags>(face);
+  const auto vkFailOp = utils::CastInterfaceEnum2Vulkan<VkStencilOp>(failOp);
+  const auto vkPassOp = utils::CastInterfaceEnum2Vulkan<VkStencilOp>(passOp);
+  const auto vkDepthFailOp = utils::CastInterfaceEnum2Vulkan<VkStencilOp>(depthFailOp);
+  const auto vkCompareOp = utils::CastInterfaceEnum2Vulkan<VkCompareOp>(compareOp);
+  // every argument fits in a byte, so the whole call is packed in one value
+  const uint64_t packed =
+    static_cast<uint64_t>(vkFace) | (static_cast<uint64_t>(vkFailOp) << 8) |
+    (static_cast<uint64_t>(vkPassOp) << 16) | (static_cast<uint64_t>(vkDepthFailOp) << 24) |
+    (static_cast<uint64_t>(vkCompareOp) << 32);
+  PushDynamicStateCommand(VK_DYNAMIC_STATE_STENCIL_OP, packed, vkCmdSetStencilOp, vkFace, vkFailOp,
+                          vkPassOp, vkDepthFailOp, vkCompareOp);
+}
+
+bool SubpassRecorder::CheckDynamicStateSupported() const noexcept
+{
+  if (GetContext().GetGpuConnection().GetFeatures().extendedDynamicState)
+    return true;
+  GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                   "Dynamic state command is ignored - extended dynamic state is not supported");
+  return false;
+}
+
+bool SubpassRecorder::CheckDrawIndirectCountSupported() const noexcept
+{
+  if (GetContext().GetGpuConnection().GetFeatures().drawIndirectCount)
+    return true;
+  GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                   "Draw command is ignored - indirect count draws are not supported");
+  return false;
+}
+
+bool SubpassRecorder::CheckPushConstant(VkShaderStageFlags stages, uint32_t offset,
+                                        uint32_t size) const noexcept
+{
+  const char * error =
+    utils::ValidatePushConstant(m_pipeline->GetPushConstantRanges(), stages, offset, size);
+  if (!error)
+    return true;
+  GetContext().Log(RHI::LogMessageStatus::LOG_ERROR,
+                   std::string("Push constant is ignored - ") + error);
+  return false;
+}
+
+} // namespace RHI::vulkan
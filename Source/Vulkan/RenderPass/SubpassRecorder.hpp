@@ -0,0 +1,121 @@
+#pragma once
+
+#include <CommandsExecution/CommandBuffer.hpp>
+#include <Private/OwnedBy.hpp>
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace RHI::vulkan
+{
+struct Context;
+struct DescriptorBuffer;
+struct SubpassConfiguration;
+} // namespace RHI::vulkan
+
+namespace RHI::vulkan
+{
+/// @brief secondary command buffer of subpass with its own command pool.
+/// Several recorders of one subpass can be filled from different threads
+struct SubpassRecorder final : public ISubpassCommands,
+                               public OwnedBy<Context>
+{
+  explicit SubpassRecorder(Context & ctx, SubpassConfiguration & pipeline, uint32_t familyIndex);
+  virtual ~SubpassRecorder() override = default;
+  MAKE_ALIAS_FOR_GET_OWNER(Context, GetContext);
+
+public: // Commands
+  /// @brief draw vertices command (analog glDrawArrays)
+  void DrawVertices(std::uint32_t vertexCount, std::uint32_t instanceCount,
+                    std::uint32_t firstVertex = 0, std::uint32_t firstInstance = 0) override;
+
+  /// @brief draw vertices with indieces (analog glDrawElements)
+  void DrawIndexedVertices(std::uint32_t indexCount, std::uint32_t instanceCount,
+                           std::uint32_t firstIndex = 0, int32_t vertexOffset = 0,
+                           std::uint32_t firstInstance = 0) override;
+
+  void DrawIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                    uint32_t stride = sizeof(DrawIndirectArgs)) override;
+  void DrawIndexedIndirect(const IBufferGPU & buffer, uint32_t offset, uint32_t drawCount,
+                           uint32_t stride = sizeof(DrawIndexedIndirectArgs)) override;
+  void DrawIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                         const IBufferGPU & countBuffer, uint32_t countOffset,
+                         uint32_t maxDrawCount,
+                         uint32_t stride = sizeof(DrawIndirectArgs)) override;
+  void DrawIndexedIndirectCount(const IBufferGPU & buffer, uint32_t offset,
+                                const IBufferGPU & countBuffer, uint32_t countOffset,
+                                uint32_t maxDrawCount,
+                                uint32_t stride = sizeof(DrawIndexedIndirectArgs)) override;
+
+  /// @brief Set viewport command. Ignored if viewport is inherited from render target
+  void SetViewport(float width, float height) override;
+
+  /// @brief Set scissor command. Ignored if scissor is inherited from render target
+  void SetScissor(int32_t x, int32_t y, std::uint32_t width, std::uint32_t height) override;
+
+  /// @brief binds buffer as input attribute data
+  void BindVertexBuffer(std::uint32_t binding, const IBufferGPU & buffer,
+                        std::uint32_t offset = 0) override;
+
+  /// @brief binds several buffers to consecutive bindings in one command
+  void BindVertexBuffers(std::uint32_t firstBinding,
+                         std::span<const VertexBufferBinding> buffers) override;
+
+  /// @brief binds buffer as index buffer
+  void BindIndexBuffer(const IBufferGPU & buffer, IndexType type,
+                       std::uint32_t offset = 0) override;
+
+  using ISubpassCommands::PushConstant;
+  void PushConstant(const void * data, size_t size) override;
+  void PushConstant(ShaderType shaderStage, uint32_t offset, const void * data,
+                    size_t size) override;
+
+  void BindUniformOffsets(uint32_t set, const uint32_t * offsets, uint32_t count) override;
+
+public: // Dynamic states
+  void SetDepthTestEnabled(bool enabled) override;
+  void SetDepthWriteEnabled(bool enabled) override;
+  void SetDepthCompareOp(CompareOperation op) override;
+  void SetCullingMode(CullingMode mode) override;
+  void SetFrontFace(FrontFace face) override;
+  void SetMeshTopology(MeshTopology topology) override;
+  void SetStencilTestEnabled(bool enabled) override;
+  void SetStencilOp(StencilFace face, StencilOperation failOp, StencilOperation passOp,
+                    StencilOperation depthFailOp, CompareOperation compareOp) override;
+
+public:
+  /// @brief resets buffer and begins writing. Pipeline and descriptors are bound at once
+  /// @param renderingInfo - used instead of renderPass with dynamic rendering
+  void BeginWriting(VkRenderPass renderPass, bool inheritViewportScissor,
+                    DescriptorBuffer & descriptors,
+                    const VkCommandBufferInheritanceRenderingInfo * renderingInfo = nullptr);
+  void EndWriting();
+
+  const details::CommandBuffer & GetCommandBuffer() const & noexcept { return m_buffer; }
+  /// @brief true if viewport or scissor was set while they were inherited
+  bool IsExplicitViewportRequested() const noexcept { return m_explicitViewportRequested; }
+
+private:
+  /// @brief checks if device supports extended dynamic state. Logs error if it doesn't
+  bool CheckDynamicStateSupported() const noexcept;
+  /// @brief checks if device supports indirect draws with count buffer. Logs error if it doesn't
+  bool CheckDrawIndirectCountSupported() const noexcept;
+  /// @brief checks if push constant matches declared ranges. Logs error if it doesn't
+  bool CheckPushConstant(VkShaderStageFlags stages, uint32_t offset,
+                         uint32_t size) const noexcept;
+  /// @brief records indirect draws. Without multiDrawIndirect feature draws are split
+  template<typename DrawFuncT>
+  void PushDrawIndirect(DrawFuncT && func, VkBuffer buffer, uint32_t offset, uint32_t drawCount,
+                        uint32_t stride);
+  /// @brief records dynamic state command if it differs from the state set before
+  template<typename VkCmdFunc, typename... Args>
+  void PushDynamicStateCommand(VkDynamicState state, uint64_t packedValue, VkCmdFunc && func,
+                               Args &&... args);
+
+private:
+  SubpassConfiguration * m_pipeline;
+  DescriptorBuffer * m_descriptors = nullptr; ///< descriptors of subpass used while writing
+  details::CommandBuffer m_buffer;
+  bool m_inheritedViewport = false;
+  bool m_explicitViewportRequested = false;
+};
+} // namespace RHI::vulkan
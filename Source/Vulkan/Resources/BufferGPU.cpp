@@ -25,6 +25,15 @@ constexpr VkBufferUsageFlags Cast2VkBufferUsage(RHI::BufferGPUUsage usage) noexc
     result |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
   return result;
 }
+
+/// @brief storage and indirect buffers are produced by compute passes, which aren't ordered with
+/// frames, so they are shared with compute queue without ownership transfers
+constexpr VkSharingMode SelectSharingMode(VkBufferUsageFlags usage) noexcept
+{
+  return (usage & (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))
+           ? VK_SHARING_MODE_CONCURRENT
+           : VK_SHARING_MODE_EXCLUSIVE;
+}
 } // namespace
 
 namespace RHI::vulkan
@@ -36,7 +45,8 @@ BufferGPU::BufferGPU(Context & ctx, size_t size, BufferGPUUsage usage, bool allo
 
 BufferGPU::BufferGPU(Context & ctx, size_t size, VkBufferUsageFlags usage, bool allowHostAccess)
   : OwnedBy<Context>(ctx)
-  , m_memBlock(ctx.GetBuffersAllocator().AllocBuffer(size, usage, allowHostAccess))
+  , m_memBlock(ctx.GetBuffersAllocator().AllocBuffer(size, usage, allowHostAccess,
+                                                     SelectSharingMode(usage)))
 {
 }
 
@@ -68,9 +78,8 @@ void BufferGPU::UploadSync(const void * data, size_t size, size_t offset)
 
 std::future<UploadResult> BufferGPU::UploadAsync(const void * data, size_t size, size_t offset)
 {
-  return GetContext().GetTransferer().UploadBuffer(GetHandle(),
-                                                   reinterpret_cast<const uint8_t *>(data), size,
-                                                   offset);
+  return GetContext().GetTransferer().UploadBuffer(*this, reinterpret_cast<const uint8_t *>(data),
+                                                   size, offset);
 }
 
 IBufferGPU::ScopedPointer BufferGPU::Map()
@@ -97,4 +106,9 @@ VkBuffer BufferGPU::GetHandle() const noexcept
 {
   return m_memBlock.GetBuffer();
 }
+
+bool BufferGPU::IsSharedWithCompute() const noexcept
+{
+  return m_memBlock.GetSharingMode() == VK_SHARING_MODE_CONCURRENT;
+}
 } // namespace RHI::vulkan
@@ -35,6 +35,8 @@ public:
 
 public:
   VkBuffer GetHandle() const noexcept;
+  /// @brief true if buffer is shared concurrently with compute queue family
+  bool IsSharedWithCompute() const noexcept;
 
 private:
   memory::MemoryBlock m_memBlock;
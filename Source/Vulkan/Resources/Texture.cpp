@@ -4,6 +4,36 @@
 #include <Utils/CastHelper.hpp>
 #include <VulkanContext.hpp>
 
+namespace
+{
+/// @brief sRGB formats usually can't be used as storage images, so storage view uses UNORM alias
+constexpr VkFormat GetStorageCompatibleFormat(VkFormat format) noexcept
+{
+  switch (format)
+  {
+    case VK_FORMAT_R8_SRGB:
+      return VK_FORMAT_R8_UNORM;
+    case VK_FORMAT_R8G8B8A8_SRGB:
+      return VK_FORMAT_R8G8B8A8_UNORM;
+    case VK_FORMAT_B8G8R8A8_SRGB:
+      return VK_FORMAT_B8G8R8A8_UNORM;
+    default:
+      return format;
+  }
+}
+
+/// @brief returns format for storage view or VK_FORMAT_UNDEFINED if storage isn't supported
+VkFormat SelectStorageFormat(VkPhysicalDevice gpu, VkFormat format) noexcept
+{
+  const VkFormat storageFormat = GetStorageCompatibleFormat(format);
+  VkFormatProperties properties{};
+  vkGetPhysicalDeviceFormatProperties(gpu, storageFormat, &properties);
+  return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT)
+           ? storageFormat
+           : VK_FORMAT_UNDEFINED;
+}
+} // namespace
+
 namespace RHI::vulkan
 {
 static constexpr uint32_t g_TextureUsageFlags =
@@ -12,20 +42,40 @@ static constexpr uint32_t g_TextureUsageFlags =
 Texture::Texture(Context & ctx, const TextureDescription & args)
   : OwnedBy<Context>(ctx)
   , m_description(args)
-  , m_memBlock(GetContext().GetBuffersAllocator().AllocImage(args, g_TextureUsageFlags,
-                                                             VK_SAMPLE_COUNT_1_BIT))
-  , m_layout(m_memBlock.GetImage())
-{
-  m_view =
-    utils::CreateImageView(GetContext().GetGpuConnection().GetDevice(), m_memBlock.GetImage(),
-                           GetInternalFormat(),
-                           utils::CastInterfaceEnum2Vulkan<VkImageViewType>(m_description.type),
-                           VK_IMAGE_ASPECT_COLOR_BIT);
+  , m_storageFormat(args.usage == TextureUsage::Storage
+                      ? SelectStorageFormat(ctx.GetGpuConnection().GetGPU(), GetInternalFormat())
+                      : VK_FORMAT_UNDEFINED)
+  , m_memBlock(GetContext().GetBuffersAllocator().AllocImage(
+      args,
+      m_storageFormat != VK_FORMAT_UNDEFINED ? g_TextureUsageFlags | VK_IMAGE_USAGE_STORAGE_BIT
+                                             : g_TextureUsageFlags,
+      VK_SAMPLE_COUNT_1_BIT,
+      // storage images are written by compute passes, which aren't ordered with frames
+      args.usage == TextureUsage::Storage ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+      m_storageFormat != VK_FORMAT_UNDEFINED && m_storageFormat != GetInternalFormat()
+        ? VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT
+        : 0))
+  , m_layout(m_memBlock.GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, args.mipLevels, args.layersCount)
+{
+  const auto viewType = utils::CastInterfaceEnum2Vulkan<VkImageViewType>(m_description.type);
+  const bool hasStorageAlias =
+    m_storageFormat != VK_FORMAT_UNDEFINED && m_storageFormat != GetInternalFormat();
+  m_view = utils::CreateImageView(GetContext().GetGpuConnection().GetDevice(),
+                                  m_memBlock.GetImage(), GetInternalFormat(), viewType,
+                                  VK_IMAGE_ASPECT_COLOR_BIT,
+                                  hasStorageAlias ? g_TextureUsageFlags : 0);
+  if (m_storageFormat != VK_FORMAT_UNDEFINED)
+    m_storageView = utils::CreateImageView(GetContext().GetGpuConnection().GetDevice(),
+                                           m_memBlock.GetImage(), m_storageFormat, viewType,
+                                           VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_USAGE_STORAGE_BIT);
+  m_bindlessIndex = GetContext().GetBindlessTable().Register(*this, GetBindlessLayout());
 }
 
 Texture::~Texture()
 {
+  GetContext().GetBindlessTable().Release(m_bindlessIndex);
   GetContext().GetGarbageCollector().PushVkObjectToDestroy(std::move(m_view), nullptr);
+  GetContext().GetGarbageCollector().PushVkObjectToDestroy(std::move(m_storageView), nullptr);
   GetContext().GetGarbageCollector().PushVkObjectToDestroy(std::move(m_memBlock), nullptr);
 }
 
@@ -60,14 +110,57 @@ void Texture::BlitTo(ITexture * texture)
     GetContext().GetTransferer().BlitImageToImage(*ptr, *this, RHI::TextureRegion{});
 }
 
+uint32_t Texture::GetBindlessIndex() const noexcept
+{
+  return m_bindlessIndex;
+}
+
 VkImageView Texture::GetImageView() const noexcept
 {
   return m_view;
 }
 
+VkImageView Texture::GetStorageImageView() const noexcept
+{
+  return m_storageView;
+}
+
+VkImageLayout Texture::GetBindlessLayout() const noexcept
+{
+  // storage images stay in GENERAL, so bindless access doesn't transit them back and forth
+  return m_storageView ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
+void Texture::OnLayoutChanged(VkImageLayout layout) const noexcept
+{
+  if (layout != GetBindlessLayout())
+    GetContext().GetBindlessTable().MarkDirty(m_bindlessIndex);
+}
+
 void Texture::TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout)
 {
   m_layout.TransferLayout(commandBuffer, layout);
+  OnLayoutChanged(layout);
+}
+
+void Texture::TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout,
+                             const VkImageSubresourceRange & range)
+{
+  m_layout.TransferLayout(commandBuffer, layout, range);
+  OnLayoutChanged(layout);
+}
+
+void Texture::TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                             VkPipelineStageFlags2 stages)
+{
+  m_layout.TransferLayout(batch, layout, stages);
+  OnLayoutChanged(layout);
+}
+
+void Texture::TransferLayout(VkImageLayout layout) noexcept
+{
+  m_layout.TransferLayout(layout);
+  OnLayoutChanged(layout);
 }
 
 VkImageLayout Texture::GetLayout() const noexcept
@@ -75,11 +168,26 @@ VkImageLayout Texture::GetLayout() const noexcept
   return m_layout.GetLayout();
 }
 
+VkImageLayout Texture::GetLayout(const VkImageSubresourceRange & range) const noexcept
+{
+  return m_layout.GetLayout(range);
+}
+
 VkImage Texture::GetHandle() const noexcept
 {
   return m_memBlock.GetImage();
 }
 
+VkImageAspectFlags Texture::GetAspect() const noexcept
+{
+  return m_layout.GetAspect();
+}
+
+bool Texture::IsSharedWithCompute() const noexcept
+{
+  return m_memBlock.GetSharingMode() == VK_SHARING_MODE_CONCURRENT;
+}
+
 VkFormat Texture::GetInternalFormat() const noexcept
 {
   return utils::CastInterfaceEnum2Vulkan<VkFormat>(m_description.format);
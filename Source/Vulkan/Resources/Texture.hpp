@@ -30,21 +30,44 @@ public: // ITexture interface
   virtual size_t Size() const override;
   //virtual void SetSwizzle() = 0;
   virtual void BlitTo(ITexture * texture) override;
+  virtual uint32_t GetBindlessIndex() const noexcept override;
 
 public: // IInternalTexture interface
   virtual VkImageView GetImageView() const noexcept override;
   virtual void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout) override;
+  virtual void TransferLayout(details::CommandBuffer & commandBuffer, VkImageLayout layout,
+                              const VkImageSubresourceRange & range) override;
+  virtual void TransferLayout(details::BarrierBatch & batch, VkImageLayout layout,
+                              VkPipelineStageFlags2 stages) override;
+  virtual void TransferLayout(VkImageLayout layout) noexcept override;
   virtual VkImageLayout GetLayout() const noexcept override;
+  virtual VkImageLayout GetLayout(const VkImageSubresourceRange & range) const noexcept override;
   virtual VkImage GetHandle() const noexcept override;
+  virtual VkImageAspectFlags GetAspect() const noexcept override;
+  virtual bool IsSharedWithCompute() const noexcept override;
   virtual VkFormat GetInternalFormat() const noexcept override;
   virtual VkExtent3D GetInternalExtent() const noexcept override;
   virtual uint32_t GetMipLevelsCount() const noexcept override;
   virtual uint32_t GetLayersCount() const noexcept override;
 
+public: // public internal API
+  /// @brief view for storage image descriptors. VK_NULL_HANDLE if storage isn't supported
+  VkImageView GetStorageImageView() const noexcept;
+
+private:
+  /// @brief layout of texture in bindless table
+  VkImageLayout GetBindlessLayout() const noexcept;
+  /// @brief bindless table transits texture back into its layout before next pass
+  void OnLayoutChanged(VkImageLayout layout) const noexcept;
+
 private:
   TextureDescription m_description;
+  /// UNDEFINED if storage usage isn't requested or isn't supported by format
+  VkFormat m_storageFormat = VK_FORMAT_UNDEFINED;
   memory::MemoryBlock m_memBlock;
   ImageLayoutTransferer m_layout;
   VkImageView m_view = VK_NULL_HANDLE;
+  VkImageView m_storageView = VK_NULL_HANDLE;
+  uint32_t m_bindlessIndex = InvalidBindlessIndex;
 };
 } // namespace RHI::vulkan
@@ -1,10 +1,32 @@
 #include "Transferer.hpp"
 
+#include <algorithm>
+
 #include <ImageUtils/ImageFormatsConversation.hpp>
 #include <ImageUtils/InternalImageTraits.hpp>
 #include <Utils/CastHelper.hpp>
 #include <VulkanContext.hpp>
 
+namespace
+{
+/// @brief true if any layer of the first mip level keeps data. Such image is owned by graphics
+/// queue family, so it can't be written by another family without ownership transfer
+bool HasContent(const RHI::vulkan::IInternalTexture & image, uint32_t baseLayer,
+                uint32_t layersCount)
+{
+  const uint32_t layersEnd = layersCount == VK_REMAINING_ARRAY_LAYERS
+                               ? image.GetLayersCount()
+                               : std::min(baseLayer + layersCount, image.GetLayersCount());
+  for (uint32_t layer = baseLayer; layer < layersEnd; ++layer)
+  {
+    const VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, layer, 1};
+    if (image.GetLayout(range) != VK_IMAGE_LAYOUT_UNDEFINED)
+      return true;
+  }
+  return false;
+}
+} // namespace
+
 namespace RHI::vulkan
 {
 
@@ -20,14 +42,18 @@ struct Transferer::PendingTasksContainer final : public OwnedBy<Context>
 
 public:
   /// pushes task to upload buffer from host to GPU (asynchronous)
-  std::future<UploadResult> UploadBuffer(details::CommandBuffer & commands, VkBuffer dstBuffer,
-                                         const uint8_t * srcData, size_t size, size_t offset = 0);
+  /// @param acquireCommands - commands of graphics queue to acquire ownership of uploaded resource
+  std::future<UploadResult> UploadBuffer(details::CommandBuffer & commands,
+                                         details::CommandBuffer * acquireCommands,
+                                         VkBuffer dstBuffer, const uint8_t * srcData, size_t size,
+                                         size_t offset = 0);
   /// pushes task to download buffer from GPU to host (asynchronous)
   std::future<DownloadResult> DownloadBuffer(details::CommandBuffer & commands, VkBuffer srcBuffer,
                                              size_t size, size_t offset = 0);
 
   /// pushes task to upload image from host to GPU (asynchronous)
   std::future<UploadResult> UploadImage(details::CommandBuffer & commands,
+                                        details::CommandBuffer * acquireCommands,
                                         IInternalTexture & dstImage, const UploadImageArgs & args);
   /// pushes task to download image from GPU to host (asynchronous)
   std::future<DownloadResult> DownloadImage(details::CommandBuffer & commands,
@@ -41,6 +67,16 @@ public:
   std::future<MipmapsGenerationResult> GenerateMipmaps(details::CommandBuffer & commands,
                                                        IInternalTexture & dst);
 
+private:
+  /// @brief records release of resource on transfer queue and its acquire on graphics queue.
+  /// Release is flushed with other barriers of transfer commands, acquire is recorded right away
+  void ReleaseToGraphics(details::CommandBuffer & releaseCommands,
+                         details::CommandBuffer & acquireCommands,
+                         VkBufferMemoryBarrier2 barrier) const;
+  void ReleaseToGraphics(details::CommandBuffer & releaseCommands,
+                         details::CommandBuffer & acquireCommands,
+                         VkImageMemoryBarrier2 barrier) const;
+
 private:
   /// function to copy texels from downloaded staging buffer to host memory
   using CreateDownloadResultFunc = std::function<DownloadResult(BufferGPU &)>;
@@ -108,9 +144,63 @@ void Transferer::PendingTasksContainer::ProcessSubmittedTasks()
   std::swap(m_executingBatch, m_writingBatch);
 }
 
+void Transferer::PendingTasksContainer::ReleaseToGraphics(details::CommandBuffer & releaseCommands,
+                                                          details::CommandBuffer & acquireCommands,
+                                                          VkBufferMemoryBarrier2 barrier) const
+{
+  auto && device = GetContext().GetGpuConnection();
+  barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+  barrier.srcQueueFamilyIndex = device.GetQueue(QueueType::Transfer).first;
+  barrier.dstQueueFamilyIndex = device.GetQueue(QueueType::Graphics).first;
+
+  // release makes written data available, access masks of other queue are ignored
+  VkBufferMemoryBarrier2 release = barrier;
+  release.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  release.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+  release.dstAccessMask = VK_ACCESS_2_NONE;
+  releaseCommands.GetBarriers().AddBufferBarrier(release);
+
+  // acquire follows semaphore wait at transfer stage of graphics queue
+  VkBufferMemoryBarrier2 acquire = barrier;
+  acquire.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  acquire.srcAccessMask = VK_ACCESS_2_NONE;
+  acquire.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+  acquire.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+  acquireCommands.GetBarriers().AddBufferBarrier(acquire);
+  acquireCommands.FlushBarriers();
+}
+
+void Transferer::PendingTasksContainer::ReleaseToGraphics(details::CommandBuffer & releaseCommands,
+                                                          details::CommandBuffer & acquireCommands,
+                                                          VkImageMemoryBarrier2 barrier) const
+{
+  auto && device = GetContext().GetGpuConnection();
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+  barrier.srcQueueFamilyIndex = device.GetQueue(QueueType::Transfer).first;
+  barrier.dstQueueFamilyIndex = device.GetQueue(QueueType::Graphics).first;
+
+  VkImageMemoryBarrier2 release = barrier;
+  release.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  release.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+  release.dstAccessMask = VK_ACCESS_2_NONE;
+  releaseCommands.GetBarriers().AddImageBarrier(release);
+
+  // layout isn't changed by ownership transfer, so next transition of tracked layout is valid
+  VkImageMemoryBarrier2 acquire = barrier;
+  acquire.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  acquire.srcAccessMask = VK_ACCESS_2_NONE;
+  acquire.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  acquire.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  acquireCommands.GetBarriers().AddImageBarrier(acquire);
+  // recorded right away to keep it before other transitions of the image on graphics queue
+  acquireCommands.FlushBarriers();
+}
+
 std::future<UploadResult> Transferer::PendingTasksContainer::UploadBuffer(
-  details::CommandBuffer & commands, VkBuffer dstBuffer, const uint8_t * srcData, size_t size,
-  size_t offset)
+  details::CommandBuffer & commands, details::CommandBuffer * acquireCommands, VkBuffer dstBuffer,
+  const uint8_t * srcData, size_t size, size_t offset)
 {
   std::promise<UploadResult> promise;
   BufferGPU stagingBuffer(GetContext(), size - offset, g_stagingUsage, true);
@@ -120,7 +210,16 @@ std::future<UploadResult> Transferer::PendingTasksContainer::UploadBuffer(
   copy.dstOffset = 0;
   copy.srcOffset = 0;
   copy.size = size - offset;
+  commands.FlushBarriers();
   commands.PushCommand(vkCmdCopyBuffer, stagingBuffer.GetHandle(), dstBuffer, 1, &copy);
+  if (acquireCommands)
+  {
+    VkBufferMemoryBarrier2 barrier{};
+    barrier.buffer = dstBuffer;
+    barrier.offset = copy.dstOffset;
+    barrier.size = copy.size;
+    ReleaseToGraphics(commands, *acquireCommands, barrier);
+  }
   auto && data =
     m_writingBatch.upload_tasks.emplace_back(std::move(stagingBuffer), std::move(promise));
   return data.second.get_future();
@@ -135,6 +234,7 @@ std::future<DownloadResult> Transferer::PendingTasksContainer::DownloadBuffer(
   copy.dstOffset = 0;
   copy.srcOffset = offset;
   copy.size = size;
+  commands.FlushBarriers();
   commands.PushCommand(vkCmdCopyBuffer, srcBuffer, stagingBuffer.GetHandle(), 1, &copy);
   auto createDownloadResult = [](BufferGPU & stagingBuffer) -> DownloadResult
   {
@@ -150,7 +250,8 @@ std::future<DownloadResult> Transferer::PendingTasksContainer::DownloadBuffer(
 }
 
 std::future<UploadResult> Transferer::PendingTasksContainer::UploadImage(
-  details::CommandBuffer & commands, IInternalTexture & dstImage, const UploadImageArgs & args)
+  details::CommandBuffer & commands, details::CommandBuffer * acquireCommands,
+  IInternalTexture & dstImage, const UploadImageArgs & args)
 {
   std::promise<UploadResult> promise;
   const size_t copyingRegionSize =
@@ -190,13 +291,29 @@ std::future<UploadResult> Transferer::PendingTasksContainer::UploadImage(
     region.imageSubresource.layerCount = args.layersCount;
   }
 
-  VkImageLayout oldLayout = dstImage.GetLayout();
-  dstImage.TransferLayout(commands, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  // only copied layers are transfered, other layers could be used at the same time
+  const VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, args.layerIndex,
+                                      args.layersCount};
+  VkImageLayout oldLayout = dstImage.GetLayout(range);
+  dstImage.TransferLayout(commands, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range);
   commands.PushCommand(vkCmdCopyBufferToImage, stagingBuffer.GetHandle(), dstImage.GetHandle(),
                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
   auto && data =
     m_writingBatch.upload_tasks.emplace_back(std::move(stagingBuffer), std::move(promise));
-  dstImage.TransferLayout(commands, oldLayout);
+  if (acquireCommands)
+  {
+    // image stays in transfer layout, it's changed on graphics queue when image is used
+    VkImageMemoryBarrier2 barrier{};
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.image = dstImage.GetHandle();
+    barrier.subresourceRange = range;
+    ReleaseToGraphics(commands, *acquireCommands, barrier);
+  }
+  else
+  {
+    dstImage.TransferLayout(commands, oldLayout, range);
+  }
   return data.second.get_future();
 }
 
@@ -243,14 +360,16 @@ std::future<DownloadResult> Transferer::PendingTasksContainer::DownloadImage(
     return result;
   };
 
-  VkImageLayout oldLayout = srcImage.GetLayout();
-  srcImage.TransferLayout(commands, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-  commands.PushCommand(vkCmdCopyImageToBuffer, srcImage.GetHandle(), srcImage.GetLayout(),
-                       stagingBuffer.GetHandle(), 1, &region);
+  const VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, args.layerIndex,
+                                      args.layersCount};
+  VkImageLayout oldLayout = srcImage.GetLayout(range);
+  srcImage.TransferLayout(commands, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, range);
+  commands.PushCommand(vkCmdCopyImageToBuffer, srcImage.GetHandle(),
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, stagingBuffer.GetHandle(), 1, &region);
   auto && data = m_writingBatch.download_tasks.emplace_back(std::move(stagingBuffer),
                                                             std::move(promise),
                                                             std::move(createDownloadResult));
-  srcImage.TransferLayout(commands, oldLayout);
+  srcImage.TransferLayout(commands, oldLayout, range);
   return std::get<1>(data).get_future();
 }
 
@@ -265,6 +384,7 @@ std::future<BlitResult> Transferer::PendingTasksContainer::BlitImageToImage(
     copy.extent = src.GetInternalExtent();
     //copy.dstOffset =
   }
+  commands.FlushBarriers();
   commands.PushCommand(vkCmdCopyImage, src.GetHandle(), src.GetLayout(), dst.GetHandle(),
                        dst.GetLayout(), 1, &copy);
   auto && data = m_writingBatch.blit_tasks.emplace_back(std::move(promise));
@@ -281,43 +401,6 @@ std::future<MipmapsGenerationResult> Transferer::PendingTasksContainer::Generate
                       std::max(1, extent.z / 2)};
   };
 
-
-  const uint32_t transferQueue =
-    GetContext().GetGpuConnection().GetQueue(RHI::vulkan::QueueType::Transfer).first;
-
-  // lambda to make a barrier for mip level
-  auto transferLayoutForMipLevel = [&commands, &dst, transferQueue](VkImageLayout oldLayout,
-                                                                    VkImageLayout newLayout,
-                                                                    uint32_t level)
-  {
-    assert(oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ||
-           oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    assert(newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ||
-           newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    VkImageMemoryBarrier barrier{};
-    {
-      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-      barrier.oldLayout = oldLayout;
-      barrier.newLayout = newLayout;
-      barrier.srcQueueFamilyIndex = transferQueue;
-      barrier.dstQueueFamilyIndex = transferQueue;
-      barrier.image = dst.GetHandle();
-      barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-      barrier.subresourceRange.baseMipLevel = level;
-      barrier.subresourceRange.levelCount = 1;
-      barrier.subresourceRange.baseArrayLayer = 0;
-      barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
-      barrier.srcAccessMask = newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-                              ? VK_ACCESS_TRANSFER_WRITE_BIT
-                              : VK_ACCESS_TRANSFER_READ_BIT;
-      barrier.dstAccessMask = newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-                              ? VK_ACCESS_TRANSFER_READ_BIT
-                              : VK_ACCESS_TRANSFER_WRITE_BIT;
-    }
-    commands.PushCommand(vkCmdPipelineBarrier, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-  };
-
   // if texture has no mip levels, then do nothing
   if (dst.GetMipLevelsCount() <= 1)
   {
@@ -342,21 +425,22 @@ std::future<MipmapsGenerationResult> Transferer::PendingTasksContainer::Generate
     2) transfer layout to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL for all layers/mipLevels
     3) for i = 1 to M:
          3.1) transfer layout to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL for i - 1 mip level. 
-                This step blocks mip level for reading
+                This step waits for writing of the level is completed
          3.2) blit image (all N layers) from i - 1 to i mip level with linear filteration. 
                 Note: i'th level has only half of i-1'th level's extent
-         3.3) transfer layout to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL for i - 1 mip level
-                this step waits for reading is completed and blocks for writing
-         3.4) div extent in 2
-    4) restore old layout. After the loop, the texture is in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout
+         3.3) div extent in 2
+    4) restore old layout. After the loop, all levels except the last one are in
+       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL layout, layouts of mip levels are tracked separately,
+       so they are restored with one barrier
   */
 
   VkImageLayout oldLayout = dst.GetLayout();
   dst.TransferLayout(commands, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
   for (uint32_t level = 1; level < dst.GetMipLevelsCount(); ++level)
   {
-    transferLayoutForMipLevel(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                              VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, level - 1);
+    const VkImageSubresourceRange srcLevel{VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 1, 0,
+                                           VK_REMAINING_ARRAY_LAYERS};
+    dst.TransferLayout(commands, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcLevel);
 
     VkImageBlit blit{};
     {
@@ -378,9 +462,6 @@ std::future<MipmapsGenerationResult> Transferer::PendingTasksContainer::Generate
                          dst.GetHandle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
                          VK_FILTER_LINEAR);
 
-    transferLayoutForMipLevel(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, level - 1);
-
     oldMipExtent = mipExtent;
     mipExtent = extentDiv2(mipExtent);
   }
@@ -395,6 +476,8 @@ std::future<MipmapsGenerationResult> Transferer::PendingTasksContainer::Generate
 
 Transferer::Transferer(Context & ctx)
   : OwnedBy<Context>(ctx)
+  , m_ownershipTransfer(ctx.GetGpuConnection().GetQueue(QueueType::Transfer).first !=
+                        ctx.GetGpuConnection().GetQueue(QueueType::Graphics).first)
   , m_transferSubmitter(ctx, QueueType::Transfer)
   , m_graphicsSubmitter(ctx, QueueType::Graphics)
   , m_computeSubmitter(ctx, QueueType::Compute)
@@ -406,6 +489,7 @@ Transferer::Transferer(Context & ctx)
 Transferer::Transferer(Transferer && rhs)
   : Transferer(rhs.GetOwner())
 {
+  std::swap(m_ownershipTransfer, rhs.m_ownershipTransfer);
   std::swap(m_transferSubmitter, rhs.m_transferSubmitter);
   std::swap(m_graphicsSubmitter, rhs.m_graphicsSubmitter);
   std::swap(m_computeSubmitter, rhs.m_computeSubmitter);
@@ -418,27 +502,39 @@ Transferer::~Transferer() = default;
 IAwaitable * Transferer::DoTransfer()
 {
   std::lock_guard lk{m_submittingMutex};
-  std::vector<IAwaitable *> tasks{m_transferSubmitter.SubmitAndSwap(),
-                                  m_graphicsSubmitter.SubmitAndSwap(),
+  // graphics queue acquires resources released by transfer queue, so it waits for transfer.
+  // Binary semaphore is waited once, so transfer submits aren't chained with each other then
+  AsyncTask * transferTask = m_transferSubmitter.SubmitAndSwap({}, !m_ownershipTransfer);
+  std::vector<VkSemaphore> waitSemaphores;
+  if (transferTask && m_ownershipTransfer)
+    waitSemaphores.push_back(transferTask->GetSemaphore());
+  std::vector<IAwaitable *> tasks{transferTask,
+                                  m_graphicsSubmitter.SubmitAndSwap(std::move(waitSemaphores)),
                                   m_computeSubmitter.SubmitAndSwap()};
   m_awaitable.SetTasks(std::move(tasks));
   m_pendingTasks->ProcessSubmittedTasks();
   return &m_awaitable;
 }
 
-std::future<UploadResult> Transferer::UploadBuffer(VkBuffer dstBuffer, const uint8_t * srcData,
-                                                   size_t size, size_t offset)
+std::future<UploadResult> Transferer::UploadBuffer(const BufferGPU & dstBuffer,
+                                                   const uint8_t * srcData, size_t size,
+                                                   size_t offset)
 {
   std::lock_guard lk{m_submittingMutex};
-  return m_pendingTasks->UploadBuffer(m_transferSubmitter.GetWritingBuffer(), dstBuffer, srcData,
-                                      size, offset);
+  // concurrent buffer isn't shared with transfer family, and there is no ownership to transfer
+  if (m_ownershipTransfer && dstBuffer.IsSharedWithCompute())
+    return m_pendingTasks->UploadBuffer(m_graphicsSubmitter.GetWritingBuffer(), nullptr,
+                                        dstBuffer.GetHandle(), srcData, size, offset);
+  return m_pendingTasks->UploadBuffer(m_transferSubmitter.GetWritingBuffer(), GetAcquiringBuffer(),
+                                      dstBuffer.GetHandle(), srcData, size, offset);
 }
 
 std::future<DownloadResult> Transferer::DownloadBuffer(VkBuffer srcBuffer, size_t size,
                                                        size_t offset)
 {
   std::lock_guard lk{m_submittingMutex};
-  return m_pendingTasks->DownloadBuffer(m_transferSubmitter.GetWritingBuffer(), srcBuffer, size,
+  // buffer is owned by graphics queue family, so it's read there
+  return m_pendingTasks->DownloadBuffer(m_graphicsSubmitter.GetWritingBuffer(), srcBuffer, size,
                                         offset);
 }
 
@@ -446,7 +542,14 @@ std::future<UploadResult> Transferer::UploadImage(IInternalTexture & dstImage,
                                                   const UploadImageArgs & args)
 {
   std::lock_guard lk{m_submittingMutex};
-  return m_pendingTasks->UploadImage(m_transferSubmitter.GetWritingBuffer(), dstImage, args);
+  // image with content is owned by graphics queue family. Giving it to transfer queue and back
+  // costs more than copying on graphics queue. Concurrent image isn't shared with transfer family
+  if (m_ownershipTransfer && (dstImage.IsSharedWithCompute() ||
+                              HasContent(dstImage, args.layerIndex, args.layersCount)))
+    return m_pendingTasks->UploadImage(m_graphicsSubmitter.GetWritingBuffer(), nullptr, dstImage,
+                                       args);
+  return m_pendingTasks->UploadImage(m_transferSubmitter.GetWritingBuffer(), GetAcquiringBuffer(),
+                                     dstImage, args);
 }
 
 std::future<DownloadResult> Transferer::DownloadImage(IInternalTexture & srcImage,
@@ -476,12 +579,21 @@ Transferer::Bufferchain::Bufferchain(Context & ctx, QueueType type)
   m_writingBuffer.BeginWriting();
 }
 
-IAwaitable * Transferer::Bufferchain::SubmitAndSwap()
+details::CommandBuffer * Transferer::GetAcquiringBuffer() & noexcept
+{
+  return m_ownershipTransfer ? &m_graphicsSubmitter.GetWritingBuffer() : nullptr;
+}
+
+AsyncTask * Transferer::Bufferchain::SubmitAndSwap(std::vector<VkSemaphore> && waitSemaphores,
+                                                   bool waitPrevSubmitOnGPU)
 {
-  if (m_writingBuffer.IsEmpty())
+  // ownership transfers are collected during the frame
+  m_writingBuffer.FlushBarriers();
+  // semaphores must be waited even if there is nothing to execute
+  if (m_writingBuffer.IsEmpty() && waitSemaphores.empty())
     return nullptr;
   m_writingBuffer.EndWriting();
-  IAwaitable * result = m_writingBuffer.Submit(true, {});
+  AsyncTask * result = m_writingBuffer.Submit(waitPrevSubmitOnGPU, std::move(waitSemaphores));
   std::swap(m_writingBuffer, m_executingBuffer);
   m_writingBuffer.WaitForSubmitCompleted();
   m_writingBuffer.Reset();
@@ -26,8 +26,10 @@ struct Transferer final : public OwnedBy<Context>
 
   IAwaitable * DoTransfer();
 
-  std::future<UploadResult> UploadBuffer(VkBuffer dstBuffer, const uint8_t * srcData, size_t size,
-                                         size_t offset = 0);
+  /// @brief buffers shared with compute queue are uploaded on graphics queue, other ones are
+  /// uploaded on transfer queue and acquired by graphics queue
+  std::future<UploadResult> UploadBuffer(const BufferGPU & dstBuffer, const uint8_t * srcData,
+                                         size_t size, size_t offset = 0);
   std::future<DownloadResult> DownloadBuffer(VkBuffer srcBuffer, size_t size, size_t offset = 0);
 
   std::future<UploadResult> UploadImage(IInternalTexture & dstImage, const UploadImageArgs & args);
@@ -43,14 +45,22 @@ private:
     explicit Bufferchain(Context & ctx, QueueType type);
 
     details::CommandBuffer & GetWritingBuffer() & noexcept { return m_writingBuffer; }
-    IAwaitable * SubmitAndSwap();
+    /// @param waitPrevSubmitOnGPU - false if semaphore of submit is waited by another queue
+    AsyncTask * SubmitAndSwap(std::vector<VkSemaphore> && waitSemaphores = {},
+                              bool waitPrevSubmitOnGPU = true);
 
   private:
     details::Submitter m_writingBuffer;
     details::Submitter m_executingBuffer;
   };
 
+  /// @brief buffer to acquire resources released by transfer queue.
+  /// nullptr if transfer and graphics queues are from the same family
+  details::CommandBuffer * GetAcquiringBuffer() & noexcept;
+
+private:
   std::mutex m_submittingMutex;
+  bool m_ownershipTransfer = false; ///< transfer queue has its own family
   Bufferchain m_transferSubmitter;
   Bufferchain m_graphicsSubmitter;
   Bufferchain m_computeSubmitter;
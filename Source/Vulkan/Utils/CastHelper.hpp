@@ -138,4 +138,164 @@ constexpr inline VkVertexInputRate CastInterfaceEnum2Vulkan<
   }
 }
 
+template<>
+constexpr inline VkPrimitiveTopology CastInterfaceEnum2Vulkan<VkPrimitiveTopology, MeshTopology>(
+  MeshTopology value)
+{
+  switch (value)
+  {
+    case MeshTopology::Point:
+      return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+    case MeshTopology::Line:
+      return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+    case MeshTopology::LineStrip:
+      return VK_PRIMITIVE_TOPOLOGY_LINE_STRIP;
+    case MeshTopology::Triangle:
+      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    case MeshTopology::TriangleFan:
+      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN;
+    case MeshTopology::TriangleStrip:
+      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+    default:
+      return VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkCullModeFlags CastInterfaceEnum2Vulkan<VkCullModeFlags, CullingMode>(
+  CullingMode value)
+{
+  switch (value)
+  {
+    case CullingMode::None:
+      return VK_CULL_MODE_NONE;
+    case CullingMode::FrontFace:
+      return VK_CULL_MODE_FRONT_BIT;
+    case CullingMode::BackFace:
+      return VK_CULL_MODE_BACK_BIT;
+    case CullingMode::FrontAndBack:
+      return VK_CULL_MODE_FRONT_AND_BACK;
+    default:
+      return VK_CULL_MODE_FLAG_BITS_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkFrontFace CastInterfaceEnum2Vulkan<VkFrontFace, FrontFace>(FrontFace value)
+{
+  switch (value)
+  {
+    case FrontFace::CW:
+      return VK_FRONT_FACE_CLOCKWISE;
+    case FrontFace::CCW:
+      return VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    default:
+      return VK_FRONT_FACE_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkCompareOp CastInterfaceEnum2Vulkan<VkCompareOp, CompareOperation>(
+  CompareOperation value)
+{
+  switch (value)
+  {
+    case CompareOperation::Never:
+      return VK_COMPARE_OP_NEVER;
+    case CompareOperation::Always:
+      return VK_COMPARE_OP_ALWAYS;
+    case CompareOperation::Equal:
+      return VK_COMPARE_OP_EQUAL;
+    case CompareOperation::NotEqual:
+      return VK_COMPARE_OP_NOT_EQUAL;
+    case CompareOperation::Less:
+      return VK_COMPARE_OP_LESS;
+    case CompareOperation::LessOrEqual:
+      return VK_COMPARE_OP_LESS_OR_EQUAL;
+    case CompareOperation::Greater:
+      return VK_COMPARE_OP_GREATER;
+    case CompareOperation::GreaterOrEqual:
+      return VK_COMPARE_OP_GREATER_OR_EQUAL;
+    default:
+      return VK_COMPARE_OP_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkStencilOp CastInterfaceEnum2Vulkan<VkStencilOp, StencilOperation>(
+  StencilOperation value)
+{
+  switch (value)
+  {
+    case StencilOperation::Keep:
+      return VK_STENCIL_OP_KEEP;
+    case StencilOperation::Zero:
+      return VK_STENCIL_OP_ZERO;
+    case StencilOperation::Replace:
+      return VK_STENCIL_OP_REPLACE;
+    case StencilOperation::IncrementAndClamp:
+      return VK_STENCIL_OP_INCREMENT_AND_CLAMP;
+    case StencilOperation::DecrementAndClamp:
+      return VK_STENCIL_OP_DECREMENT_AND_CLAMP;
+    case StencilOperation::Invert:
+      return VK_STENCIL_OP_INVERT;
+    case StencilOperation::IncrementAndWrap:
+      return VK_STENCIL_OP_INCREMENT_AND_WRAP;
+    case StencilOperation::DecrementAndWrap:
+      return VK_STENCIL_OP_DECREMENT_AND_WRAP;
+    default:
+      return VK_STENCIL_OP_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkStencilFaceFlags CastInterfaceEnum2Vulkan<VkStencilFaceFlags, StencilFace>(
+  StencilFace value)
+{
+  switch (value)
+  {
+    case StencilFace::Front:
+      return VK_STENCIL_FACE_FRONT_BIT;
+    case StencilFace::Back:
+      return VK_STENCIL_FACE_BACK_BIT;
+    case StencilFace::FrontAndBack:
+      return VK_STENCIL_FACE_FRONT_AND_BACK;
+    default:
+      return VK_STENCIL_FACE_FLAG_BITS_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkAttachmentLoadOp CastInterfaceEnum2Vulkan<VkAttachmentLoadOp, AttachmentLoadOp>(
+  AttachmentLoadOp value)
+{
+  switch (value)
+  {
+    case AttachmentLoadOp::Clear:
+      return VK_ATTACHMENT_LOAD_OP_CLEAR;
+    case AttachmentLoadOp::Load:
+      return VK_ATTACHMENT_LOAD_OP_LOAD;
+    case AttachmentLoadOp::DontCare:
+      return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    default:
+      return VK_ATTACHMENT_LOAD_OP_MAX_ENUM;
+  }
+}
+
+template<>
+constexpr inline VkAttachmentStoreOp CastInterfaceEnum2Vulkan<VkAttachmentStoreOp,
+                                                              AttachmentStoreOp>(
+  AttachmentStoreOp value)
+{
+  switch (value)
+  {
+    case AttachmentStoreOp::Store:
+      return VK_ATTACHMENT_STORE_OP_STORE;
+    case AttachmentStoreOp::DontCare:
+      return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    default:
+      return VK_ATTACHMENT_STORE_OP_MAX_ENUM;
+  }
+}
+
 } // namespace RHI::vulkan::utils
@@ -0,0 +1,51 @@
+#include "ComputePipelineBuilder.hpp"
+
+#include <Utils/PipelineBuilder.hpp>
+
+namespace RHI::vulkan::utils
+{
+ComputePipelineBuilder::ComputePipelineBuilder()
+{
+  Reset();
+}
+
+VkPipeline ComputePipelineBuilder::Make(const VkDevice & device,
+                                        const VkPipelineLayout & layout) const
+{
+  if (m_shader.empty())
+    throw std::runtime_error("Failed to create compute pipeline - shader is not attached");
+
+  VkShaderModule module = BuildShaderModule(device, m_shader);
+
+  VkComputePipelineCreateInfo pipeline_info{};
+  {
+    pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.layout = layout;
+    pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = module;
+    pipeline_info.stage.pName = "main";
+    pipeline_info.basePipelineHandle = VK_NULL_HANDLE; // Optional
+    pipeline_info.basePipelineIndex = -1;              // Optional
+  }
+
+  VkPipeline pipeline{};
+  auto res =
+    vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline);
+  vkDestroyShaderModule(device, module, nullptr);
+  if (res != VK_SUCCESS)
+    throw std::runtime_error("Failed to create compute pipeline");
+  return pipeline;
+}
+
+void ComputePipelineBuilder::Reset()
+{
+  m_shader.clear();
+}
+
+void ComputePipelineBuilder::AttachShader(const SpirV & spirv)
+{
+  m_shader = spirv;
+}
+
+} // namespace RHI::vulkan::utils
@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+
+#include <RHI.hpp>
+#include <vulkan/vulkan.hpp>
+
+
+namespace RHI::vulkan::utils
+{
+
+/// @brief Utility-class to build compute pipeline
+struct ComputePipelineBuilder final
+{
+  ComputePipelineBuilder();
+  RESTRICTED_COPY(ComputePipelineBuilder);
+
+public:
+  VkPipeline Make(const VkDevice & device, const VkPipelineLayout & layout) const;
+  void Reset();
+
+public:
+  void AttachShader(const SpirV & spirv);
+  bool HasShader() const noexcept { return !m_shader.empty(); }
+
+private:
+  SpirV m_shader;
+};
+
+} // namespace RHI::vulkan::utils
@@ -1,16 +1,29 @@
 #include "DescriptorSetLayoutBuilder.hpp"
 
+#include <algorithm>
+
 #include <Utils/CastHelper.hpp>
 
 namespace RHI::vulkan::utils
 {
 VkDescriptorSetLayout DescriptorSetLayoutBuilder::Make(const VkDevice & device) const
 {
+  std::vector<VkDescriptorSetLayoutBinding> bindings = m_uniformDescriptions;
+  for (size_t i = 0; i < bindings.size(); ++i)
+  {
+    if (!m_immutableSamplers[i].empty())
+    {
+      assert(std::none_of(m_immutableSamplers[i].begin(), m_immutableSamplers[i].end(),
+                          [](VkSampler sampler) { return sampler == VK_NULL_HANDLE; }));
+      bindings[i].pImmutableSamplers = m_immutableSamplers[i].data();
+    }
+  }
+
   // create descriptor set layout
   VkDescriptorSetLayoutCreateInfo dsetLayoutInfo{};
   dsetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-  dsetLayoutInfo.bindingCount = static_cast<uint32_t>(m_uniformDescriptions.size());
-  dsetLayoutInfo.pBindings = m_uniformDescriptions.data();
+  dsetLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+  dsetLayoutInfo.pBindings = bindings.data();
 
   VkDescriptorSetLayout descr_layout;
   if (auto res = vkCreateDescriptorSetLayout(device, &dsetLayoutInfo, nullptr, &descr_layout);
@@ -22,6 +35,7 @@ VkDescriptorSetLayout DescriptorSetLayoutBuilder::Make(const VkDevice & device)
 void DescriptorSetLayoutBuilder::Reset()
 {
   m_uniformDescriptions.clear();
+  m_immutableSamplers.clear();
 }
 
 void DescriptorSetLayoutBuilder::DeclareDescriptor(uint32_t binding, VkDescriptorType type,
@@ -41,6 +55,53 @@ void DescriptorSetLayoutBuilder::DeclareDescriptorsArray(uint32_t binding, VkDes
   uniformBinding.descriptorCount = size;
   uniformBinding.stageFlags = CastInterfaceEnum2Vulkan<VkShaderStageFlagBits>(shaderStage);
   uniformBinding.pImmutableSamplers = nullptr; // Optional
+  m_immutableSamplers.emplace_back();
+}
+
+bool DescriptorSetLayoutBuilder::SetImmutableSampler(uint32_t binding, uint32_t arrayIndex,
+                                                     VkSampler sampler)
+{
+  assert(binding < m_uniformDescriptions.size());
+  assert(m_uniformDescriptions[binding].descriptorType ==
+         VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+  auto && samplers = m_immutableSamplers[binding];
+  samplers.resize(m_uniformDescriptions[binding].descriptorCount, VK_NULL_HANDLE);
+  if (samplers[arrayIndex] == sampler)
+    return false;
+  samplers[arrayIndex] = sampler;
+  return true;
+}
+
+bool DescriptorSetLayoutBuilder::operator==(const DescriptorSetLayoutBuilder & rhs) const noexcept
+{
+  return std::equal(m_uniformDescriptions.begin(), m_uniformDescriptions.end(),
+                    rhs.m_uniformDescriptions.begin(), rhs.m_uniformDescriptions.end(),
+                    [](const auto & l, const auto & r)
+                    {
+                      return l.binding == r.binding && l.descriptorType == r.descriptorType &&
+                             l.descriptorCount == r.descriptorCount &&
+                             l.stageFlags == r.stageFlags &&
+                             l.pImmutableSamplers == r.pImmutableSamplers;
+                    }) &&
+         m_immutableSamplers == rhs.m_immutableSamplers;
 }
 
 } // namespace RHI::vulkan::utils
+
+std::size_t std::hash<RHI::vulkan::utils::DescriptorSetLayoutBuilder>::operator()(
+  const RHI::vulkan::utils::DescriptorSetLayoutBuilder & x) const noexcept
+{
+  std::size_t result = 0;
+  auto combine = [&result](std::size_t value)
+  { result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2); };
+  for (auto && binding : x.GetBindings())
+  {
+    combine(binding.binding);
+    combine(binding.descriptorType);
+    combine(binding.descriptorCount);
+    combine(binding.stageFlags);
+    for (VkSampler sampler : x.GetImmutableSamplers(binding.binding))
+      combine(std::hash<VkSampler>{}(sampler));
+  }
+  return result;
+}
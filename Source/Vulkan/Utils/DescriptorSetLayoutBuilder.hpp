@@ -13,8 +13,35 @@ struct DescriptorSetLayoutBuilder final
   void DeclareDescriptor(uint32_t binding, VkDescriptorType type, ShaderType shaderStage);
   void DeclareDescriptorsArray(uint32_t binding, VkDescriptorType type, ShaderType shaderStage,
                                uint32_t size);
+  /// @brief bakes sampler into layout for element of combined image sampler binding
+  /// @return true if layout has been changed
+  bool SetImmutableSampler(uint32_t binding, uint32_t arrayIndex, VkSampler sampler);
+
+  const std::vector<VkDescriptorSetLayoutBinding> & GetBindings() const & noexcept
+  {
+    return m_uniformDescriptions;
+  }
+  /// @brief builders are equal if they make identically defined (compatible) layouts
+  bool operator==(const DescriptorSetLayoutBuilder & rhs) const noexcept;
+
+  /// @brief immutable samplers of binding. Empty if binding has no immutable samplers
+  const std::vector<VkSampler> & GetImmutableSamplers(uint32_t binding) const & noexcept
+  {
+    return m_immutableSamplers[binding];
+  }
 
 private:
+  /// pImmutableSamplers is always nullptr here, it's set in Make() to keep builder copyable
   std::vector<VkDescriptorSetLayoutBinding> m_uniformDescriptions;
+  std::vector<std::vector<VkSampler>> m_immutableSamplers; ///< for each binding
 };
 } // namespace RHI::vulkan::utils
+
+namespace std
+{
+template<>
+struct hash<RHI::vulkan::utils::DescriptorSetLayoutBuilder>
+{
+  std::size_t operator()(const RHI::vulkan::utils::DescriptorSetLayoutBuilder & x) const noexcept;
+};
+} // namespace std
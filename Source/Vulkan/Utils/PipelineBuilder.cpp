@@ -1,5 +1,7 @@
 #include "PipelineBuilder.hpp"
 
+#include <cassert>
+
 #include <Utils/CastHelper.hpp>
 
 namespace
@@ -57,33 +59,17 @@ constexpr VkPipelineColorBlendAttachmentState DefaultColorBlendConfig() noexcept
   return state;
 }
 
+/// states which are set in command buffer if extended dynamic state is enabled
+constexpr VkDynamicState ExtendedDynamicStates[] = {
+  VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE,   VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE,
+  VK_DYNAMIC_STATE_DEPTH_COMPARE_OP,    VK_DYNAMIC_STATE_CULL_MODE,
+  VK_DYNAMIC_STATE_FRONT_FACE,          VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY,
+  VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE, VK_DYNAMIC_STATE_STENCIL_OP};
+
 } // namespace
 
 namespace RHI::vulkan::utils
 {
-template<>
-constexpr inline VkPrimitiveTopology CastInterfaceEnum2Vulkan<VkPrimitiveTopology, MeshTopology>(
-  MeshTopology value)
-{
-  switch (value)
-  {
-    case MeshTopology::Point:
-      return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
-    case MeshTopology::Line:
-      return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
-    case MeshTopology::LineStrip:
-      return VK_PRIMITIVE_TOPOLOGY_LINE_STRIP;
-    case MeshTopology::Triangle:
-      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    case MeshTopology::TriangleFan:
-      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN;
-    case MeshTopology::TriangleStrip:
-      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
-    default:
-      return VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
-  }
-}
-
 template<>
 constexpr inline VkPolygonMode CastInterfaceEnum2Vulkan<VkPolygonMode, PolygonMode>(
   PolygonMode value)
@@ -101,66 +87,6 @@ constexpr inline VkPolygonMode CastInterfaceEnum2Vulkan<VkPolygonMode, PolygonMo
   }
 }
 
-template<>
-constexpr inline VkCullModeFlags CastInterfaceEnum2Vulkan<VkCullModeFlags, CullingMode>(
-  CullingMode value)
-{
-  switch (value)
-  {
-    case CullingMode::None:
-      return VK_CULL_MODE_NONE;
-    case CullingMode::FrontFace:
-      return VK_CULL_MODE_FRONT_BIT;
-    case CullingMode::BackFace:
-      return VK_CULL_MODE_FRONT_BIT;
-    case CullingMode::FrontAndBack:
-      return VK_CULL_MODE_FRONT_AND_BACK;
-    default:
-      return VK_CULL_MODE_FLAG_BITS_MAX_ENUM;
-  }
-}
-
-template<>
-constexpr inline VkFrontFace CastInterfaceEnum2Vulkan<VkFrontFace, FrontFace>(FrontFace value)
-{
-  switch (value)
-  {
-    case FrontFace::CW:
-      return VK_FRONT_FACE_CLOCKWISE;
-    case FrontFace::CCW:
-      return VK_FRONT_FACE_COUNTER_CLOCKWISE;
-    default:
-      return VK_FRONT_FACE_MAX_ENUM;
-  }
-}
-
-template<>
-constexpr inline VkCompareOp CastInterfaceEnum2Vulkan<VkCompareOp, CompareOperation>(
-  CompareOperation value)
-{
-  switch (value)
-  {
-    case CompareOperation::Never:
-      return VK_COMPARE_OP_NEVER;
-    case CompareOperation::Always:
-      return VK_COMPARE_OP_ALWAYS;
-    case CompareOperation::Equal:
-      return VK_COMPARE_OP_EQUAL;
-    case CompareOperation::NotEqual:
-      return VK_COMPARE_OP_NOT_EQUAL;
-    case CompareOperation::Less:
-      return VK_COMPARE_OP_LESS;
-    case CompareOperation::LessOrEqual:
-      return VK_COMPARE_OP_LESS_OR_EQUAL;
-    case CompareOperation::Greater:
-      return VK_COMPARE_OP_GREATER;
-    case CompareOperation::GreaterOrEqual:
-      return VK_COMPARE_OP_GREATER_OR_EQUAL;
-    default:
-      return VK_COMPARE_OP_MAX_ENUM;
-  }
-}
-
 /// @brief creates shader module in context by filename
 /// @param ctx - vulkan context
 /// @param filename - path to file
@@ -191,10 +117,15 @@ PipelineBuilder::PipelineBuilder()
 
 
 VkPipeline PipelineBuilder::Make(const VkDevice & device, const VkRenderPass & renderPass,
-                                 uint32_t subpass_index, const VkPipelineLayout & layout)
+                                 uint32_t subpass_index, const VkPipelineLayout & layout,
+                                 const VkPipelineRenderingCreateInfo * renderingInfo)
 {
   // update pointers on arrays
   {
+    m_dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    if (m_extendedDynamicState)
+      m_dynamicStates.insert(m_dynamicStates.end(), std::begin(ExtendedDynamicStates),
+                             std::end(ExtendedDynamicStates));
     m_dynamicStatesInfo.dynamicStateCount = static_cast<uint32_t>(m_dynamicStates.size());
     m_dynamicStatesInfo.pDynamicStates = m_dynamicStates.data();
   }
@@ -229,6 +160,7 @@ VkPipeline PipelineBuilder::Make(const VkDevice & device, const VkRenderPass & r
   VkGraphicsPipelineCreateInfo pipeline_info{};
   {
     pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipeline_info.pNext = renderingInfo;
     pipeline_info.layout = layout;
     pipeline_info.renderPass = renderPass;
     pipeline_info.subpass = subpass_index;
@@ -422,6 +354,29 @@ void PipelineBuilder::SetStencilTestEnabled(bool enabled)
   m_depthStencilInfo.stencilTestEnable = enabled;
 }
 
+void PipelineBuilder::SetExtendedDynamicStateEnabled(bool enabled) noexcept
+{
+  m_extendedDynamicState = enabled;
+}
+
+void PipelineBuilder::RecordDynamicStates(const VkCommandBuffer & buffer) const
+{
+  assert(m_extendedDynamicState);
+  vkCmdSetDepthTestEnable(buffer, m_depthStencilInfo.depthTestEnable);
+  vkCmdSetDepthWriteEnable(buffer, m_depthStencilInfo.depthWriteEnable);
+  vkCmdSetDepthCompareOp(buffer, m_depthStencilInfo.depthCompareOp);
+  vkCmdSetCullMode(buffer, m_rasterizationInfo.cullMode);
+  vkCmdSetFrontFace(buffer, m_rasterizationInfo.frontFace);
+  vkCmdSetPrimitiveTopology(buffer, m_inputAssemblyInfo.topology);
+  vkCmdSetStencilTestEnable(buffer, m_depthStencilInfo.stencilTestEnable);
+  auto && front = m_depthStencilInfo.front;
+  vkCmdSetStencilOp(buffer, VK_STENCIL_FACE_FRONT_BIT, front.failOp, front.passOp,
+                    front.depthFailOp, front.compareOp);
+  auto && back = m_depthStencilInfo.back;
+  vkCmdSetStencilOp(buffer, VK_STENCIL_FACE_BACK_BIT, back.failOp, back.passOp, back.depthFailOp,
+                    back.compareOp);
+}
+
 void PipelineBuilder::AddInputBinding(uint32_t slot, uint32_t stride, InputBindingType type)
 {
   auto && bindingDescription = m_bindings.emplace_back();
@@ -8,6 +8,8 @@
 
 namespace RHI::vulkan::utils
 {
+/// @brief creates shader module from SpirV code
+VkShaderModule BuildShaderModule(const VkDevice & device, const RHI::SpirV & spirv);
 
 /// @brief Utility-class to automatize pipeline building. It provides default values to many settings nad methods to configure your pipeline
 struct PipelineBuilder final
@@ -16,8 +18,10 @@ struct PipelineBuilder final
   RESTRICTED_COPY(PipelineBuilder);
 
 public:
+  /// @param renderingInfo - attachment formats if pipeline is used without VkRenderPass
   VkPipeline Make(const VkDevice & device, const VkRenderPass & renderPass, uint32_t subpass_index,
-                  const VkPipelineLayout & layout);
+                  const VkPipelineLayout & layout,
+                  const VkPipelineRenderingCreateInfo * renderingInfo = nullptr);
   void Reset();
 
 public:
@@ -43,6 +47,13 @@ public:
 
   void SetStencilTestEnabled(bool enabled);
 
+  // dynamic states
+  /// @brief makes depth/stencil, culling and topology states dynamic (requires Vulkan 1.3)
+  void SetExtendedDynamicStateEnabled(bool enabled) noexcept;
+  bool IsExtendedDynamicStateEnabled() const noexcept { return m_extendedDynamicState; }
+  /// @brief records values of extended dynamic states configured in builder into command buffer
+  void RecordDynamicStates(const VkCommandBuffer & buffer) const;
+
   // blending
   void OnColorAttachmentHasBound();
   void SetBlendEnabled(uint32_t attachmentIdx, bool value);
@@ -54,6 +65,7 @@ public:
 
 private:
   RHI::SamplesCount m_cachedSamplesCount = RHI::SamplesCount::One;
+  bool m_extendedDynamicState = false;
   VkPipelineDynamicStateCreateInfo m_dynamicStatesInfo{};
   VkPipelineVertexInputStateCreateInfo m_vertexInputInfo{};
   VkPipelineInputAssemblyStateCreateInfo m_inputAssemblyInfo{};
@@ -1,19 +1,18 @@
 #include "PipelineLayoutBuilder.hpp"
 
+#include <algorithm>
+
 namespace RHI::vulkan::utils
 {
-VkPipelineLayout PipelineLayoutBuilder::Make(const VkDevice & device,
-                                             const VkDescriptorSetLayout * layouts,
-                                             uint32_t layoutSize,
-                                             const VkPushConstantRange * pushConstantRange) const
+VkPipelineLayout PipelineLayoutBuilder::Make(const VkDevice & device) const
 {
   // create pipeline layout
   VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
   pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  pipelineLayoutInfo.setLayoutCount = layoutSize;                                   // Optional
-  pipelineLayoutInfo.pSetLayouts = layouts;                                         // Optional
-  pipelineLayoutInfo.pushConstantRangeCount = pushConstantRange == nullptr ? 0 : 1; // Optional
-  pipelineLayoutInfo.pPushConstantRanges = pushConstantRange;                       // Optional
+  pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(m_layouts.size());
+  pipelineLayoutInfo.pSetLayouts = m_layouts.data();
+  pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(m_pushConstantRanges.size());
+  pipelineLayoutInfo.pPushConstantRanges = m_pushConstantRanges.data();
 
   VkPipelineLayout layout;
   if (auto res = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout);
@@ -21,4 +20,101 @@ VkPipelineLayout PipelineLayoutBuilder::Make(const VkDevice & device,
     throw std::runtime_error("Failed to create pipeline layout - ");
   return layout;
 }
+
+void PipelineLayoutBuilder::Reset()
+{
+  m_layouts.clear();
+  m_pushConstantRanges.clear();
+}
+
+void PipelineLayoutBuilder::SetDescriptorSetLayouts(
+  const std::vector<VkDescriptorSetLayout> & layouts)
+{
+  m_layouts = layouts;
+}
+
+void PipelineLayoutBuilder::AddPushConstantRange(const VkPushConstantRange & range)
+{
+  m_pushConstantRanges.push_back(range);
+}
+
+bool PipelineLayoutBuilder::operator==(const PipelineLayoutBuilder & rhs) const noexcept
+{
+  return m_layouts == rhs.m_layouts &&
+         std::equal(m_pushConstantRanges.begin(), m_pushConstantRanges.end(),
+                    rhs.m_pushConstantRanges.begin(), rhs.m_pushConstantRanges.end(),
+                    [](const auto & l, const auto & r)
+                    {
+                      return l.stageFlags == r.stageFlags && l.offset == r.offset &&
+                             l.size == r.size;
+                    });
+}
+
+void DefinePushConstantRange(std::vector<VkPushConstantRange> & ranges,
+                             const VkPushConstantRange & newRange, uint32_t maxPushConstantsSize)
+{
+  if (newRange.size == 0 || newRange.offset % 4 != 0 || newRange.size % 4 != 0)
+    throw std::invalid_argument("Push constant offset and size must be multiples of 4");
+  if (newRange.offset + newRange.size > maxPushConstantsSize)
+    throw std::invalid_argument("Push constant range exceeds maxPushConstantsSize (" +
+                                std::to_string(maxPushConstantsSize) + " bytes)");
+
+  auto it = std::find_if(ranges.begin(), ranges.end(), [&newRange](const VkPushConstantRange & r)
+                         { return r.stageFlags == newRange.stageFlags; });
+  if (it != ranges.end())
+  {
+    *it = newRange;
+    return;
+  }
+  // each stage can be declared only in one range
+  if (std::any_of(ranges.begin(), ranges.end(), [&newRange](const VkPushConstantRange & r)
+                  { return (r.stageFlags & newRange.stageFlags) != 0; }))
+    throw std::invalid_argument("Shader stage already has push constant range");
+  ranges.push_back(newRange);
+}
+
+VkShaderStageFlags GetPushConstantStages(const std::vector<VkPushConstantRange> & ranges,
+                                         uint32_t offset, uint32_t size) noexcept
+{
+  VkShaderStageFlags result = 0;
+  for (auto && range : ranges)
+  {
+    if (offset < range.offset + range.size && range.offset < offset + size)
+      result |= range.stageFlags;
+  }
+  return result;
+}
+
+const char * ValidatePushConstant(const std::vector<VkPushConstantRange> & ranges,
+                                  VkShaderStageFlags stages, uint32_t offset,
+                                  uint32_t size) noexcept
+{
+  if (stages == 0 || stages != GetPushConstantStages(ranges, offset, size))
+    return "stages must match all ranges which contain pushed bytes";
+  for (auto && range : ranges)
+  {
+    if ((range.stageFlags & stages) != 0 &&
+        (offset < range.offset || offset + size > range.offset + range.size))
+      return "bytes are out of declared range";
+  }
+  return nullptr;
+}
+
 } // namespace RHI::vulkan::utils
+
+std::size_t std::hash<RHI::vulkan::utils::PipelineLayoutBuilder>::operator()(
+  const RHI::vulkan::utils::PipelineLayoutBuilder & x) const noexcept
+{
+  std::size_t result = 0;
+  auto combine = [&result](std::size_t value)
+  { result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2); };
+  for (VkDescriptorSetLayout layout : x.GetDescriptorSetLayouts())
+    combine(std::hash<VkDescriptorSetLayout>{}(layout));
+  for (auto && range : x.GetPushConstantRanges())
+  {
+    combine(range.stageFlags);
+    combine(range.offset);
+    combine(range.size);
+  }
+  return result;
+}
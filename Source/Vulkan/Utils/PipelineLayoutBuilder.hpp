@@ -8,11 +8,46 @@ namespace RHI::vulkan::utils
 {
 struct PipelineLayoutBuilder final
 {
-  VkPipelineLayout Make(const VkDevice & device, const VkDescriptorSetLayout * layouts,
-                        uint32_t layoutSize, const VkPushConstantRange * pushConstantRange) const;
-  void Reset() { m_layouts.clear(); }
+  VkPipelineLayout Make(const VkDevice & device) const;
+  void Reset();
+  void SetDescriptorSetLayouts(const std::vector<VkDescriptorSetLayout> & layouts);
+  void AddPushConstantRange(const VkPushConstantRange & range);
+
+  const std::vector<VkDescriptorSetLayout> & GetDescriptorSetLayouts() const & noexcept
+  {
+    return m_layouts;
+  }
+  const std::vector<VkPushConstantRange> & GetPushConstantRanges() const & noexcept
+  {
+    return m_pushConstantRanges;
+  }
+  /// @brief builders are equal if they make identically defined (compatible) layouts
+  bool operator==(const PipelineLayoutBuilder & rhs) const noexcept;
 
 private:
   std::vector<VkDescriptorSetLayout> m_layouts;
+  std::vector<VkPushConstantRange> m_pushConstantRanges;
 };
+
+/// @brief adds push constant range or replaces range of the same stages.
+/// Throws if range is out of limits or its stages are used by other range
+void DefinePushConstantRange(std::vector<VkPushConstantRange> & ranges,
+                             const VkPushConstantRange & newRange, uint32_t maxPushConstantsSize);
+/// @brief stages of ranges which overlap pushed bytes (they must be passed to vkCmdPushConstants)
+VkShaderStageFlags GetPushConstantStages(const std::vector<VkPushConstantRange> & ranges,
+                                         uint32_t offset, uint32_t size) noexcept;
+/// @brief checks that pushed bytes and stages match declared ranges
+/// @return description of mismatch or nullptr if push constant is valid
+const char * ValidatePushConstant(const std::vector<VkPushConstantRange> & ranges,
+                                  VkShaderStageFlags stages, uint32_t offset,
+                                  uint32_t size) noexcept;
 } // namespace RHI::vulkan::utils
+
+namespace std
+{
+template<>
+struct hash<RHI::vulkan::utils::PipelineLayoutBuilder>
+{
+  std::size_t operator()(const RHI::vulkan::utils::PipelineLayoutBuilder & x) const noexcept;
+};
+} // namespace std
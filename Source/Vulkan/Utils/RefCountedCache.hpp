@@ -0,0 +1,91 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+
+namespace RHI::vulkan::utils
+{
+
+/// @brief ref-counted objects keyed by their description. Objects with identical descriptions
+/// are shared. Cache isn't thread-safe, so owner must lock it
+template<typename DescriptionT, typename HandleT>
+struct RefCountedCache final
+{
+  /// @brief returns handle of described object and adds reference to it.
+  /// Object is created with makeFunc(description) if it isn't cached yet
+  template<typename MakeFuncT>
+  HandleT Acquire(const DescriptionT & description, MakeFuncT && makeFunc)
+  {
+    auto && [it, inserted] = m_objects.insert({description, CachedObject{}});
+    if (inserted)
+    {
+      try
+      {
+        it->second.handle = makeFunc(description);
+      }
+      catch (...)
+      {
+        m_objects.erase(it);
+        throw;
+      }
+      m_descriptions.insert({it->second.handle, description});
+    }
+    ++it->second.refsCount;
+    return it->second.handle;
+  }
+
+  /// @brief adds reference to cached object. Handles which aren't owned by cache are skipped
+  void AddRef(HandleT handle) noexcept
+  {
+    if (auto it = m_descriptions.find(handle); it != m_descriptions.end())
+      ++m_objects.at(it->second).refsCount;
+  }
+
+  /// @brief removes reference to object. When the last reference is removed, object is erased
+  /// and destroyFunc(handle, description) is called. Handles which aren't owned by cache are skipped
+  template<typename DestroyFuncT>
+  void Release(HandleT handle, DestroyFuncT && destroyFunc) noexcept
+  {
+    if (!handle)
+      return;
+    auto descriptionIt = m_descriptions.find(handle);
+    if (descriptionIt == m_descriptions.end())
+      return;
+    auto it = m_objects.find(descriptionIt->second);
+    assert(it != m_objects.end() && it->second.refsCount > 0);
+    if (--it->second.refsCount == 0)
+    {
+      destroyFunc(handle, descriptionIt->second);
+      m_objects.erase(it);
+      m_descriptions.erase(descriptionIt);
+    }
+  }
+
+  /// @brief calls func(handle) for each cached object
+  template<typename FuncT>
+  void ForEach(FuncT && func) const
+  {
+    for (auto && [description, object] : m_objects)
+      func(object.handle);
+  }
+
+  uint32_t GetRefsCount(HandleT handle) const noexcept
+  {
+    auto it = m_descriptions.find(handle);
+    return it != m_descriptions.end() ? m_objects.at(it->second).refsCount : 0;
+  }
+
+  size_t Size() const noexcept { return m_objects.size(); }
+
+private:
+  struct CachedObject
+  {
+    HandleT handle{};
+    uint32_t refsCount = 0;
+  };
+
+  std::unordered_map<DescriptionT, CachedObject> m_objects;
+  std::unordered_map<HandleT, DescriptionT> m_descriptions;
+};
+
+} // namespace RHI::vulkan::utils
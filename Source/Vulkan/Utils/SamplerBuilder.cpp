@@ -90,4 +90,43 @@ void SamplerBuilder::SetTextureWrapping(RHI::TextureWrapping uWrapping,
   m_createInfo.addressModeW = CastInterfaceEnum2Vulkan<VkSamplerAddressMode>(wWrapping);
 }
 
+bool SamplerBuilder::operator==(const SamplerBuilder & rhs) const noexcept
+{
+  auto && l = m_createInfo;
+  auto && r = rhs.m_createInfo;
+  return l.flags == r.flags && l.magFilter == r.magFilter && l.minFilter == r.minFilter &&
+         l.mipmapMode == r.mipmapMode && l.addressModeU == r.addressModeU &&
+         l.addressModeV == r.addressModeV && l.addressModeW == r.addressModeW &&
+         l.mipLodBias == r.mipLodBias && l.anisotropyEnable == r.anisotropyEnable &&
+         l.maxAnisotropy == r.maxAnisotropy && l.compareEnable == r.compareEnable &&
+         l.compareOp == r.compareOp && l.minLod == r.minLod && l.maxLod == r.maxLod &&
+         l.borderColor == r.borderColor && l.unnormalizedCoordinates == r.unnormalizedCoordinates;
+}
+
 } // namespace RHI::vulkan::utils
+
+std::size_t std::hash<RHI::vulkan::utils::SamplerBuilder>::operator()(
+  const RHI::vulkan::utils::SamplerBuilder & x) const noexcept
+{
+  std::size_t result = 0;
+  auto combine = [&result](std::size_t value)
+  { result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2); };
+  auto && info = x.GetCreateInfo();
+  combine(info.flags);
+  combine(info.magFilter);
+  combine(info.minFilter);
+  combine(info.mipmapMode);
+  combine(info.addressModeU);
+  combine(info.addressModeV);
+  combine(info.addressModeW);
+  combine(std::hash<float>{}(info.mipLodBias));
+  combine(info.anisotropyEnable);
+  combine(std::hash<float>{}(info.maxAnisotropy));
+  combine(info.compareEnable);
+  combine(info.compareOp);
+  combine(std::hash<float>{}(info.minLod));
+  combine(std::hash<float>{}(info.maxLod));
+  combine(info.borderColor);
+  combine(info.unnormalizedCoordinates);
+  return result;
+}
@@ -14,7 +14,20 @@ struct SamplerBuilder final
   void SetFilter(RHI::TextureFilteration minFilter, RHI::TextureFilteration magFilter) noexcept;
   void SetTextureWrapping(RHI::TextureWrapping uWrapping, RHI::TextureWrapping vWrapping, RHI::TextureWrapping wWrapping);
 
+  const VkSamplerCreateInfo & GetCreateInfo() const & noexcept { return m_createInfo; }
+  /// @brief builders are equal if they make samplers with identical state
+  bool operator==(const SamplerBuilder & rhs) const noexcept;
+
 private:
-  VkSamplerCreateInfo m_createInfo;
+  VkSamplerCreateInfo m_createInfo{};
 };
 } // namespace RHI::vulkan::utils
+
+namespace std
+{
+template<>
+struct hash<RHI::vulkan::utils::SamplerBuilder>
+{
+  std::size_t operator()(const RHI::vulkan::utils::SamplerBuilder & x) const noexcept;
+};
+} // namespace std
@@ -1,10 +1,13 @@
 #include "VulkanContext.hpp"
 
+#include <algorithm>
 #include <format>
 
 #include <Attachments/GenericAttachment.hpp>
 #include <Attachments/SurfacedAttachment.hpp>
 #include <CommandsExecution/CommandBuffer.hpp>
+#include <ComputePass/ComputePass.hpp>
+#include <RenderGraph/RenderGraph.hpp>
 #include <RenderPass/Framebuffer.hpp>
 #include <RenderPass/RenderPass.hpp>
 #include <RenderPass/RenderTarget.hpp>
@@ -26,6 +29,13 @@ Context::Context(const GpuTraits & gpuTraits, LoggingFunc logFunc)
   , m_device(*this, gpuTraits)
   , m_allocator(*this)
   , m_gc(*this)
+  , m_frameFences(*this)
+  , m_samplerCache(*this)
+  , m_layoutCache(*this)
+  , m_descriptorAllocator(*this)
+  , m_bindlessTable(*this)
+  , m_transientAllocator(*this)
+  , m_sharedTransitions(*this)
 {
   // alloc null texture
   RHI::TextureDescription args{};
@@ -56,6 +66,81 @@ void Context::DeleteFramebuffer(IFramebuffer * fbo)
   m_framebuffers.Destroy(fbo);
 }
 
+IAwaitable * Context::EndFrames(std::span<IFramebuffer * const> framebuffers)
+{
+  std::vector<Framebuffer *> started;
+  started.reserve(framebuffers.size());
+  for (IFramebuffer * fbo : framebuffers)
+  {
+    auto && framebuffer = utils::CastInterfaceClass2Internal<Framebuffer &>(*fbo);
+    if (framebuffer.IsFrameStarted())
+      started.push_back(&framebuffer);
+  }
+
+  // framebuffers are spread across graphics queues, each queue gets one submit call
+  const uint32_t queuesCount =
+    std::min(m_device.GetGraphicsQueuesCount(), static_cast<uint32_t>(started.size()));
+  // frames on different queues aren't ordered, so transitions of images used by them are
+  // submitted on the first queue before the frames. Attachments are transited by their frames
+  details::CommandBuffer * sharedTransitions =
+    queuesCount > 1 ? &m_sharedTransitions.BeginWriting() : nullptr;
+
+  details::SubmitBatch framesBatch;
+  std::vector<std::pair<Framebuffer *, AsyncTask *>> submitted;
+  submitted.reserve(started.size());
+  for (Framebuffer * framebuffer : started)
+  {
+    const uint32_t queueIndex = static_cast<uint32_t>(submitted.size()) % queuesCount;
+    // only the first frame on queue waits for semaphore, the next ones are ordered after it
+    const VkSemaphore transitionsSemaphore = sharedTransitions && submitted.size() < queuesCount
+                                               ? m_sharedTransitions.GetSemaphore(queueIndex)
+                                               : VK_NULL_HANDLE;
+    if (AsyncTask * task = framebuffer->SubmitFrame(framesBatch, queueIndex, sharedTransitions,
+                                                    transitionsSemaphore))
+      submitted.emplace_back(framebuffer, task);
+  }
+
+  details::SubmitBatch batch;
+  if (sharedTransitions)
+    m_sharedTransitions.Submit(batch, queuesCount);
+  batch.Append(std::move(framesBatch));
+  batch.Flush(*this);
+
+  std::vector<IAwaitable *> tasks;
+  tasks.reserve(submitted.size());
+  for (auto && [framebuffer, task] : submitted)
+  {
+    framebuffer->PresentFrame(*task);
+    tasks.push_back(task);
+  }
+  if (!tasks.empty())
+    OnFramesEnded(static_cast<uint32_t>(tasks.size()));
+  // tasks of previous frames are dropped
+  m_framesTask = CompositeAsyncTask();
+  m_framesTask.SetTasks(std::move(tasks));
+  return &m_framesTask;
+}
+
+IComputePass * Context::CreateComputePass()
+{
+  return m_computePasses.Emplace<ComputePass>(*this);
+}
+
+void Context::DeleteComputePass(IComputePass * pass)
+{
+  m_computePasses.Destroy(pass);
+}
+
+IRenderGraph * Context::CreateRenderGraph()
+{
+  return m_renderGraphs.Emplace<RenderGraph>(*this);
+}
+
+void Context::DeleteRenderGraph(IRenderGraph * graph)
+{
+  m_renderGraphs.Destroy(graph);
+}
+
 IBufferGPU * Context::CreateBuffer(size_t size, BufferGPUUsage usage, bool allowHostAccess)
 {
   return m_buffers.Emplace<BufferGPU>(*this, size, usage, allowHostAccess);
@@ -77,7 +162,8 @@ void Context::DeleteTexture(ITexture * texture)
 }
 
 IAttachment * Context::CreateAttachment(RHI::ImageFormat format, const RHI::TextureExtent & extent,
-                                        RenderBuffering buffering, RHI::SamplesCount samplesCount)
+                                        RenderBuffering buffering, RHI::SamplesCount samplesCount,
+                                        bool transient /* = false*/)
 {
   RHI::TextureDescription args{};
   {
@@ -86,7 +172,8 @@ IAttachment * Context::CreateAttachment(RHI::ImageFormat format, const RHI::Text
     args.mipLevels = 1;
     args.type = RHI::ImageType::Image2D;
   }
-  return m_attachments.Emplace<GenericAttachment>(*this, args, buffering, samplesCount);
+  return m_attachments.Emplace<GenericAttachment>(*this, args, buffering, samplesCount,
+                                                  transient);
 }
 
 void Context::DeleteAttachment(IAttachment * attachment)
@@ -97,6 +184,8 @@ void Context::DeleteAttachment(IAttachment * attachment)
 void Context::ClearResources()
 {
   WaitForIdle();
+  m_descriptorAllocator.ReclaimReleasedSets();
+  m_bindlessTable.ReclaimReleasedIndices();
   m_gc.ClearObjects();
 }
 
@@ -106,6 +195,39 @@ void Context::TransferPass()
     transferer.DoTransfer();
 }
 
+size_t Context::GetDynamicOffsetAlignment() const noexcept
+{
+  auto && limits = m_device.GetGpuProperties().limits;
+  return std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment);
+}
+
+TransientAllocation Context::AllocateTransient(size_t size, size_t alignment)
+{
+  return m_transientAllocator.Allocate(size, alignment);
+}
+
+void Context::OnFrameBegun() noexcept
+{
+  ++m_begunFramesCount;
+}
+
+void Context::OnFramesEnded(uint32_t framesCount)
+{
+  assert(m_begunFramesCount >= framesCount);
+  // resources of frame can be used by any framebuffer which isn't submitted yet
+  if (m_begunFramesCount.fetch_sub(framesCount) != framesCount)
+    return;
+  const auto frame = m_frameFences.SignalFrameEnd();
+  m_transientAllocator.EndFrame(frame);
+  m_descriptorAllocator.EndFrame(frame);
+  m_bindlessTable.EndFrame(frame);
+}
+
+bool Context::IsBindlessTexturesSupported() const noexcept
+{
+  return m_bindlessTable.IsEnabled();
+}
+
 void Context::Log(LogMessageStatus status, const std::string & message) const noexcept
 {
 #ifdef NDEBUG
@@ -119,6 +241,7 @@ void Context::Log(LogMessageStatus status, const std::string & message) const no
 
 void Context::WaitForIdle() const noexcept
 {
+  auto lk = GetGpuConnection().LockQueues();
   vkDeviceWaitIdle(GetGpuConnection().GetDevice());
 }
 
@@ -150,6 +273,31 @@ const details::VkObjectsGarbageCollector & Context::GetGarbageCollector() const
   return m_gc;
 }
 
+const details::FrameFences & Context::GetFrameFences() const & noexcept
+{
+  return m_frameFences;
+}
+
+const DescriptorAllocator & Context::GetDescriptorAllocator() const & noexcept
+{
+  return m_descriptorAllocator;
+}
+
+const BindlessTable & Context::GetBindlessTable() const & noexcept
+{
+  return m_bindlessTable;
+}
+
+const SamplerCache & Context::GetSamplerCache() const & noexcept
+{
+  return m_samplerCache;
+}
+
+const LayoutCache & Context::GetLayoutCache() const & noexcept
+{
+  return m_layoutCache;
+}
+
 RHI::ITexture * Context::GetNullTexture() const noexcept
 {
   return m_nullTexture;
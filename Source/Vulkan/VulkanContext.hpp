@@ -1,8 +1,16 @@
 #pragma once
+#include <CommandsExecution/CompositeAsyncTask.hpp>
+#include <CommandsExecution/FrameFences.hpp>
+#include <CommandsExecution/SharedTransitions.hpp>
+#include <Descriptors/BindlessTable.hpp>
+#include <Descriptors/DescriptorAllocator.hpp>
+#include <Descriptors/LayoutCache.hpp>
+#include <Descriptors/SamplerCache.hpp>
 #include <Device.hpp>
 #include <GarbageCollector.hpp>
 #include <ImageUtils/TextureInterface.hpp>
 #include <Memory/MemoryAllocator.hpp>
+#include <Memory/TransientAllocator.hpp>
 #include <Private/ObjectsTable.hpp>
 #include <RenderPass/Framebuffer.hpp>
 #include <Resources/BufferGPU.hpp>
@@ -25,6 +33,11 @@ public: // IContext interface
                                                  RenderBuffering buffering) override;
   virtual IFramebuffer * CreateFramebuffer() override;
   virtual void DeleteFramebuffer(IFramebuffer * fbo) override;
+  virtual IAwaitable * EndFrames(std::span<IFramebuffer * const> framebuffers) override;
+  virtual IComputePass * CreateComputePass() override;
+  virtual void DeleteComputePass(IComputePass * pass) override;
+  virtual IRenderGraph * CreateRenderGraph() override;
+  virtual void DeleteRenderGraph(IRenderGraph * graph) override;
   virtual IBufferGPU * CreateBuffer(size_t size, BufferGPUUsage usage,
                                     bool allowHostAccess) override;
   virtual void DeleteBuffer(IBufferGPU * buffer) override;
@@ -32,20 +45,34 @@ public: // IContext interface
   virtual void DeleteTexture(ITexture * texture) override;
   virtual IAttachment * CreateAttachment(RHI::ImageFormat format, const RHI::TextureExtent & extent,
                                          RenderBuffering buffering,
-                                         RHI::SamplesCount samplesCount) override;
+                                         RHI::SamplesCount samplesCount,
+                                         bool transient = false) override;
   virtual void DeleteAttachment(IAttachment * attachment) override;
   virtual void ClearResources() override; ///< GarbageCollector call
   virtual void TransferPass() override;
+  virtual size_t GetDynamicOffsetAlignment() const noexcept override;
+  virtual TransientAllocation AllocateTransient(size_t size, size_t alignment = 0) override;
+  virtual bool IsBindlessTexturesSupported() const noexcept override;
 
 public: // RHI-only API
   void Log(LogMessageStatus status, const std::string & message) const noexcept;
   void WaitForIdle() const noexcept;
   bool IsValid() const noexcept { return m_validatationMark == kValidationMark; }
+  /// @brief frame of framebuffer is begun, per-frame resources aren't recycled until it's ended
+  void OnFrameBegun() noexcept;
+  /// @brief recycles per-frame resources if all begun frames are ended.
+  /// It's called after frames are submitted
+  void OnFramesEnded(uint32_t framesCount);
 
   const Device & GetGpuConnection() const & noexcept;
   Transferer & GetTransferer() & noexcept;
   memory::MemoryAllocator & GetBuffersAllocator() & noexcept;
   const details::VkObjectsGarbageCollector & GetGarbageCollector() const & noexcept;
+  const details::FrameFences & GetFrameFences() const & noexcept;
+  const DescriptorAllocator & GetDescriptorAllocator() const & noexcept;
+  const BindlessTable & GetBindlessTable() const & noexcept;
+  const SamplerCache & GetSamplerCache() const & noexcept;
+  const LayoutCache & GetLayoutCache() const & noexcept;
 
   RHI::ITexture * GetNullTexture() const noexcept;
 
@@ -56,14 +83,25 @@ private:
   Device m_device;
   memory::MemoryAllocator m_allocator;
   details::VkObjectsGarbageCollector m_gc;
+  details::FrameFences m_frameFences; ///< must outlive per-frame allocators
+  SamplerCache m_samplerCache; ///< must outlive all descriptors
+  LayoutCache m_layoutCache;   ///< must outlive all passes
+  DescriptorAllocator m_descriptorAllocator;
+  BindlessTable m_bindlessTable; ///< must outlive textures
   std::unordered_map<std::thread::id, Transferer> m_transferers;
 
   // TODO: replace deque with pool
   RHI::utils::ObjectsTable<IFramebuffer> m_framebuffers;
+  RHI::utils::ObjectsTable<IComputePass> m_computePasses;
+  RHI::utils::ObjectsTable<IRenderGraph> m_renderGraphs; ///< refer to compute passes
   RHI::utils::ObjectsTable<IBufferGPU> m_buffers;
   RHI::utils::ObjectsTable<IAttachment> m_attachments;
   RHI::utils::ObjectsTable<ITexture> m_textures;
   ITexture * m_nullTexture;
+  memory::TransientAllocator m_transientAllocator;
+  details::SharedTransitions m_sharedTransitions; ///< used by EndFrames with several queues
+  CompositeAsyncTask m_framesTask;                ///< submits of last EndFrames
+  std::atomic<uint32_t> m_begunFramesCount = 0;   ///< framebuffers between BeginFrame and EndFrame
 };
 
 } // namespace RHI::vulkan